@@ -30,6 +30,8 @@
 #include "algorithm_simd.h"
 #include "xz_csprng.h"
 #include <stdalign.h>
+#include <stdio.h>
+#include <time.h>
 #include <stdatomic.h>
 
 #ifdef __cplusplus
@@ -44,6 +46,7 @@ extern "C" {
  */
 static inline void xzalgochain_force_scalar(int force);
 static inline int xzalgochain_is_forced_scalar(void);
+static inline int xzalgochain_autotune(void);
 
 #if defined(__ARM_NEON) && (defined(__arm__) || defined(__aarch64__))
 static inline void little_box_execute_neon4(uint64_t* input, uint64_t salt_simd, uint64_t round_base, size_t num_blocks);
@@ -62,7 +65,8 @@ typedef struct {
     alignas(32) uint8_t buffer[128];                                   /* Input buffer for partial blocks (128 bytes) */
     size_t buffer_len;                                                 /* Number of bytes currently in buffer */
     uint64_t total_bits;                                               /* Total bits processed (for padding) */
-    uint8_t simd_type;                                                 /* Detected SIMD type for this context */
+    uint8_t simd_type;                                                 /* Resolved SIMD type for this context */
+    uint8_t backend;                                                   /* Requested backend policy (XZ_BACKEND_*) */
 } XzalgoChain_CTX;
 
 /* ==================== BLOCK TRANSFORMATION ==================== */
@@ -114,14 +118,75 @@ static inline void little_box_execute_simd_adapter(uint64_t input[10],
     little_box_execute_simd(input, salt_simd, round_base, 1);
 }
 
+#if defined(XZALGOCHAIN_HAVE_AVX2)
+/**
+ * Adapter function to call AVX2 execution with single block
+ * Calls the backend directly; the backend was already chosen at init time
+ */
+static inline void little_box_execute_avx2_adapter(uint64_t input[10],
+                                                   uint64_t salt_simd,
+                                                   uint64_t round_base) {
+    little_box_execute_simd_avx2(input, salt_simd, round_base, 1);
+}
+#endif
+
+#if defined(XZALGOCHAIN_HAVE_SSE2)
+/**
+ * Adapter function to call SSE2 execution with single block
+ * Calls the backend directly; the backend was already chosen at init time
+ */
+static inline void little_box_execute_sse2_adapter(uint64_t input[10],
+                                                   uint64_t salt_simd,
+                                                   uint64_t round_base) {
+    little_box_execute_simd_sse2(input, salt_simd, round_base, 1);
+}
+#endif
+
+#if defined(XZALGOCHAIN_HAVE_NEON)
+/**
+ * Adapter function to call NEON execution with single block
+ * Calls the backend directly; the backend was already chosen at init time
+ */
+static inline void little_box_execute_neon_adapter(uint64_t input[10],
+                                                   uint64_t salt_simd,
+                                                   uint64_t round_base) {
+    little_box_execute_simd_neon(input, salt_simd, round_base, 1);
+}
+#endif
+
+#if defined(XZALGOCHAIN_HAVE_WASM_SIMD)
+/**
+ * Adapter function to call WASM SIMD128 execution with single block
+ * Calls the backend directly; the backend was already chosen at init time
+ */
+static inline void little_box_execute_wasm_adapter(uint64_t input[10],
+                                                   uint64_t salt_simd,
+                                                   uint64_t round_base) {
+    little_box_execute_simd_wasm(input, salt_simd, round_base, 1);
+}
+#endif
+
+#if defined(XZALGOCHAIN_HAVE_VECEXT)
+/**
+ * Adapter function to call vector-extension execution with single block
+ * Calls the backend directly; the backend was already chosen at init time
+ */
+static inline void little_box_execute_vecext_adapter(uint64_t input[10],
+                                                     uint64_t salt_simd,
+                                                     uint64_t round_base) {
+    little_box_execute_simd_vecext(input, salt_simd, round_base, 1);
+}
+#endif
+
 /**
  * Adapter function to call scalar execution with single block
- * Wraps little_box_execute_scalar for consistent interface
+ * Uses the single-block specialization, bit-identical to
+ * little_box_execute_scalar(input, salt, round_base, 1)
  */
 static inline void little_box_execute_scalar_adapter(uint64_t input[10],
                                                      uint64_t salt_scalar,
                                                      uint64_t round_base) {
-    little_box_execute_scalar(input, salt_scalar, round_base, 1);
+    little_box_execute_scalar_single(input, salt_scalar, round_base);
 }
 
 /* ==================== RANDOM SALT GENERATION ==================== */
@@ -225,30 +290,32 @@ static inline bool little_box_complete(uint64_t lb[LITTLE_BOX_PROCESSES]) {
  * @param ctx Hash context
  * @param box_index Index of the BIG box to execute
  * @param round_base Base round number for constant selection
+ * @param salt Salt derived from the hash state by generate_salt()
+ * @param simd_type SIMD type selecting the LITTLE box executor
  */
-static inline void big_box_execute(XzalgoChain_CTX* ctx, int box_index, uint64_t round_base) {
-    /* Select appropriate executor based on SIMD type */
-    void (*executor)(uint64_t[10], uint64_t, uint64_t);
-
-    if (ctx->simd_type == SIMD_AVX2) {
-#if defined(__AVX2__) && (defined(__x86_64__) || defined(__i386__))
-        executor = little_box_execute_simd_adapter;
-#else
-        executor = little_box_execute_scalar_adapter;
+static inline void big_box_execute(XzalgoChain_CTX* ctx, int box_index, uint64_t round_base,
+                                   const uint64_t salt[5], uint8_t simd_type) {
+    /* Select executor from the SIMD type passed by the caller
+     * No global state is consulted here
+     */
+    void (*executor)(uint64_t[10], uint64_t, uint64_t) = little_box_execute_scalar_adapter;
+    (void) simd_type; /* Unused when no SIMD backend is compiled in */
+
+#if defined(XZALGOCHAIN_HAVE_AVX2)
+    if (simd_type == SIMD_AVX2) executor = little_box_execute_avx2_adapter;
 #endif
-    } else if (ctx->simd_type == SIMD_NEON) {
-#if defined(__ARM_NEON) && (defined(__arm__) || defined(__aarch64__))
-        executor = little_box_execute_simd_adapter;
-#else
-        executor = little_box_execute_scalar_adapter;
+#if defined(XZALGOCHAIN_HAVE_SSE2)
+    if (simd_type == SIMD_SSE2) executor = little_box_execute_sse2_adapter;
+#endif
+#if defined(XZALGOCHAIN_HAVE_NEON)
+    if (simd_type == SIMD_NEON) executor = little_box_execute_neon_adapter;
+#endif
+#if defined(XZALGOCHAIN_HAVE_WASM_SIMD)
+    if (simd_type == SIMD_WASM) executor = little_box_execute_wasm_adapter;
+#endif
+#if defined(XZALGOCHAIN_HAVE_VECEXT)
+    if (simd_type == SIMD_VECEXT) executor = little_box_execute_vecext_adapter;
 #endif
-    } else {
-        executor = little_box_execute_scalar_adapter;
-    }
-
-    /* Generate salt from current hash state */
-    uint64_t salt[5] = {0};
-    generate_salt((uint64_t*) ctx->h, salt);
 
     /* Process each LITTLE box */
     for (int lb = 0; lb < LITTLE_BOX_COUNT; lb++) {
@@ -290,27 +357,226 @@ static inline void big_box_execute(XzalgoChain_CTX* ctx, int box_index, uint64_t
     }
 }
 
+/* ==================== BACKEND POLICY ==================== */
+
+/**
+ * Check whether a backend policy can run in this build on this CPU
+ * A backend must be compiled in and supported by the running processor
+ *
+ * @param backend Backend policy (XZ_BACKEND_*)
+ * @return 1 if the backend is usable, 0 otherwise
+ */
+static inline int xzalgochain_backend_available(int backend) {
+    switch (backend) {
+        case XZ_BACKEND_AUTO:
+        case XZ_BACKEND_SCALAR:
+            return 1;
+
+        case XZ_BACKEND_AVX2:
+#if defined(XZALGOCHAIN_HAVE_AVX2)
+            return xzalgochain_avx2_supported();
+#else
+            return 0;
+#endif
+
+        case XZ_BACKEND_NEON:
+#if defined(XZALGOCHAIN_HAVE_NEON)
+            return xzalgochain_neon_supported();
+#else
+            return 0;
+#endif
+
+        case XZ_BACKEND_SSE2:
+#if defined(XZALGOCHAIN_HAVE_SSE2)
+            return xzalgochain_sse2_supported();
+#else
+            return 0;
+#endif
+
+        case XZ_BACKEND_WASM:
+#if defined(XZALGOCHAIN_HAVE_WASM_SIMD)
+            /* A -msimd128 module only instantiates on engines with SIMD128 */
+            return 1;
+#else
+            return 0;
+#endif
+
+        case XZ_BACKEND_VECEXT:
+#if defined(XZALGOCHAIN_HAVE_VECEXT)
+            /* Compiled for the baseline ISA, so it runs wherever the build runs */
+            return 1;
+#else
+            return 0;
+#endif
+
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Get human-readable name of a backend policy
+ *
+ * @param backend Backend policy (XZ_BACKEND_*)
+ * @return String constant: "Auto", "Scalar", "AVX2", "NEON", "VecExt", "SSE2", "WASM",
+ *         or "Unknown"
+ */
+static inline const char* xzalgochain_backend_name(int backend) {
+    switch (backend) {
+        case XZ_BACKEND_AUTO:
+            return "Auto";
+        case XZ_BACKEND_SCALAR:
+            return "Scalar";
+        case XZ_BACKEND_AVX2:
+            return "AVX2";
+        case XZ_BACKEND_NEON:
+            return "NEON";
+        case XZ_BACKEND_VECEXT:
+            return "VecExt";
+        case XZ_BACKEND_SSE2:
+            return "SSE2";
+        case XZ_BACKEND_WASM:
+            return "WASM";
+        default:
+            return "Unknown";
+    }
+}
+
+/**
+ * Resolve a backend policy to the SIMD type executed by big_box_execute()
+ * XZ_BACKEND_AUTO picks the best usable backend unless the process-wide
+ * scalar default is set; unusable explicit requests resolve to SIMD_NONE
+ *
+ * @param backend Backend policy (XZ_BACKEND_*)
+ * AUTO preference: AVX2, SSE2, NEON, WASM SIMD128, then the portable vector extensions
+ *
+ * @return SIMD type constant: SIMD_AVX2, SIMD_SSE2, SIMD_NEON, SIMD_WASM, SIMD_VECEXT,
+ *         or SIMD_NONE
+ */
+static inline uint8_t _xz_resolve_backend(int backend) {
+    if (backend == XZ_BACKEND_AUTO) {
+        if (xzalgochain_is_forced_scalar())
+            return SIMD_NONE;
+        if (xzalgochain_backend_available(XZ_BACKEND_AVX2))
+            return SIMD_AVX2;
+        if (xzalgochain_backend_available(XZ_BACKEND_SSE2))
+            return SIMD_SSE2;
+        if (xzalgochain_backend_available(XZ_BACKEND_NEON))
+            return SIMD_NEON;
+        if (xzalgochain_backend_available(XZ_BACKEND_WASM))
+            return SIMD_WASM;
+        if (xzalgochain_backend_available(XZ_BACKEND_VECEXT))
+            return SIMD_VECEXT;
+        return SIMD_NONE;
+    }
+
+    if (backend == XZ_BACKEND_AVX2 && xzalgochain_backend_available(XZ_BACKEND_AVX2))
+        return SIMD_AVX2;
+    if (backend == XZ_BACKEND_NEON && xzalgochain_backend_available(XZ_BACKEND_NEON))
+        return SIMD_NEON;
+    if (backend == XZ_BACKEND_VECEXT && xzalgochain_backend_available(XZ_BACKEND_VECEXT))
+        return SIMD_VECEXT;
+    if (backend == XZ_BACKEND_SSE2 && xzalgochain_backend_available(XZ_BACKEND_SSE2))
+        return SIMD_SSE2;
+    if (backend == XZ_BACKEND_WASM && xzalgochain_backend_available(XZ_BACKEND_WASM))
+        return SIMD_WASM;
+
+    return SIMD_NONE;
+}
+
+/**
+ * Map a resolved SIMD type back to the explicit backend policy that runs it
+ *
+ * @param simd_type SIMD type constant (SIMD_*)
+ * @return Backend policy (XZ_BACKEND_*), XZ_BACKEND_SCALAR for SIMD_NONE
+ */
+static inline int _xz_simd_to_backend(uint8_t simd_type) {
+    switch (simd_type) {
+        case SIMD_AVX2:
+            return XZ_BACKEND_AVX2;
+        case SIMD_NEON:
+            return XZ_BACKEND_NEON;
+        case SIMD_VECEXT:
+            return XZ_BACKEND_VECEXT;
+        case SIMD_SSE2:
+            return XZ_BACKEND_SSE2;
+        case SIMD_WASM:
+            return XZ_BACKEND_WASM;
+        default:
+            return XZ_BACKEND_SCALAR;
+    }
+}
+
+/* ==================== AUTOTUNE STATE ==================== */
+
+/**
+ * SIMD type chosen by xzalgochain_autotune() or xzalgochain_autotune_load()
+ * Backends only differ in the BIG box pass of xzalgochain_final(), whose
+ * work is the same for every message length, so a single choice covers
+ * all messages. Only contexts using XZ_BACKEND_AUTO consult it; explicit
+ * policies are never overridden.
+ *
+ * _xz_tune_state: 0 = untuned, 1 = calibration running, 2 = choice valid
+ * The choice is written before the state is published as 2, so readers
+ * that observe 2 also observe the choice.
+ */
+XZALGOCHAIN_SELECTANY uint8_t _xz_tune_simd_type = SIMD_NONE;
+
+#ifdef __STDC_NO_ATOMICS__
+XZALGOCHAIN_SELECTANY int _xz_tune_state = 0;
+#define _XZ_TUNE_STATE_LOAD() (_xz_tune_state)
+#define _XZ_TUNE_STATE_STORE(v) (_xz_tune_state = (v))
+#else
+XZALGOCHAIN_SELECTANY atomic_int _xz_tune_state = 0;
+#define _XZ_TUNE_STATE_LOAD() atomic_load(&_xz_tune_state)
+#define _XZ_TUNE_STATE_STORE(v) atomic_store(&_xz_tune_state, (v))
+#endif
+
+/**
+ * Pick the SIMD type for the final BIG box pass of an AUTO context
+ * When nothing is tuned, or AUTO already resolved to scalar (no SIMD
+ * present or the scalar default is forced), the resolved type is kept.
+ *
+ * @param resolved SIMD type chosen at init time
+ * @return SIMD type to use for the final BIG box pass
+ */
+static inline uint8_t _xz_tuned_simd_type(uint8_t resolved) {
+    if (resolved == SIMD_NONE || _XZ_TUNE_STATE_LOAD() != 2)
+        return resolved;
+    return _xz_tune_simd_type;
+}
+
 /* ==================== INITIALIZATION ==================== */
 
 /**
- * Initialize a new hash context
- * Sets initial hash values, clears state, and detects SIMD capabilities
+ * Initialize a new hash context with an explicit backend policy
+ * The policy is resolved once here and stored in the context, so the
+ * hot path never consults global state. All backends produce identical
+ * digests; the policy only affects speed.
  *
  * @param ctx Context to initialize
+ * @param backend Backend policy (XZ_BACKEND_AUTO, XZ_BACKEND_SCALAR, ...)
+ * @return 0 on success, -1 if ctx is NULL or the requested backend is
+ *         unavailable (the context is then initialized with the scalar backend)
  */
-static inline void xzalgochain_init(XzalgoChain_CTX* ctx) {
-    if (!ctx) return;
+static inline int xzalgochain_init_ex(XzalgoChain_CTX* ctx, int backend) {
+    int status = 0;
 
-    /* Detect SIMD type unless scalar mode is forced */
-    if (!xzalgochain_is_forced_scalar()) {
-        ctx->simd_type = xzalgochain_get_simd_type();
-        if (((uintptr_t) ctx->buffer % 32) != 0) {
-            ctx->simd_type = SIMD_NONE;
-        }
-    } else {
-        ctx->simd_type = SIMD_NONE;
+    if (!ctx) return -1;
+
+    if (!xzalgochain_backend_available(backend)) {
+        backend = XZ_BACKEND_SCALAR;
+        status = -1;
     }
 
+#if defined(XZALGOCHAIN_AUTOTUNE_ON_FIRST_USE)
+    if (backend == XZ_BACKEND_AUTO && _XZ_TUNE_STATE_LOAD() == 0)
+        xzalgochain_autotune();
+#endif
+
+    ctx->backend = (uint8_t) backend;
+    ctx->simd_type = _xz_resolve_backend(backend);
+
     /* Initialize hash with non-zero constants (fractional parts of sqrt of primes) */
     ctx->h[0] = 0xBB67AE854A7D9E31ULL;
     ctx->h[1] = 0x5BE0CD19B7F3A69CULL;
@@ -337,6 +603,19 @@ static inline void xzalgochain_init(XzalgoChain_CTX* ctx) {
     memset(ctx->buffer, 0, sizeof(ctx->buffer));
     ctx->buffer_len = 0;
     ctx->total_bits = 0;
+
+    return status;
+}
+
+/**
+ * Initialize a new hash context
+ * Sets initial hash values, clears state, and selects the best backend
+ * (equivalent to xzalgochain_init_ex(ctx, XZ_BACKEND_AUTO))
+ *
+ * @param ctx Context to initialize
+ */
+static inline void xzalgochain_init(XzalgoChain_CTX* ctx) {
+    xzalgochain_init_ex(ctx, XZ_BACKEND_AUTO);
 }
 
 /* ==================== UPDATE ==================== */
@@ -408,34 +687,77 @@ static inline void xzalgochain_update(XzalgoChain_CTX* ctx, const uint8_t* __res
     }
 }
 
-/* ==================== FINAL ==================== */
-
 /**
- * Finalize hash computation and produce output
- * Applies padding, processes remaining data, and performs final mixing
+ * Update hash context with a run of zero bytes
+ * Gives the same state as xzalgochain_update() on len zero bytes, but
+ * whole blocks are processed from a shared all-zero block, so no input
+ * buffer is needed and nothing is copied or loaded. Used for holes in
+ * sparse files.
  *
  * @param ctx Hash context
- * @param output Output buffer (must be at least XZALGOCHAIN_HASH_SIZE bytes)
+ * @param len Number of zero bytes
  */
-static inline void xzalgochain_final(XzalgoChain_CTX* ctx, uint8_t output[XZALGOCHAIN_HASH_SIZE]) {
-    if (!ctx || !output) return;
+static inline void xzalgochain_update_zeros(XzalgoChain_CTX* ctx, uint64_t len) {
+    static const uint64_t zero_block[16] = {0};
 
-    /* Apply padding: add 0x80 byte followed by zeros */
-    ctx->buffer[ctx->buffer_len] = 0x80;
-    ctx->buffer_len++;
-    memset(ctx->buffer + ctx->buffer_len, 0, 128 - ctx->buffer_len);
+    if (!ctx || len == 0) return;
 
-    /* Process final block */
-    uint64_t block[16];
-    for (int i = 0; i < 16; i++) block[i] = bytes_to_u64(ctx->buffer + i * 8);
-    process_block(ctx->h, block);
+    /* Same saturating bit count as xzalgochain_update() */
+    uint64_t bits_to_add = len > UINT64_MAX / 8 ? UINT64_MAX : len * 8;
+    if (ctx->total_bits > UINT64_MAX - bits_to_add) {
+        ctx->total_bits = UINT64_MAX;
+    } else {
+        ctx->total_bits += bits_to_add;
+    }
+
+    /* Complete a partial block with zeros */
+    if (ctx->buffer_len > 0) {
+        size_t fill = len < (uint64_t) (128 - ctx->buffer_len) ? (size_t) len : 128 - ctx->buffer_len;
+        memset(ctx->buffer + ctx->buffer_len, 0, fill);
+        ctx->buffer_len += fill;
+        len -= fill;
+
+        if (ctx->buffer_len == 128) {
+            uint64_t block[16];
+            for (int i = 0; i < 16; i++) block[i] = bytes_to_u64(ctx->buffer + i * 8);
+            process_block(ctx->h, block);
+            ctx->buffer_len = 0;
+        }
+    }
+
+    /* Whole zero blocks */
+    for (; len >= 128; len -= 128)
+        process_block(ctx->h, zero_block);
+
+    /* Zero tail waits in the buffer */
+    if (len > 0) {
+        memset(ctx->buffer, 0, (size_t) len);
+        ctx->buffer_len = (size_t) len;
+    }
+}
+
+/* ==================== FINAL ==================== */
+
+/**
+ * Finalization shared by xzalgochain_final() and xzalgochain_many()
+ * Runs the BIG boxes on a hash state that has absorbed the padded last
+ * block, then the final mixing, and writes the digest
+ *
+ * @param ctx Context whose h holds the state after the last block
+ * @param output Output buffer (must be at least XZALGOCHAIN_HASH_SIZE bytes)
+ */
+static inline void _xz_finalize(XzalgoChain_CTX* ctx, uint8_t output[XZALGOCHAIN_HASH_SIZE]) {
+    /* AUTO contexts use the tuned backend; the context keeps its own */
+    uint8_t simd_type = ctx->simd_type;
+    if (ctx->backend == XZ_BACKEND_AUTO)
+        simd_type = _xz_tuned_simd_type(simd_type);
 
-    /* Generate salt and execute BIG boxes */
+    /* The BIG boxes do not change the hash state, so they share one salt */
     uint64_t salt[5];
-    generate_salt((uint64_t*) ctx->h, salt);
+    generate_salt(ctx->h, salt);
 
     for (int bb = 0; bb < BIG_BOX_COUNT; bb++)
-        big_box_execute(ctx, bb, bb * 2000);
+        big_box_execute(ctx, bb, bb * 2000, salt, simd_type);
 
     /* Final mixing of hash state */
     const uint8_t rot_params[5] = {31, 27, 33, 23, 29};
@@ -502,9 +824,34 @@ static inline void xzalgochain_final(XzalgoChain_CTX* ctx, uint8_t output[XZALGO
     for (int i = 0; i < 5; i++)
         u64_to_bytes(ctx->h[i], output + i * 8);
 
+    secure_wipe(salt, sizeof(salt));
     secure_wipe(ctx->h, sizeof(ctx->h));
 }
 
+
+/**
+ * Finalize hash computation and produce output
+ * Applies padding, processes remaining data, and performs final mixing
+ *
+ * @param ctx Hash context
+ * @param output Output buffer (must be at least XZALGOCHAIN_HASH_SIZE bytes)
+ */
+static inline void xzalgochain_final(XzalgoChain_CTX* ctx, uint8_t output[XZALGOCHAIN_HASH_SIZE]) {
+    if (!ctx || !output) return;
+
+    /* Apply padding: add 0x80 byte followed by zeros */
+    ctx->buffer[ctx->buffer_len] = 0x80;
+    ctx->buffer_len++;
+    memset(ctx->buffer + ctx->buffer_len, 0, 128 - ctx->buffer_len);
+
+    /* Process final block */
+    uint64_t block[16];
+    for (int i = 0; i < 16; i++) block[i] = bytes_to_u64(ctx->buffer + i * 8);
+    process_block(ctx->h, block);
+
+    _xz_finalize(ctx, output);
+}
+
 /* ==================== SINGLE-SHOT HASH ==================== */
 
 /**
@@ -529,9 +876,10 @@ static inline void xzalgochain(const uint8_t* data, size_t len, uint8_t output[X
 
 /**
  * Reset context to initial state (same as re-initializing)
+ * Keeps the backend policy the context was initialized with
  */
 static inline void xzalgochain_ctx_reset(XzalgoChain_CTX* ctx) {
-    if (ctx) xzalgochain_init(ctx);
+    if (ctx) xzalgochain_init_ex(ctx, ctx->backend);
 }
 
 /**
@@ -595,6 +943,190 @@ static inline int xzalgochain_is_forced_scalar(void) {
 }
 #endif
 
+/* ==================== AUTOTUNE ==================== */
+
+/**
+ * Optional one-time calibration of the AUTO backend
+ *
+ * xzalgochain_autotune() times the finalization of an empty message with
+ * every usable backend and records the fastest one. Finalization is the
+ * only place backends run, and its work does not depend on the message
+ * length, so one measurement decides for every message. Afterwards,
+ * contexts initialized with XZ_BACKEND_AUTO use that backend at
+ * finalization. Digests are identical for every backend; tuning only
+ * affects speed.
+ *
+ * Define XZALGOCHAIN_AUTOTUNE_ON_FIRST_USE to calibrate automatically
+ * on the first xzalgochain_init_ex(ctx, XZ_BACKEND_AUTO) call.
+ */
+
+/* Finalizations timed per repetition */
+#define XZ_TUNE_ITERATIONS 64
+
+/* Timed repetitions per candidate; the fastest repetition is kept */
+#define XZ_TUNE_REPEATS 3
+
+/* A candidate must beat the current best by this factor to replace it */
+#define XZ_TUNE_MARGIN 0.97
+
+/**
+ * Monotonic-enough wall clock in seconds for calibration
+ */
+static inline double _xz_tune_now(void) {
+#if defined(TIME_UTC)
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#else
+    return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * Time XZ_TUNE_ITERATIONS finalizations with one backend
+ * The context is initialized once and copied per finalization so that
+ * backend detection cost does not skew the comparison.
+ *
+ * @param backend Backend policy to time
+ * @return Best elapsed time over XZ_TUNE_REPEATS repetitions, in seconds
+ */
+static inline double _xz_tune_measure(int backend) {
+    XzalgoChain_CTX fresh, ctx;
+    uint8_t out[XZALGOCHAIN_HASH_SIZE];
+    double best = -1.0;
+
+    xzalgochain_init_ex(&fresh, backend);
+
+    for (int rep = 0; rep < XZ_TUNE_REPEATS; rep++) {
+        double start = _xz_tune_now();
+        for (int i = 0; i < XZ_TUNE_ITERATIONS; i++) {
+            memcpy(&ctx, &fresh, sizeof(ctx));
+            xzalgochain_final(&ctx, out);
+        }
+        double elapsed = _xz_tune_now() - start;
+        if (best < 0.0 || elapsed < best) best = elapsed;
+    }
+
+    secure_wipe(&ctx, sizeof(ctx));
+    return best;
+}
+
+/**
+ * Benchmark all usable backends and record the fastest
+ * Safe to call from several threads; only one calibration runs and the
+ * others return immediately without waiting for it.
+ *
+ * @return 0 (also when a calibration is already running)
+ */
+static inline int xzalgochain_autotune(void) {
+#ifdef __STDC_NO_ATOMICS__
+    if (_xz_tune_state == 1) return 0;
+    _xz_tune_state = 1;
+#else
+    int expected = _XZ_TUNE_STATE_LOAD();
+    if (expected == 1 || !atomic_compare_exchange_strong(&_xz_tune_state, &expected, 1))
+        return 0;
+#endif
+
+    /* Start from the untuned AUTO choice so noise alone cannot displace it */
+    int best_backend = _xz_simd_to_backend(_xz_resolve_backend(XZ_BACKEND_AUTO));
+    double best_time = _xz_tune_measure(best_backend);
+
+    for (int b = XZ_BACKEND_SCALAR; b < XZ_BACKEND_COUNT; b++) {
+        if (b == best_backend || !xzalgochain_backend_available(b)) continue;
+        double t = _xz_tune_measure(b);
+        if (t < best_time * XZ_TUNE_MARGIN) {
+            best_time = t;
+            best_backend = b;
+        }
+    }
+
+    _xz_tune_simd_type = _xz_resolve_backend(best_backend);
+    _XZ_TUNE_STATE_STORE(2);
+    return 0;
+}
+
+/**
+ * Get the backend chosen by the autotuner
+ *
+ * @return Backend policy (XZ_BACKEND_*), or XZ_BACKEND_AUTO if not tuned
+ */
+static inline int xzalgochain_autotune_backend(void) {
+    if (_XZ_TUNE_STATE_LOAD() != 2) return XZ_BACKEND_AUTO;
+    return _xz_simd_to_backend(_xz_tune_simd_type);
+}
+
+/**
+ * Save the tuned backend to a text profile
+ * Format: a "xzalgochain-autotune 2" header line, then
+ * "final <backend name>"
+ *
+ * @param path Output file path
+ * @return 0 on success, -1 if not tuned or on I/O error
+ */
+static inline int xzalgochain_autotune_save(const char* path) {
+    if (!path || _XZ_TUNE_STATE_LOAD() != 2) return -1;
+
+    FILE* f = fopen(path, "w");
+    if (!f) return -1;
+
+    fprintf(f, "xzalgochain-autotune 2\n");
+    fprintf(f, "final %s\n", xzalgochain_backend_name(xzalgochain_autotune_backend()));
+
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+/**
+ * Load a profile written by xzalgochain_autotune_save()
+ * The profile is rejected if it is malformed, has another version, or
+ * names a backend unusable on this machine.
+ *
+ * @param path Profile file path
+ * @return 0 on success, -1 on error (the current choice is left unchanged)
+ */
+static inline int xzalgochain_autotune_load(const char* path) {
+    if (!path) return -1;
+
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+
+    char line[128];
+    char name[32];
+    int version = 0;
+    int ok = fgets(line, sizeof(line), f) && sscanf(line, "xzalgochain-autotune %d", &version) == 1 &&
+             version == 2 && fgets(line, sizeof(line), f) && sscanf(line, "final %31s", name) == 1;
+    fclose(f);
+    if (!ok) return -1;
+
+    int backend = -1;
+    for (int b = XZ_BACKEND_SCALAR; b < XZ_BACKEND_COUNT; b++)
+        if (strcmp(name, xzalgochain_backend_name(b)) == 0) backend = b;
+    if (backend < 0 || !xzalgochain_backend_available(backend)) return -1;
+
+#ifdef __STDC_NO_ATOMICS__
+    if (_xz_tune_state == 1) return -1;
+#else
+    int expected = _XZ_TUNE_STATE_LOAD();
+    if (expected == 1 || !atomic_compare_exchange_strong(&_xz_tune_state, &expected, 1))
+        return -1;
+#endif
+    _xz_tune_simd_type = _xz_resolve_backend(backend);
+    _XZ_TUNE_STATE_STORE(2);
+    return 0;
+}
+
+/**
+ * Discard the tuned choice; AUTO contexts return to the untuned backend
+ */
+static inline void xzalgochain_autotune_reset(void) {
+#ifdef __STDC_NO_ATOMICS__
+    if (_xz_tune_state == 2) _xz_tune_state = 0;
+#else
+    int expected = 2;
+    atomic_compare_exchange_strong(&_xz_tune_state, &expected, 0);
+#endif
+}
+
 /* ==================== CSPRNG Function ==================== */
 
 /**
@@ -639,4 +1171,19 @@ static inline int xz_generate_salt(void* buf, unsigned int bits) {
 }
 #endif
 
+/* File and file-descriptor hashing (mmap / read) */
+#include "xz_file.h"
+
+/* Pipelined file hashing (io_uring / reader thread) */
+#include "xz_aio.h"
+
+/* Concurrent hashing of explicit byte ranges (pread) */
+#include "xz_ranges.h"
+
+/* Lane-parallel hashing of many small messages */
+#include "xz_multi.h"
+
+/* Binary manifests: sorted digest table and path index, used in place */
+#include "xz_manifest.h"
+
 #endif /* XZALGOCHAIN_H */
@@ -0,0 +1,465 @@
+/*
+ * XzalgoChain - 320-bit Cryptographic Hash Function
+ * Copyright 2026 Xzrayツ
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XZALGOCHAIN_ALGORITHM_SIMD_SSE_H
+#define XZALGOCHAIN_ALGORITHM_SIMD_SSE_H
+
+/* This file is meant to be included only from algorithm_simd.h
+ * when SSE2 is available on x86/x64 platforms.
+ */
+
+#include <emmintrin.h> /* SSE2 intrinsics header */
+
+/* ==================== SSE2 IMPLEMENTATION (x86/x64) ==================== */
+/**
+ * SSE2 SIMD implementation for x86/x64 hosts without AVX2
+ * SSE2 uses 128-bit registers, so we combine two registers
+ * (lo and hi) to simulate 256-bit operations, as the NEON backend does.
+ * SSE2 is part of the x86-64 baseline, so this backend is available on
+ * every 64-bit x86 CPU.
+ */
+
+#define XZALGOCHAIN_HAVE_SSE2 1
+
+/* ================= 256-bit wrapper ================= */
+/**
+ * 256-bit type for SSE2 using two 128-bit registers
+ * lo: lower 128 bits (lanes 0-1)
+ * hi: upper 128 bits (lanes 2-3)
+ */
+typedef struct {
+    __m128i lo; /* Lower 128 bits: lanes 0,1 */
+    __m128i hi; /* Upper 128 bits: lanes 2,3 */
+} sse256_t;
+
+/* ================= constructors ================= */
+
+/**
+ * Create a 256-bit SSE2 vector from four 64-bit values
+ * @param x3 Value for lane 3 (highest)
+ * @param x2 Value for lane 2
+ * @param x1 Value for lane 1
+ * @param x0 Value for lane 0 (lowest)
+ * @return 256-bit SSE2 vector
+ */
+static inline sse256_t s256_set_epi64x(uint64_t x3, uint64_t x2, uint64_t x1, uint64_t x0) {
+    sse256_t r;
+    r.lo = _mm_set_epi64x((long long) x1, (long long) x0);
+    r.hi = _mm_set_epi64x((long long) x3, (long long) x2);
+    return r;
+}
+
+/**
+ * Create a 256-bit SSE2 vector with all lanes set to the same value
+ * @param x Value to replicate across all 4 lanes
+ * @return 256-bit SSE2 vector with all lanes = x
+ */
+static inline sse256_t s256_set1(uint64_t x) {
+    sse256_t r;
+    r.lo = _mm_set1_epi64x((long long) x);
+    r.hi = r.lo;
+    return r;
+}
+
+/**
+ * Store the four lanes of a 256-bit SSE2 vector
+ * @param out Destination array (4 64-bit values, lane 0 first)
+ * @param v Input vector
+ */
+static inline void s256_store(uint64_t out[4], sse256_t v) {
+    _mm_storeu_si128((__m128i*) &out[0], v.lo);
+    _mm_storeu_si128((__m128i*) &out[2], v.hi);
+}
+
+/* ================= basic ops ================= */
+
+/**
+ * XOR two 256-bit SSE2 vectors lane-wise
+ * @param a First vector
+ * @param b Second vector
+ * @return Vector where each lane = a.lane[i] ^ b.lane[i]
+ */
+static inline sse256_t s256_xor(sse256_t a, sse256_t b) {
+    sse256_t r;
+    r.lo = _mm_xor_si128(a.lo, b.lo);
+    r.hi = _mm_xor_si128(a.hi, b.hi);
+    return r;
+}
+
+/**
+ * Add two 256-bit SSE2 vectors lane-wise
+ * @param a First vector
+ * @param b Second vector
+ * @return Vector where each lane = a.lane[i] + b.lane[i]
+ */
+static inline sse256_t s256_add(sse256_t a, sse256_t b) {
+    sse256_t r;
+    r.lo = _mm_add_epi64(a.lo, b.lo);
+    r.hi = _mm_add_epi64(a.hi, b.hi);
+    return r;
+}
+
+/* ================= SSE2 64-bit rotations ================= */
+
+/**
+ * Left rotate each lane in a 128-bit SSE2 register
+ * Uses the register-count shifts so r need not be a compile-time constant
+ *
+ * @param v 128-bit vector with two 64-bit lanes
+ * @param r Rotation amount in bits (1-63)
+ * @return Vector with each lane rotated left by r bits
+ */
+static inline __m128i sse_rotl64(__m128i v, int r) {
+    return _mm_or_si128(_mm_sll_epi64(v, _mm_cvtsi32_si128(r)),
+                        _mm_srl_epi64(v, _mm_cvtsi32_si128(64 - r)));
+}
+
+/**
+ * Right rotate each lane in a 128-bit SSE2 register
+ * @param v 128-bit vector with two 64-bit lanes
+ * @param r Rotation amount in bits (1-63)
+ * @return Vector with each lane rotated right by r bits
+ */
+static inline __m128i sse_rotr64(__m128i v, int r) {
+    return _mm_or_si128(_mm_srl_epi64(v, _mm_cvtsi32_si128(r)),
+                        _mm_sll_epi64(v, _mm_cvtsi32_si128(64 - r)));
+}
+
+/* ================= SSE2 256-bit rotations ================= */
+
+/**
+ * Left rotate each lane in a 256-bit SSE2 vector
+ * @param v Input 256-bit vector
+ * @param r Rotation amount in bits
+ * @return Vector with each lane rotated left by r bits
+ */
+static inline sse256_t s256_rotl(sse256_t v, int r) {
+    sse256_t result;
+    result.lo = sse_rotl64(v.lo, r);
+    result.hi = sse_rotl64(v.hi, r);
+    return result;
+}
+
+/**
+ * Right rotate each lane in a 256-bit SSE2 vector
+ * @param v Input 256-bit vector
+ * @param r Rotation amount in bits
+ * @return Vector with each lane rotated right by r bits
+ */
+static inline sse256_t s256_rotr(sse256_t v, int r) {
+    sse256_t result;
+    result.lo = sse_rotr64(v.lo, r);
+    result.hi = sse_rotr64(v.hi, r);
+    return result;
+}
+
+/* ================= permute clone ================= */
+
+/**
+ * Build one 128-bit half from two lanes of a 256-bit vector (indices 0-3)
+ * _mm_shuffle_pd picks lane i0 & 1 of the first source and lane i1 & 1 of
+ * the second, so each half costs a single shufpd. Indices must be
+ * compile-time constants.
+ */
+#define SSE_SELECT(v, i0, i1)                                                  \
+    _mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd((i0) < 2 ? (v).lo : (v).hi), \
+                                    _mm_castsi128_pd((i1) < 2 ? (v).lo : (v).hi), \
+                                    ((i0) & 1) | (((i1) & 1) << 1)))
+
+/**
+ * Permute lanes of a 256-bit SSE2 vector according to immediate value
+ * Same encoding as AVX2's _mm256_permute4x64_epi64
+ *
+ * @param v Input vector
+ * @param imm Permutation pattern (8-bit constant, each 2 bits select a lane)
+ * @return Vector with lanes permuted as specified
+ */
+#define S256_PERMUTE(v, imm)                                           \
+    ((sse256_t){SSE_SELECT(v, ((imm) >> 0) & 3, ((imm) >> 2) & 3), \
+                SSE_SELECT(v, ((imm) >> 4) & 3, ((imm) >> 6) & 3)})
+
+/* ================= mix_lanes ================= */
+
+/**
+ * Mix lanes within a 256-bit SSE2 vector for cross-lane diffusion
+ * SSE2 equivalent of AVX2's mix_lanes function
+ *
+ * @param v Input vector
+ * @return Mixed vector
+ */
+static inline sse256_t s256_mix_lanes(sse256_t v) {
+    /* Permute: (1,0,3,2) - swap adjacent lane pairs */
+    sse256_t p0 = S256_PERMUTE(v, 0x4E);
+
+    /* Further permute: (2,3,0,1) - swap the pairs */
+    sse256_t p1 = S256_PERMUTE(p0, 0xB1);
+
+    /* XOR the two permuted versions */
+    sse256_t x = s256_xor(p0, p1);
+
+    /* Rotate left by 17 bits and XOR with original */
+    return s256_xor(x, s256_rotl(x, 17));
+}
+
+/* ================= mullo64 ================= */
+
+/**
+ * Multiply each lane of a 128-bit register by a 64-bit constant
+ * SSE2 has no 64x64->64 multiply, so it is assembled from 32x32->64
+ * products: a * c = lo(a)*lo(c) + ((lo(a)*hi(c) + hi(a)*lo(c)) << 32)
+ *
+ * @param a Input vector
+ * @param c_lo Constant's low 32 bits in each 64-bit lane
+ * @param c_hi Constant's high 32 bits in each 64-bit lane
+ * @return Vector with each lane multiplied by the constant
+ */
+static inline __m128i sse_mullo64(__m128i a, __m128i c_lo, __m128i c_hi) {
+    __m128i lo = _mm_mul_epu32(a, c_lo);
+    __m128i cross = _mm_add_epi64(_mm_mul_epu32(a, c_hi),
+                                  _mm_mul_epu32(_mm_srli_epi64(a, 32), c_lo));
+    return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+}
+
+/**
+ * Multiply each lane of a 256-bit SSE2 vector by a constant
+ * @param v Input vector
+ * @param c Constant multiplier
+ * @return Vector with each lane multiplied by c
+ */
+static inline sse256_t s256_mul64(sse256_t v, uint64_t c) {
+    __m128i c_lo = _mm_set1_epi64x((long long) (c & 0xFFFFFFFFULL));
+    __m128i c_hi = _mm_set1_epi64x((long long) (c >> 32));
+
+    sse256_t r;
+    r.lo = sse_mullo64(v.lo, c_lo, c_hi);
+    r.hi = sse_mullo64(v.hi, c_lo, c_hi);
+    return r;
+}
+
+/* ================= arx_mix ================= */
+
+/**
+ * ARX (Add-Rotate-XOR) mixing function for SSE2 vectors
+ * SSE2 equivalent of AVX2's arx_mix function
+ *
+ * @param v Input vector to mix
+ * @param salt Salt vector
+ * @param rc Round constant vector
+ * @param r1 First rotation amount
+ * @param r2 Second rotation amount
+ * @return Mixed vector
+ */
+static inline sse256_t s256_arx_mix(
+    sse256_t v,
+    sse256_t salt,
+    sse256_t rc,
+    int r1,
+    int r2) {
+    v = s256_add(v, salt);
+    v = s256_xor(v, rc);
+    v = s256_add(v, s256_rotl(v, r1));
+    v = s256_xor(v, s256_rotr(v, r2));
+    v = s256_mix_lanes(v);
+    return s256_mul64(v, 0x800000000000808AULL);
+}
+
+/* ================= horizontal_xor ================= */
+
+/**
+ * Reduce a 256-bit SSE2 vector to a single 64-bit value
+ * SSE2 equivalent of AVX2's horizontal_xor256 function
+ *
+ * @param v Input vector
+ * @return 64-bit hash value derived from all lanes
+ */
+static inline uint64_t s256_horizontal_xor(sse256_t v) {
+    /* Lane mixing and permutations (same pattern as scalar) */
+    v = s256_mix_lanes(v);
+    v = s256_xor(v, S256_PERMUTE(v, 0x4E));
+    v = s256_xor(v, S256_PERMUTE(v, 0x4E));
+    v = s256_xor(v, S256_PERMUTE(v, 0xB1));
+
+    /* Fold the two halves, then the two lanes */
+    uint64_t a[2];
+    _mm_storeu_si128((__m128i*) a, _mm_xor_si128(v.lo, v.hi));
+    uint64_t result = a[0] ^ a[1];
+
+    /* Final diffusion sequence (same as scalar) */
+    result ^= result >> 31;
+    result *= 0x0000000000000088ULL;
+    result ^= result >> 29;
+    result *= 0x8000000000008089ULL;
+    result ^= result >> 32;
+    result = rotr64(result, 17) ^ rotl64(result, 43);
+    result *= 0x8000000080008081ULL;
+    result ^= result >> 27;
+
+    return result;
+}
+
+/* ================= EXECUTION ================= */
+
+/**
+ * Main SSE2 execution function
+ * Processes blocks in groups of 4 using SSE2 instructions
+ *
+ * @param input Array of input blocks (each block is 10 64-bit words)
+ * @param salt_scalar Salt value for this processing round
+ * @param round_base Base round number for constant selection
+ * @param num_blocks Total number of blocks to process
+ */
+static inline void little_box_execute_simd_sse2(
+    uint64_t* input,
+    uint64_t salt_scalar,
+    uint64_t round_base,
+    size_t num_blocks) {
+    /* Create vector with salt replicated in all lanes */
+    sse256_t salt = s256_set1(salt_scalar);
+
+    /* Load round constant vectors */
+    sse256_t rc0 = s256_set_epi64x(
+        ROUND_CONSTANTS[(round_base + 3) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 2) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 1) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 0) & (ROUND_CONSTANTS_SIZE - 1)]);
+
+    sse256_t rc1 = s256_set_epi64x(
+        ROUND_CONSTANTS[(round_base + 7) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 6) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 5) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 4) & (ROUND_CONSTANTS_SIZE - 1)]);
+
+    sse256_t rc2 = s256_set_epi64x(
+        ROUND_CONSTANTS[(round_base + 11) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 10) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 9) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 8) & (ROUND_CONSTANTS_SIZE - 1)]);
+
+/* OpenMP parallel for loop (if enabled) */
+#pragma omp for schedule(static)
+    for (size_t blk = 0; blk < num_blocks; blk += 4) {
+        /* Pointers to up to 4 blocks */
+        uint64_t* in[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; i++)
+            if (blk + i < num_blocks)
+                in[i] = &input[(blk + i) * 10];
+
+        /* Load vectors from block data */
+        sse256_t v0 = s256_set_epi64x(in[3] ? in[3][1] : 0, in[2] ? in[2][1] : 0, in[1] ? in[1][1] : 0, in[0] ? in[0][1] : 0);
+        sse256_t v0l = s256_set_epi64x(in[3] ? in[3][0] : 0, in[2] ? in[2][0] : 0, in[1] ? in[1][0] : 0, in[0] ? in[0][0] : 0);
+        sse256_t v1 = s256_set_epi64x(in[3] ? in[3][5] : 0, in[2] ? in[2][5] : 0, in[1] ? in[1][5] : 0, in[0] ? in[0][5] : 0);
+        sse256_t v1l = s256_set_epi64x(in[3] ? in[3][4] : 0, in[2] ? in[2][4] : 0, in[1] ? in[1][4] : 0, in[0] ? in[0][4] : 0);
+        sse256_t v2 = s256_set_epi64x(in[3] ? in[3][9] : 0, in[2] ? in[2][9] : 0, in[1] ? in[1][9] : 0, in[0] ? in[0][9] : 0);
+        sse256_t v2l = s256_set_epi64x(in[3] ? in[3][8] : 0, in[2] ? in[2][8] : 0, in[1] ? in[1][8] : 0, in[0] ? in[0][8] : 0);
+
+        /* Apply ARX mixing */
+        v0 = s256_arx_mix(v0, salt, rc0, 7, 13);
+        v0l = s256_arx_mix(v0l, salt, rc0, 7, 13);
+        v1 = s256_arx_mix(v1, salt, rc1, 11, 17);
+        v1l = s256_arx_mix(v1l, salt, rc1, 11, 17);
+        v2 = s256_arx_mix(v2, salt, rc2, 19, 23);
+        v2l = s256_arx_mix(v2l, salt, rc2, 19, 23);
+
+        /* Mix lanes */
+        v0 = s256_mix_lanes(v0);
+        v0l = s256_mix_lanes(v0l);
+        v1 = s256_mix_lanes(v1);
+        v1l = s256_mix_lanes(v1l);
+        v2 = s256_mix_lanes(v2);
+        v2l = s256_mix_lanes(v2l);
+
+        /* Spill lanes once for the scalar stores below */
+        uint64_t t0[4], t1[4], t2[4], t0l[4], t1l[4], t2l[4];
+        s256_store(t0, v0);
+        s256_store(t1, v1);
+        s256_store(t2, v2);
+        s256_store(t0l, v0l);
+        s256_store(t1l, v1l);
+        s256_store(t2l, v2l);
+
+        /* Store results back to block 0 */
+        if (in[0]) {
+            sse256_t acc0 = s256_xor(
+                s256_xor(S256_PERMUTE(v0, 0x00), S256_PERMUTE(v1, 0x00)),
+                S256_PERMUTE(v2, 0x00));
+            in[0][0] = t0[0];
+            in[0][1] = t0[1];
+            in[0][4] = t1[0];
+            in[0][5] = t1[1];
+            in[0][8] = t2[0];
+            in[0][9] = s256_horizontal_xor(acc0);
+        }
+
+        /* Store results back to block 1 */
+        if (in[1]) {
+            sse256_t acc1 = s256_xor(
+                s256_xor(S256_PERMUTE(v0, 0x55), S256_PERMUTE(v1, 0x55)),
+                S256_PERMUTE(v2, 0x55));
+            in[1][0] = t0[2];
+            in[1][1] = t0[3];
+            in[1][4] = t1[2];
+            in[1][5] = t1[3];
+            in[1][8] = t2[2];
+            in[1][9] = s256_horizontal_xor(acc1);
+        }
+
+        /* Store results back to block 2 */
+        if (in[2]) {
+            sse256_t acc2 = s256_xor(
+                s256_xor(S256_PERMUTE(v0l, 0xAA), S256_PERMUTE(v1l, 0xAA)),
+                S256_PERMUTE(v2l, 0xAA));
+            in[2][0] = t0l[0];
+            in[2][1] = t0l[1];
+            in[2][4] = t1l[0];
+            in[2][5] = t1l[1];
+            in[2][8] = t2l[0];
+            in[2][9] = s256_horizontal_xor(acc2);
+        }
+
+        /* Store results back to block 3 */
+        if (in[3]) {
+            sse256_t acc3 = s256_xor(
+                s256_xor(S256_PERMUTE(v0l, 0xFF), S256_PERMUTE(v1l, 0xFF)),
+                S256_PERMUTE(v2l, 0xFF));
+            in[3][0] = t0l[2];
+            in[3][1] = t0l[3];
+            in[3][4] = t1l[2];
+            in[3][5] = t1l[3];
+            in[3][8] = t2l[2];
+            in[3][9] = s256_horizontal_xor(acc3);
+        }
+
+        /* Cross-block mixing for full groups of 4 */
+        if (blk + 3 < num_blocks) {
+            uint64_t* b0 = &input[(blk + 0) * 10];
+            uint64_t* b1 = &input[(blk + 1) * 10];
+            uint64_t* b2 = &input[(blk + 2) * 10];
+            uint64_t* b3 = &input[(blk + 3) * 10];
+
+            uint64_t mix = b0[9] ^ b1[9] ^ b2[9] ^ b3[9];
+            mix = rotr64(mix, 17) ^ rotl64(mix, 43);
+            mix *= 0x9E3779B97F4A7C15ULL;
+
+            b0[9] ^= mix;
+            b1[9] ^= rotr64(mix, 11);
+            b2[9] ^= rotl64(mix, 23);
+            b3[9] ^= mix ^ (mix >> 31);
+        }
+    }
+}
+
+#endif /* XZALGOCHAIN_ALGORITHM_SIMD_SSE_H */
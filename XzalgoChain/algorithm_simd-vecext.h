@@ -0,0 +1,376 @@
+/*
+ * XzalgoChain - 320-bit Cryptographic Hash Function
+ * Copyright 2026 Xzrayツ
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XZALGOCHAIN_ALGORITHM_SIMD_VECEXT_H
+#define XZALGOCHAIN_ALGORITHM_SIMD_VECEXT_H
+
+/* This file is meant to be included only from algorithm_simd.h
+ * when the compiler supports GCC/Clang vector extensions.
+ */
+
+#include "config.h"
+#include "algorithm.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/* ==================== VECTOR EXTENSION IMPLEMENTATION ==================== */
+/**
+ * Portable SIMD implementation built on GCC/Clang vector extensions
+ * One source, no intrinsics: the compiler lowers each 128-bit half to
+ * whatever the target offers (SSE2, NEON, SVE with a fixed vector length,
+ * WASM SIMD128) or to scalar code if nothing fits. Like the NEON backend,
+ * a 256-bit logical vector is a lo/hi pair, which keeps every helper on
+ * the native 128-bit calling convention of all these targets.
+ * Used as the fallback whenever no hand-written backend matches.
+ */
+
+#define XZALGOCHAIN_HAVE_VECEXT 1
+
+/* ================= vector types ================= */
+/**
+ * 128-bit vector of two 64-bit lanes
+ */
+typedef uint64_t vx128_t __attribute__((vector_size(16)));
+
+/**
+ * 256-bit type built from two 128-bit vectors
+ * lo: lanes 0-1
+ * hi: lanes 2-3
+ */
+typedef struct {
+    vx128_t lo; /* Lower 128 bits: lanes 0,1 */
+    vx128_t hi; /* Upper 128 bits: lanes 2,3 */
+} vx256_t;
+
+/* ================= permute ================= */
+
+/**
+ * Select two lanes of the lo:hi concatenation (indices 0-3)
+ * Indices must be compile-time constants so the shuffle maps to a single
+ * target instruction instead of indexed loads.
+ */
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 12)
+    #define VX128_SELECT(lo, hi, i0, i1) __builtin_shufflevector((lo), (hi), (i0), (i1))
+#else
+    #define VX128_SELECT(lo, hi, i0, i1) __builtin_shuffle((lo), (hi), (vx128_t){(i0), (i1)})
+#endif
+
+/**
+ * Permute lanes of a 256-bit vector according to an AVX2-style immediate
+ * Each 2-bit field of imm selects the source lane of one destination lane
+ * (the same encoding as _mm256_permute4x64_epi64); imm must be a constant.
+ */
+#define VX256_PERMUTE(v, imm)                                                         \
+    ((vx256_t){VX128_SELECT((v).lo, (v).hi, ((imm) >> 0) & 3, ((imm) >> 2) & 3), \
+               VX128_SELECT((v).lo, (v).hi, ((imm) >> 4) & 3, ((imm) >> 6) & 3)})
+
+/* ================= constructors ================= */
+
+/**
+ * Create a 256-bit vector from four 64-bit values
+ * @param l0 Lane 0
+ * @param l1 Lane 1
+ * @param l2 Lane 2
+ * @param l3 Lane 3
+ * @return 256-bit vector
+ */
+static inline vx256_t vx256_set(uint64_t l0, uint64_t l1, uint64_t l2, uint64_t l3) {
+    vx256_t r;
+    r.lo = (vx128_t){l0, l1};
+    r.hi = (vx128_t){l2, l3};
+    return r;
+}
+
+/**
+ * Create a 256-bit vector with all lanes set to the same value
+ * @param x Value to replicate across all 4 lanes
+ * @return 256-bit vector with all lanes = x
+ */
+static inline vx256_t vx256_set1(uint64_t x) {
+    return vx256_set(x, x, x, x);
+}
+
+/* ================= basic ops ================= */
+
+/**
+ * XOR two 256-bit vectors lane-wise
+ */
+static inline vx256_t vx256_xor(vx256_t a, vx256_t b) {
+    vx256_t r;
+    r.lo = a.lo ^ b.lo;
+    r.hi = a.hi ^ b.hi;
+    return r;
+}
+
+/**
+ * Add two 256-bit vectors lane-wise
+ */
+static inline vx256_t vx256_add(vx256_t a, vx256_t b) {
+    vx256_t r;
+    r.lo = a.lo + b.lo;
+    r.hi = a.hi + b.hi;
+    return r;
+}
+
+/**
+ * Left rotate each lane
+ * @param v Input vector
+ * @param r Rotation amount in bits (1-63)
+ * @return Vector with each lane rotated left by r bits
+ */
+static inline vx256_t vx256_rotl(vx256_t v, int r) {
+    vx256_t res;
+    res.lo = (v.lo << r) | (v.lo >> (64 - r));
+    res.hi = (v.hi << r) | (v.hi >> (64 - r));
+    return res;
+}
+
+/**
+ * Right rotate each lane
+ * @param v Input vector
+ * @param r Rotation amount in bits (1-63)
+ * @return Vector with each lane rotated right by r bits
+ */
+static inline vx256_t vx256_rotr(vx256_t v, int r) {
+    vx256_t res;
+    res.lo = (v.lo >> r) | (v.lo << (64 - r));
+    res.hi = (v.hi >> r) | (v.hi << (64 - r));
+    return res;
+}
+
+/**
+ * Multiply each lane by a constant
+ * @param v Input vector
+ * @param c Constant multiplier
+ * @return Vector with each lane multiplied by c
+ */
+static inline vx256_t vx256_mul_const(vx256_t v, uint64_t c) {
+    vx256_t r;
+    r.lo = v.lo * c;
+    r.hi = v.hi * c;
+    return r;
+}
+
+/* ================= mix_lanes ================= */
+
+/**
+ * Mix lanes within a vector for cross-lane diffusion
+ * Same permutation pattern as the scalar and AVX2 implementations
+ *
+ * @param v Input vector
+ * @return Mixed vector
+ */
+static inline vx256_t vx256_mix_lanes(vx256_t v) {
+    vx256_t p0 = VX256_PERMUTE(v, 0x4E);
+    vx256_t p1 = VX256_PERMUTE(p0, 0xB1);
+    vx256_t x = vx256_xor(p0, p1);
+    return vx256_xor(x, vx256_rotl(x, 17));
+}
+
+/* ================= arx_mix ================= */
+
+/**
+ * ARX (Add-Rotate-XOR) mixing function
+ *
+ * @param v Input vector to mix
+ * @param salt Salt vector
+ * @param rc Round constant vector
+ * @param r1 First rotation amount
+ * @param r2 Second rotation amount
+ * @return Mixed vector
+ */
+static inline vx256_t vx256_arx_mix(vx256_t v, vx256_t salt, vx256_t rc, int r1, int r2) {
+    v = vx256_add(v, salt);
+    v = vx256_xor(v, rc);
+    v = vx256_add(v, vx256_rotl(v, r1));
+    v = vx256_xor(v, vx256_rotr(v, r2));
+    v = vx256_mix_lanes(v);
+    return vx256_mul_const(v, 0x800000000000808AULL);
+}
+
+/* ================= horizontal_xor ================= */
+
+/**
+ * Reduce a 256-bit vector to a single 64-bit value
+ * Same reduction and final diffusion as horizontal_xor_vector()
+ *
+ * @param v Input vector
+ * @return 64-bit hash value derived from all lanes
+ */
+static inline uint64_t vx256_horizontal_xor(vx256_t v) {
+    v = vx256_mix_lanes(v);
+    v = vx256_xor(v, VX256_PERMUTE(v, 0x4E));
+    v = vx256_xor(v, VX256_PERMUTE(v, 0x4E));
+    v = vx256_xor(v, VX256_PERMUTE(v, 0xB1));
+
+    vx128_t folded = v.lo ^ v.hi;
+    uint64_t result = folded[0] ^ folded[1];
+
+    result ^= result >> 31;
+    result *= 0x0000000000000088ULL;
+    result ^= result >> 29;
+    result *= 0x8000000000008089ULL;
+    result ^= result >> 32;
+    result = rotr64(result, 17) ^ rotl64(result, 43);
+    result *= 0x8000000080008081ULL;
+    result ^= result >> 27;
+
+    return result;
+}
+
+/* ================= EXECUTION ================= */
+
+/**
+ * Main vector-extension execution function
+ * Processes blocks in groups of 4, lane i of each vector holding block i
+ *
+ * @param input Array of input blocks (each block is 10 64-bit words)
+ * @param salt_scalar Salt value for this processing round
+ * @param round_base Base round number for constant selection
+ * @param num_blocks Total number of blocks to process
+ */
+static inline void little_box_execute_simd_vecext(uint64_t* input,
+                                                  uint64_t salt_scalar,
+                                                  uint64_t round_base,
+                                                  size_t num_blocks) {
+    /* Create vector with salt replicated in all lanes */
+    vx256_t salt = vx256_set1(salt_scalar);
+
+    /* Round constant vectors are the same for every group */
+    vx256_t rc0 = vx256_set(
+        ROUND_CONSTANTS[(round_base + 0) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 1) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 2) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 3) & (ROUND_CONSTANTS_SIZE - 1)]);
+
+    vx256_t rc1 = vx256_set(
+        ROUND_CONSTANTS[(round_base + 4) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 5) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 6) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 7) & (ROUND_CONSTANTS_SIZE - 1)]);
+
+    vx256_t rc2 = vx256_set(
+        ROUND_CONSTANTS[(round_base + 8) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 9) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 10) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 11) & (ROUND_CONSTANTS_SIZE - 1)]);
+
+/* OpenMP parallel for loop (if enabled) */
+#pragma omp for schedule(static)
+    for (size_t blk = 0; blk < num_blocks; blk += 4) {
+        /* Pointers to up to 4 blocks */
+        uint64_t* in[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; i++)
+            if (blk + i < num_blocks)
+                in[i] = &input[(blk + i) * 10];
+
+        /* Load vectors from block data */
+        vx256_t v0 = vx256_set(in[0] ? in[0][1] : 0, in[1] ? in[1][1] : 0, in[2] ? in[2][1] : 0, in[3] ? in[3][1] : 0);
+        vx256_t v0l = vx256_set(in[0] ? in[0][0] : 0, in[1] ? in[1][0] : 0, in[2] ? in[2][0] : 0, in[3] ? in[3][0] : 0);
+        vx256_t v1 = vx256_set(in[0] ? in[0][5] : 0, in[1] ? in[1][5] : 0, in[2] ? in[2][5] : 0, in[3] ? in[3][5] : 0);
+        vx256_t v1l = vx256_set(in[0] ? in[0][4] : 0, in[1] ? in[1][4] : 0, in[2] ? in[2][4] : 0, in[3] ? in[3][4] : 0);
+        vx256_t v2 = vx256_set(in[0] ? in[0][9] : 0, in[1] ? in[1][9] : 0, in[2] ? in[2][9] : 0, in[3] ? in[3][9] : 0);
+        vx256_t v2l = vx256_set(in[0] ? in[0][8] : 0, in[1] ? in[1][8] : 0, in[2] ? in[2][8] : 0, in[3] ? in[3][8] : 0);
+
+        /* Apply ARX mixing */
+        v0 = vx256_arx_mix(v0, salt, rc0, 7, 13);
+        v0l = vx256_arx_mix(v0l, salt, rc0, 7, 13);
+        v1 = vx256_arx_mix(v1, salt, rc1, 11, 17);
+        v1l = vx256_arx_mix(v1l, salt, rc1, 11, 17);
+        v2 = vx256_arx_mix(v2, salt, rc2, 19, 23);
+        v2l = vx256_arx_mix(v2l, salt, rc2, 19, 23);
+
+        /* Mix lanes */
+        v0 = vx256_mix_lanes(v0);
+        v0l = vx256_mix_lanes(v0l);
+        v1 = vx256_mix_lanes(v1);
+        v1l = vx256_mix_lanes(v1l);
+        v2 = vx256_mix_lanes(v2);
+        v2l = vx256_mix_lanes(v2l);
+
+        /* Store results back to block 0 */
+        if (in[0]) {
+            vx256_t acc0 = vx256_xor(
+                vx256_xor(VX256_PERMUTE(v0, 0x00), VX256_PERMUTE(v1, 0x00)),
+                VX256_PERMUTE(v2, 0x00));
+            in[0][0] = v0.lo[0];
+            in[0][1] = v0.lo[1];
+            in[0][4] = v1.lo[0];
+            in[0][5] = v1.lo[1];
+            in[0][8] = v2.lo[0];
+            in[0][9] = vx256_horizontal_xor(acc0);
+        }
+
+        /* Store results back to block 1 */
+        if (in[1]) {
+            vx256_t acc1 = vx256_xor(
+                vx256_xor(VX256_PERMUTE(v0, 0x55), VX256_PERMUTE(v1, 0x55)),
+                VX256_PERMUTE(v2, 0x55));
+            in[1][0] = v0.hi[0];
+            in[1][1] = v0.hi[1];
+            in[1][4] = v1.hi[0];
+            in[1][5] = v1.hi[1];
+            in[1][8] = v2.hi[0];
+            in[1][9] = vx256_horizontal_xor(acc1);
+        }
+
+        /* Store results back to block 2 */
+        if (in[2]) {
+            vx256_t acc2 = vx256_xor(
+                vx256_xor(VX256_PERMUTE(v0l, 0xAA), VX256_PERMUTE(v1l, 0xAA)),
+                VX256_PERMUTE(v2l, 0xAA));
+            in[2][0] = v0l.lo[0];
+            in[2][1] = v0l.lo[1];
+            in[2][4] = v1l.lo[0];
+            in[2][5] = v1l.lo[1];
+            in[2][8] = v2l.lo[0];
+            in[2][9] = vx256_horizontal_xor(acc2);
+        }
+
+        /* Store results back to block 3 */
+        if (in[3]) {
+            vx256_t acc3 = vx256_xor(
+                vx256_xor(VX256_PERMUTE(v0l, 0xFF), VX256_PERMUTE(v1l, 0xFF)),
+                VX256_PERMUTE(v2l, 0xFF));
+            in[3][0] = v0l.hi[0];
+            in[3][1] = v0l.hi[1];
+            in[3][4] = v1l.hi[0];
+            in[3][5] = v1l.hi[1];
+            in[3][8] = v2l.hi[0];
+            in[3][9] = vx256_horizontal_xor(acc3);
+        }
+
+        /* Cross-block mixing for full groups of 4 */
+        if (blk + 3 < num_blocks) {
+            uint64_t* b0 = &input[(blk + 0) * 10];
+            uint64_t* b1 = &input[(blk + 1) * 10];
+            uint64_t* b2 = &input[(blk + 2) * 10];
+            uint64_t* b3 = &input[(blk + 3) * 10];
+
+            uint64_t mix = b0[9] ^ b1[9] ^ b2[9] ^ b3[9];
+            mix = rotr64(mix, 17) ^ rotl64(mix, 43);
+            mix *= 0x9E3779B97F4A7C15ULL;
+
+            b0[9] ^= mix;
+            b1[9] ^= rotr64(mix, 11);
+            b2[9] ^= rotl64(mix, 23);
+            b3[9] ^= mix ^ (mix >> 31);
+        }
+    }
+}
+
+#endif /* XZALGOCHAIN_ALGORITHM_SIMD_VECEXT_H */
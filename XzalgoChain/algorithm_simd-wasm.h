@@ -0,0 +1,418 @@
+/*
+ * XzalgoChain - 320-bit Cryptographic Hash Function
+ * Copyright 2026 Xzrayツ
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XZALGOCHAIN_ALGORITHM_SIMD_WASM_H
+#define XZALGOCHAIN_ALGORITHM_SIMD_WASM_H
+
+/* This file is meant to be included only from algorithm_simd.h
+ * when compiling for WebAssembly with -msimd128.
+ */
+
+#include "config.h"
+#include "algorithm.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <wasm_simd128.h> /* WebAssembly SIMD128 intrinsics header */
+
+/* ==================== WASM SIMD128 IMPLEMENTATION ==================== */
+/**
+ * WebAssembly SIMD128 implementation for browsers and edge runtimes
+ * SIMD128 uses 128-bit registers, so we combine two registers
+ * (lo and hi) to simulate 256-bit operations, as the NEON backend does.
+ * A module built with -msimd128 only validates on engines with SIMD
+ * support, so runtime selection happens in the JS loader, not here.
+ */
+
+#define XZALGOCHAIN_HAVE_WASM_SIMD 1
+
+/* ================= 256-bit wrapper ================= */
+/**
+ * 256-bit type for WASM SIMD using two v128_t registers
+ * lo: lower 128 bits (lanes 0-1)
+ * hi: upper 128 bits (lanes 2-3)
+ */
+typedef struct {
+    v128_t lo; /* Lower 128 bits: lanes 0,1 */
+    v128_t hi; /* Upper 128 bits: lanes 2,3 */
+} wasm256_t;
+
+/* ================= constructors ================= */
+
+/**
+ * Create a 256-bit WASM vector from four 64-bit values
+ * @param x3 Value for lane 3 (highest)
+ * @param x2 Value for lane 2
+ * @param x1 Value for lane 1
+ * @param x0 Value for lane 0 (lowest)
+ * @return 256-bit WASM vector
+ */
+static inline wasm256_t w256_set_epi64x(uint64_t x3, uint64_t x2, uint64_t x1, uint64_t x0) {
+    wasm256_t r;
+    r.lo = wasm_u64x2_make(x0, x1);
+    r.hi = wasm_u64x2_make(x2, x3);
+    return r;
+}
+
+/**
+ * Create a 256-bit WASM vector with all lanes set to the same value
+ * @param x Value to replicate across all 4 lanes
+ * @return 256-bit WASM vector with all lanes = x
+ */
+static inline wasm256_t w256_set1(uint64_t x) {
+    wasm256_t r;
+    r.lo = wasm_u64x2_splat(x);
+    r.hi = r.lo;
+    return r;
+}
+
+/* ================= basic ops ================= */
+
+/**
+ * XOR two 256-bit WASM vectors lane-wise
+ * @param a First vector
+ * @param b Second vector
+ * @return Vector where each lane = a.lane[i] ^ b.lane[i]
+ */
+static inline wasm256_t w256_xor(wasm256_t a, wasm256_t b) {
+    wasm256_t r;
+    r.lo = wasm_v128_xor(a.lo, b.lo);
+    r.hi = wasm_v128_xor(a.hi, b.hi);
+    return r;
+}
+
+/**
+ * Add two 256-bit WASM vectors lane-wise
+ * @param a First vector
+ * @param b Second vector
+ * @return Vector where each lane = a.lane[i] + b.lane[i]
+ */
+static inline wasm256_t w256_add(wasm256_t a, wasm256_t b) {
+    wasm256_t r;
+    r.lo = wasm_i64x2_add(a.lo, b.lo);
+    r.hi = wasm_i64x2_add(a.hi, b.hi);
+    return r;
+}
+
+/* ================= WASM 64-bit rotations ================= */
+
+/**
+ * Left rotate each lane in a v128_t
+ * @param v 128-bit vector with two 64-bit lanes
+ * @param r Rotation amount in bits (1-63)
+ * @return Vector with each lane rotated left by r bits
+ */
+static inline v128_t wasm_rotl64(v128_t v, int r) {
+    return wasm_v128_or(wasm_i64x2_shl(v, (uint32_t) r), wasm_u64x2_shr(v, (uint32_t) (64 - r)));
+}
+
+/**
+ * Right rotate each lane in a v128_t
+ * @param v 128-bit vector with two 64-bit lanes
+ * @param r Rotation amount in bits (1-63)
+ * @return Vector with each lane rotated right by r bits
+ */
+static inline v128_t wasm_rotr64(v128_t v, int r) {
+    return wasm_v128_or(wasm_u64x2_shr(v, (uint32_t) r), wasm_i64x2_shl(v, (uint32_t) (64 - r)));
+}
+
+/* ================= WASM 256-bit rotations ================= */
+
+/**
+ * Left rotate each lane in a 256-bit WASM vector
+ * @param v Input 256-bit vector
+ * @param r Rotation amount in bits
+ * @return Vector with each lane rotated left by r bits
+ */
+static inline wasm256_t w256_rotl(wasm256_t v, int r) {
+    wasm256_t result;
+    result.lo = wasm_rotl64(v.lo, r);
+    result.hi = wasm_rotl64(v.hi, r);
+    return result;
+}
+
+/**
+ * Right rotate each lane in a 256-bit WASM vector
+ * @param v Input 256-bit vector
+ * @param r Rotation amount in bits
+ * @return Vector with each lane rotated right by r bits
+ */
+static inline wasm256_t w256_rotr(wasm256_t v, int r) {
+    wasm256_t result;
+    result.lo = wasm_rotr64(v.lo, r);
+    result.hi = wasm_rotr64(v.hi, r);
+    return result;
+}
+
+/* ================= permute clone ================= */
+
+/**
+ * Permute lanes of a 256-bit WASM vector according to immediate value
+ * Same encoding as AVX2's _mm256_permute4x64_epi64. Each output half is
+ * one i64x2.shuffle over the lo:hi concatenation (lane indices 0-3);
+ * imm must be a compile-time constant.
+ *
+ * @param v Input vector
+ * @param imm Permutation pattern (8-bit constant, each 2 bits select a lane)
+ * @return Vector with lanes permuted as specified
+ */
+#define W256_PERMUTE(v, imm)                                                              \
+    ((wasm256_t){wasm_i64x2_shuffle((v).lo, (v).hi, ((imm) >> 0) & 3, ((imm) >> 2) & 3), \
+                 wasm_i64x2_shuffle((v).lo, (v).hi, ((imm) >> 4) & 3, ((imm) >> 6) & 3)})
+
+/* ================= mix_lanes ================= */
+
+/**
+ * Mix lanes within a 256-bit WASM vector for cross-lane diffusion
+ * WASM equivalent of AVX2's mix_lanes function
+ *
+ * @param v Input vector
+ * @return Mixed vector
+ */
+static inline wasm256_t w256_mix_lanes(wasm256_t v) {
+    /* Permute: (1,0,3,2) - swap adjacent lane pairs */
+    wasm256_t p0 = W256_PERMUTE(v, 0x4E);
+
+    /* Further permute: (2,3,0,1) - swap the pairs */
+    wasm256_t p1 = W256_PERMUTE(p0, 0xB1);
+
+    /* XOR the two permuted versions */
+    wasm256_t x = w256_xor(p0, p1);
+
+    /* Rotate left by 17 bits and XOR with original */
+    return w256_xor(x, w256_rotl(x, 17));
+}
+
+/* ================= mullo64 ================= */
+
+/**
+ * Multiply each lane of a 256-bit WASM vector by a constant
+ * SIMD128 has a native i64x2.mul, so no 32-bit decomposition is needed
+ *
+ * @param v Input vector
+ * @param c Constant multiplier
+ * @return Vector with each lane multiplied by c
+ */
+static inline wasm256_t w256_mul64(wasm256_t v, uint64_t c) {
+    v128_t cv = wasm_u64x2_splat(c);
+
+    wasm256_t r;
+    r.lo = wasm_i64x2_mul(v.lo, cv);
+    r.hi = wasm_i64x2_mul(v.hi, cv);
+    return r;
+}
+
+/* ================= arx_mix ================= */
+
+/**
+ * ARX (Add-Rotate-XOR) mixing function for WASM vectors
+ * WASM equivalent of AVX2's arx_mix function
+ *
+ * @param v Input vector to mix
+ * @param salt Salt vector
+ * @param rc Round constant vector
+ * @param r1 First rotation amount
+ * @param r2 Second rotation amount
+ * @return Mixed vector
+ */
+static inline wasm256_t w256_arx_mix(
+    wasm256_t v,
+    wasm256_t salt,
+    wasm256_t rc,
+    int r1,
+    int r2) {
+    v = w256_add(v, salt);
+    v = w256_xor(v, rc);
+    v = w256_add(v, w256_rotl(v, r1));
+    v = w256_xor(v, w256_rotr(v, r2));
+    v = w256_mix_lanes(v);
+    return w256_mul64(v, 0x800000000000808AULL);
+}
+
+/* ================= horizontal_xor ================= */
+
+/**
+ * Reduce a 256-bit WASM vector to a single 64-bit value
+ * WASM equivalent of AVX2's horizontal_xor256 function
+ *
+ * @param v Input vector
+ * @return 64-bit hash value derived from all lanes
+ */
+static inline uint64_t w256_horizontal_xor(wasm256_t v) {
+    /* Lane mixing and permutations (same pattern as scalar) */
+    v = w256_mix_lanes(v);
+    v = w256_xor(v, W256_PERMUTE(v, 0x4E));
+    v = w256_xor(v, W256_PERMUTE(v, 0x4E));
+    v = w256_xor(v, W256_PERMUTE(v, 0xB1));
+
+    /* Fold the two halves, then the two lanes */
+    v128_t x = wasm_v128_xor(v.lo, v.hi);
+    uint64_t result = wasm_u64x2_extract_lane(x, 0) ^ wasm_u64x2_extract_lane(x, 1);
+
+    /* Final diffusion sequence (same as scalar) */
+    result ^= result >> 31;
+    result *= 0x0000000000000088ULL;
+    result ^= result >> 29;
+    result *= 0x8000000000008089ULL;
+    result ^= result >> 32;
+    result = rotr64(result, 17) ^ rotl64(result, 43);
+    result *= 0x8000000080008081ULL;
+    result ^= result >> 27;
+
+    return result;
+}
+
+/* ================= EXECUTION ================= */
+
+/**
+ * Main WASM SIMD128 execution function
+ * Processes blocks in groups of 4 using SIMD128 instructions
+ *
+ * @param input Array of input blocks (each block is 10 64-bit words)
+ * @param salt_scalar Salt value for this processing round
+ * @param round_base Base round number for constant selection
+ * @param num_blocks Total number of blocks to process
+ */
+static inline void little_box_execute_simd_wasm(
+    uint64_t* input,
+    uint64_t salt_scalar,
+    uint64_t round_base,
+    size_t num_blocks) {
+    /* Create vector with salt replicated in all lanes */
+    wasm256_t salt = w256_set1(salt_scalar);
+
+    /* Load round constant vectors */
+    wasm256_t rc0 = w256_set_epi64x(
+        ROUND_CONSTANTS[(round_base + 3) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 2) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 1) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 0) & (ROUND_CONSTANTS_SIZE - 1)]);
+
+    wasm256_t rc1 = w256_set_epi64x(
+        ROUND_CONSTANTS[(round_base + 7) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 6) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 5) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 4) & (ROUND_CONSTANTS_SIZE - 1)]);
+
+    wasm256_t rc2 = w256_set_epi64x(
+        ROUND_CONSTANTS[(round_base + 11) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 10) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 9) & (ROUND_CONSTANTS_SIZE - 1)],
+        ROUND_CONSTANTS[(round_base + 8) & (ROUND_CONSTANTS_SIZE - 1)]);
+
+    for (size_t blk = 0; blk < num_blocks; blk += 4) {
+        /* Pointers to up to 4 blocks */
+        uint64_t* in[4] = {0, 0, 0, 0};
+        for (int i = 0; i < 4; i++)
+            if (blk + i < num_blocks)
+                in[i] = &input[(blk + i) * 10];
+
+        /* Load vectors from block data */
+        wasm256_t v0 = w256_set_epi64x(in[3] ? in[3][1] : 0, in[2] ? in[2][1] : 0, in[1] ? in[1][1] : 0, in[0] ? in[0][1] : 0);
+        wasm256_t v0l = w256_set_epi64x(in[3] ? in[3][0] : 0, in[2] ? in[2][0] : 0, in[1] ? in[1][0] : 0, in[0] ? in[0][0] : 0);
+        wasm256_t v1 = w256_set_epi64x(in[3] ? in[3][5] : 0, in[2] ? in[2][5] : 0, in[1] ? in[1][5] : 0, in[0] ? in[0][5] : 0);
+        wasm256_t v1l = w256_set_epi64x(in[3] ? in[3][4] : 0, in[2] ? in[2][4] : 0, in[1] ? in[1][4] : 0, in[0] ? in[0][4] : 0);
+        wasm256_t v2 = w256_set_epi64x(in[3] ? in[3][9] : 0, in[2] ? in[2][9] : 0, in[1] ? in[1][9] : 0, in[0] ? in[0][9] : 0);
+        wasm256_t v2l = w256_set_epi64x(in[3] ? in[3][8] : 0, in[2] ? in[2][8] : 0, in[1] ? in[1][8] : 0, in[0] ? in[0][8] : 0);
+
+        /* Apply ARX mixing */
+        v0 = w256_arx_mix(v0, salt, rc0, 7, 13);
+        v0l = w256_arx_mix(v0l, salt, rc0, 7, 13);
+        v1 = w256_arx_mix(v1, salt, rc1, 11, 17);
+        v1l = w256_arx_mix(v1l, salt, rc1, 11, 17);
+        v2 = w256_arx_mix(v2, salt, rc2, 19, 23);
+        v2l = w256_arx_mix(v2l, salt, rc2, 19, 23);
+
+        /* Mix lanes */
+        v0 = w256_mix_lanes(v0);
+        v0l = w256_mix_lanes(v0l);
+        v1 = w256_mix_lanes(v1);
+        v1l = w256_mix_lanes(v1l);
+        v2 = w256_mix_lanes(v2);
+        v2l = w256_mix_lanes(v2l);
+
+        /* Store results back to block 0 */
+        if (in[0]) {
+            wasm256_t acc0 = w256_xor(
+                w256_xor(W256_PERMUTE(v0, 0x00), W256_PERMUTE(v1, 0x00)),
+                W256_PERMUTE(v2, 0x00));
+            in[0][0] = wasm_u64x2_extract_lane(v0.lo, 0);
+            in[0][1] = wasm_u64x2_extract_lane(v0.lo, 1);
+            in[0][4] = wasm_u64x2_extract_lane(v1.lo, 0);
+            in[0][5] = wasm_u64x2_extract_lane(v1.lo, 1);
+            in[0][8] = wasm_u64x2_extract_lane(v2.lo, 0);
+            in[0][9] = w256_horizontal_xor(acc0);
+        }
+
+        /* Store results back to block 1 */
+        if (in[1]) {
+            wasm256_t acc1 = w256_xor(
+                w256_xor(W256_PERMUTE(v0, 0x55), W256_PERMUTE(v1, 0x55)),
+                W256_PERMUTE(v2, 0x55));
+            in[1][0] = wasm_u64x2_extract_lane(v0.hi, 0);
+            in[1][1] = wasm_u64x2_extract_lane(v0.hi, 1);
+            in[1][4] = wasm_u64x2_extract_lane(v1.hi, 0);
+            in[1][5] = wasm_u64x2_extract_lane(v1.hi, 1);
+            in[1][8] = wasm_u64x2_extract_lane(v2.hi, 0);
+            in[1][9] = w256_horizontal_xor(acc1);
+        }
+
+        /* Store results back to block 2 */
+        if (in[2]) {
+            wasm256_t acc2 = w256_xor(
+                w256_xor(W256_PERMUTE(v0l, 0xAA), W256_PERMUTE(v1l, 0xAA)),
+                W256_PERMUTE(v2l, 0xAA));
+            in[2][0] = wasm_u64x2_extract_lane(v0l.lo, 0);
+            in[2][1] = wasm_u64x2_extract_lane(v0l.lo, 1);
+            in[2][4] = wasm_u64x2_extract_lane(v1l.lo, 0);
+            in[2][5] = wasm_u64x2_extract_lane(v1l.lo, 1);
+            in[2][8] = wasm_u64x2_extract_lane(v2l.lo, 0);
+            in[2][9] = w256_horizontal_xor(acc2);
+        }
+
+        /* Store results back to block 3 */
+        if (in[3]) {
+            wasm256_t acc3 = w256_xor(
+                w256_xor(W256_PERMUTE(v0l, 0xFF), W256_PERMUTE(v1l, 0xFF)),
+                W256_PERMUTE(v2l, 0xFF));
+            in[3][0] = wasm_u64x2_extract_lane(v0l.hi, 0);
+            in[3][1] = wasm_u64x2_extract_lane(v0l.hi, 1);
+            in[3][4] = wasm_u64x2_extract_lane(v1l.hi, 0);
+            in[3][5] = wasm_u64x2_extract_lane(v1l.hi, 1);
+            in[3][8] = wasm_u64x2_extract_lane(v2l.hi, 0);
+            in[3][9] = w256_horizontal_xor(acc3);
+        }
+
+        /* Cross-block mixing for full groups of 4 */
+        if (blk + 3 < num_blocks) {
+            uint64_t* b0 = &input[(blk + 0) * 10];
+            uint64_t* b1 = &input[(blk + 1) * 10];
+            uint64_t* b2 = &input[(blk + 2) * 10];
+            uint64_t* b3 = &input[(blk + 3) * 10];
+
+            uint64_t mix = b0[9] ^ b1[9] ^ b2[9] ^ b3[9];
+            mix = rotr64(mix, 17) ^ rotl64(mix, 43);
+            mix *= 0x9E3779B97F4A7C15ULL;
+
+            b0[9] ^= mix;
+            b1[9] ^= rotr64(mix, 11);
+            b2[9] ^= rotl64(mix, 23);
+            b3[9] ^= mix ^ (mix >> 31);
+        }
+    }
+}
+
+#endif /* XZALGOCHAIN_ALGORITHM_SIMD_WASM_H */
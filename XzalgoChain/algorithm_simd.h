@@ -48,6 +48,19 @@ static inline int xzalgochain_is_forced_scalar(void);
     #include "algorithm_simd-avx2.h"
 #endif
 
+/**
+ * Include SSE2 implementation for x86/x64 platforms
+ * Used on x86 hosts without AVX2 (older Atom/Celeron, AVX-masked VMs)
+ * Skipped when SIMD is disabled at build time: every x86-64 compiler
+ * defines __SSE2__, so such builds would otherwise not be scalar
+ */
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) &&  \
+    !(defined(XZALGOCHAIN_ENABLE_SIMD) && XZALGOCHAIN_ENABLE_SIMD == 0) &&                \
+    !(defined(XZALGOCHAIN_FORCE_SCALAR) && XZALGOCHAIN_FORCE_SCALAR)
+    #include "algorithm_simd-sse.h"
+#endif
+
 /**
  * Include NEON implementation for ARM platforms
  */
@@ -57,6 +70,25 @@ static inline int xzalgochain_is_forced_scalar(void);
     #include "algorithm_simd-neon.h"
 #endif
 
+/**
+ * Include WebAssembly SIMD128 implementation for -msimd128 builds
+ * Skipped when SIMD is disabled at build time (the baseline WASM flavor)
+ */
+#if defined(__wasm_simd128__) && \
+    !(defined(XZALGOCHAIN_ENABLE_SIMD) && XZALGOCHAIN_ENABLE_SIMD == 0)
+    #include "algorithm_simd-wasm.h"
+#endif
+
+/**
+ * Include portable vector-extension implementation (GCC/Clang)
+ * Skipped when SIMD is disabled at build time so such builds stay scalar
+ */
+#if (defined(__GNUC__) || defined(__clang__)) &&                            \
+    !(defined(XZALGOCHAIN_ENABLE_SIMD) && XZALGOCHAIN_ENABLE_SIMD == 0) && \
+    !(defined(XZALGOCHAIN_FORCE_SCALAR) && XZALGOCHAIN_FORCE_SCALAR)
+    #include "algorithm_simd-vecext.h"
+#endif
+
 /* ==================== WRAPPER ==================== */
 
 /**
@@ -76,10 +108,9 @@ static inline void little_box_execute_simd(uint64_t* input,
     /* If scalar mode is forced, use scalar implementation */
     if (xzalgochain_is_forced_scalar()) {
         for (size_t i = 0; i < num_blocks; i++) {
-            little_box_execute_scalar(&input[i * 10],
-                                      salt_scalar,
-                                      round_base,
-                                      1);
+            little_box_execute_scalar_single(&input[i * 10],
+                                             salt_scalar,
+                                             round_base);
         }
         return;
     }
@@ -88,17 +119,25 @@ static inline void little_box_execute_simd(uint64_t* input,
 #if defined(XZALGOCHAIN_HAVE_AVX2)
     /* AVX2 available on x86/x64 */
     little_box_execute_simd_avx2(input, salt_scalar, round_base, num_blocks);
+#elif defined(XZALGOCHAIN_HAVE_SSE2)
+    /* SSE2 available on x86/x64 */
+    little_box_execute_simd_sse2(input, salt_scalar, round_base, num_blocks);
 #elif defined(XZALGOCHAIN_HAVE_NEON)
     /* NEON available on ARM */
     little_box_execute_simd_neon(input, salt_scalar, round_base, num_blocks);
+#elif defined(XZALGOCHAIN_HAVE_WASM_SIMD)
+    /* SIMD128 available in WebAssembly */
+    little_box_execute_simd_wasm(input, salt_scalar, round_base, num_blocks);
+#elif defined(XZALGOCHAIN_HAVE_VECEXT)
+    /* Compiler-generated SIMD for any other target */
+    little_box_execute_simd_vecext(input, salt_scalar, round_base, num_blocks);
 #else
     /* No SIMD available - use scalar with optional OpenMP parallelization */
     #pragma omp for
     for (size_t i = 0; i < num_blocks; i++) {
-        little_box_execute_scalar(&input[i * 10],
-                                  salt_scalar,
-                                  round_base,
-                                  1);
+        little_box_execute_scalar_single(&input[i * 10],
+                                         salt_scalar,
+                                         round_base);
     }
 #endif
 }
@@ -98,6 +98,122 @@
 #define SIMD_NEON 2
 #define BIT_NEON (1 << 6) /* Bit flag for NEON capability detection */
 
+/**
+ * SIMD_VECEXT: Portable GCC/Clang vector-extension implementation
+ * Compiler-generated SIMD for whatever the target ISA offers
+ */
+#define SIMD_VECEXT 3
+
+/**
+ * SIMD_SSE2: SSE2 on x86/x64 (baseline for every x86-64 CPU)
+ * Processes 4 64-bit values as two 128-bit register pairs
+ */
+#define SIMD_SSE2 4
+#define BIT_SSE2 (1 << 26) /* Bit flag for SSE2 capability detection (CPUID.1:EDX) */
+
+/**
+ * SIMD_WASM: WebAssembly SIMD128 (builds compiled with -msimd128)
+ * Processes 4 64-bit values as two v128_t register pairs
+ */
+#define SIMD_WASM 5
+
+/* ==================== BACKEND POLICY CONSTANTS ==================== */
+
+/**
+ * Backend policy identifiers for xzalgochain_init_ex()
+ * A policy is chosen per context at init time, so different contexts
+ * (and different threads) can run different backends side by side
+ */
+
+/**
+ * XZ_BACKEND_AUTO: Best available backend for this CPU
+ * Honors the process-wide xzalgochain_force_scalar() default
+ * Value 0 so that a zeroed context resolves to automatic selection
+ */
+#define XZ_BACKEND_AUTO 0
+
+/**
+ * XZ_BACKEND_SCALAR: Portable scalar implementation, always available
+ */
+#define XZ_BACKEND_SCALAR 1
+
+/**
+ * XZ_BACKEND_AVX2: AVX2 implementation (x86/x64, compiled with AVX2)
+ */
+#define XZ_BACKEND_AVX2 2
+
+/**
+ * XZ_BACKEND_NEON: NEON implementation (ARM, compiled with NEON)
+ */
+#define XZ_BACKEND_NEON 3
+
+/**
+ * XZ_BACKEND_VECEXT: Portable vector-extension implementation
+ * (GCC/Clang, unless SIMD is disabled at build time)
+ */
+#define XZ_BACKEND_VECEXT 4
+
+/**
+ * XZ_BACKEND_SSE2: SSE2 implementation (x86/x64, compiled with SSE2)
+ */
+#define XZ_BACKEND_SSE2 5
+
+/**
+ * XZ_BACKEND_WASM: WebAssembly SIMD128 implementation (compiled with -msimd128)
+ */
+#define XZ_BACKEND_WASM 6
+
+/**
+ * XZ_BACKEND_COUNT: One past the highest backend policy identifier
+ * Explicit backends are XZ_BACKEND_SCALAR .. XZ_BACKEND_COUNT - 1
+ */
+#define XZ_BACKEND_COUNT 7
+
+/* ==================== FILE HASHING FLAGS ==================== */
+
+/**
+ * Flags for xzalgochain_file(), xzalgochain_fd() and xzalgochain_update_fd()
+ * XZ_FILE_DEFAULT: mmap large regular files, read() everything else
+ */
+#define XZ_FILE_DEFAULT 0
+
+/**
+ * XZ_FILE_NO_MMAP: Always use read(), e.g. for files that may be truncated
+ * while they are hashed
+ */
+#define XZ_FILE_NO_MMAP (1 << 0)
+
+/**
+ * XZ_FILE_HUGEPAGES: Ask for transparent huge pages on mapped files
+ * (MADV_HUGEPAGE; effective on tmpfs and filesystems with large folios)
+ */
+#define XZ_FILE_HUGEPAGES (1 << 1)
+
+/**
+ * XZ_FILE_NO_SPARSE: Read holes in sparse files instead of skipping them
+ * (digests are the same either way)
+ */
+#define XZ_FILE_NO_SPARSE (1 << 2)
+
+/* ==================== ASYNC READ PIPELINE FLAGS ==================== */
+
+/**
+ * Flags for xzalgochain_update_fd_aio() and xzalgochain_file_aio()
+ * XZ_AIO_DEFAULT: io_uring where the kernel allows it, a reader thread otherwise
+ */
+#define XZ_AIO_DEFAULT 0
+
+/**
+ * XZ_AIO_DIRECT: Read regular files with O_DIRECT, bypassing the page cache
+ * (ignored where the filesystem refuses it, e.g. tmpfs)
+ */
+#define XZ_AIO_DIRECT (1 << 0)
+
+/**
+ * XZ_AIO_NO_URING: Always use the reader thread
+ */
+#define XZ_AIO_NO_URING (1 << 1)
+
 /* ==================== COMPILER ATTRIBUTES ==================== */
 
 /* Detect GCC or Clang for function attributes */
@@ -109,6 +225,17 @@
     #define XZALGOCHAIN_ATTR_PURE
 #endif
 
+/* Global state shared by every translation unit that includes the header:
+ * a weak (GCC/Clang) or selectany (MSVC) definition leaves one object per
+ * program; other compilers fall back to one object per translation unit */
+#if defined(__GNUC__) || defined(__clang__)
+    #define XZALGOCHAIN_SELECTANY __attribute__((weak))
+#elif defined(_MSC_VER)
+    #define XZALGOCHAIN_SELECTANY __declspec(selectany)
+#else
+    #define XZALGOCHAIN_SELECTANY static
+#endif
+
 /* ==================== ROUND CONSTANTS ==================== */
 
 /**
@@ -212,6 +212,29 @@ static inline int _detect_avx2_x86(void) {
 #endif
 }
 
+/**
+ * Internal function to detect SSE2 support on x86/x64 platforms
+ * SSE2 is part of the x86-64 baseline; 32-bit x86 queries CPUID leaf 1
+ *
+ * @return 1 if SSE2 is supported, 0 otherwise
+ */
+static inline int _detect_sse2_x86(void) {
+#if defined(__x86_64__) || defined(_M_X64)
+    return 1;
+#elif defined(__i386__) && (defined(__GNUC__) || defined(__clang__))
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return 0;
+    return (edx & BIT_SSE2) ? 1 : 0;
+#elif defined(_M_IX86) && defined(_MSC_VER)
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 1);
+    return (cpuInfo[3] & BIT_SSE2) ? 1 : 0;
+#else
+    return 0;
+#endif
+}
+
 /**
  * Internal function to detect NEON support on ARM platforms
  * Uses different detection methods per operating system:
@@ -276,6 +299,18 @@ static inline int xzalgochain_avx2_supported(void) {
     return _detect_avx2_x86();
 }
 
+/**
+ * Public API to check if SSE2 is supported on current platform
+ * First verifies we're on x86, then calls internal detection
+ *
+ * @return 1 if SSE2 is available, 0 otherwise
+ */
+static inline int xzalgochain_sse2_supported(void) {
+    if (!xzalgochain_is_x86())
+        return 0;
+    return _detect_sse2_x86();
+}
+
 /**
  * Public API to check if NEON is supported on current platform
  * First verifies we're on ARM, then calls internal detection
@@ -290,25 +325,34 @@ static inline int xzalgochain_neon_supported(void) {
 
 /**
  * Get the type of SIMD available on current platform
- * Checks for AVX2 first (x86), then NEON (ARM), falls back to SIMD_NONE
+ * Checks for AVX2 first, then SSE2 (x86), then NEON (ARM),
+ * falls back to SIMD_NONE. WebAssembly has no runtime query: a module
+ * compiled with -msimd128 only instantiates where SIMD128 exists
  *
- * @return SIMD type constant: SIMD_AVX2, SIMD_NEON, or SIMD_NONE
+ * @return SIMD type constant: SIMD_AVX2, SIMD_SSE2, SIMD_NEON, SIMD_WASM, or SIMD_NONE
  */
 static inline int xzalgochain_get_simd_type(void) {
+#if defined(__wasm_simd128__)
+    return SIMD_WASM;
+#else
     if (xzalgochain_is_x86() && _detect_avx2_x86())
         return SIMD_AVX2;
 
+    if (xzalgochain_is_x86() && _detect_sse2_x86())
+        return SIMD_SSE2;
+
     if (xzalgochain_is_arm() && _detect_neon_arm())
         return SIMD_NEON;
 
     return SIMD_NONE;
+#endif
 }
 
 /**
  * Get human-readable name of the available SIMD type
  * Useful for logging and version information
  *
- * @return String constant: "AVX2", "NEON", or "None"
+ * @return String constant: "AVX2", "SSE2", "NEON", "WASM SIMD128", or "None"
  */
 static inline const char* xzalgochain_get_simd_name(void) {
     int simd_type = xzalgochain_get_simd_type();
@@ -316,8 +360,12 @@ static inline const char* xzalgochain_get_simd_name(void) {
     switch (simd_type) {
         case SIMD_AVX2:
             return "AVX2";
+        case SIMD_SSE2:
+            return "SSE2";
         case SIMD_NEON:
             return "NEON";
+        case SIMD_WASM:
+            return "WASM SIMD128";
         default:
             return "None";
     }
@@ -22,6 +22,13 @@
 #include "config.h"
 #include <string.h>
 
+/* Vector hex encoding/decoding, chosen at compile time like the hash backends */
+#if defined(__AVX2__) || defined(__SSSE3__)
+    #include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
 /* ==================== ENDIAN DETECTION ==================== */
 
 /**
@@ -229,4 +236,185 @@ static inline int xzalgochain_equals(const uint8_t* h1, const uint8_t* h2) {
     return diff == 0;
 }
 
+/* ==================== HEX ENCODING ==================== */
+
+/**
+ * Hex digit of a nibble, without branches or table lookups
+ * @param n Value 0-15
+ * @return '0'-'9' or 'a'-'f'
+ */
+static inline char _xz_hex_char(unsigned int n) {
+    /* 39 = 'a' - '0' - 10, added only when n > 9 */
+    return (char) (n + '0' + (((9u - n) >> 8) & 39u));
+}
+
+/**
+ * Value of a hex digit in constant time
+ * @param c Character
+ * @param bad OR-ed with 0xFF if c is not a hex digit (either case)
+ * @return 0-15 for a hex digit, 0 otherwise
+ */
+static inline unsigned int _xz_hex_value(unsigned char c, unsigned int* bad) {
+    unsigned int d = c ^ 0x30u;                             /* '0'-'9' -> 0-9 */
+    unsigned int l = ((c | 0x20u) + (256u - 'a')) & 0xFFu;  /* 'a'-'f', 'A'-'F' -> 0-5 */
+    unsigned int is_d = ((d - 10u) >> 8) & 0xFFu;           /* 0xFF if d < 10 */
+    unsigned int is_l = ((l - 6u) >> 8) & 0xFFu;            /* 0xFF if l < 6 */
+    *bad |= ~(is_d | is_l) & 0xFFu;
+    return (d & is_d) | ((l + 10u) & is_l);
+}
+
+#if defined(__SSSE3__)
+/**
+ * Hex digit values of 16 characters (SSSE3 path)
+ * @param c Characters
+ * @param bad OR-ed with 0xFF in every lane that is not a hex digit
+ * @return Values 0-15 (0 in invalid lanes)
+ */
+static inline __m128i _xz_hex_values_ssse3(__m128i c, __m128i* bad) {
+    const __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i l = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_d = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+    const __m128i is_l = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+    *bad = _mm_or_si128(*bad, _mm_andnot_si128(_mm_or_si128(is_d, is_l), _mm_set1_epi8(-1)));
+    return _mm_or_si128(_mm_and_si128(is_d, d), _mm_and_si128(is_l, _mm_add_epi8(l, _mm_set1_epi8(10))));
+}
+#endif
+
+#if defined(__AVX2__)
+/** 32-lane version of _xz_hex_values_ssse3() */
+static inline __m256i _xz_hex_values_avx2(__m256i c, __m256i* bad) {
+    const __m256i d = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    const __m256i l = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i is_d = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+    const __m256i is_l = _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+    *bad = _mm256_or_si256(*bad, _mm256_andnot_si256(_mm256_or_si256(is_d, is_l), _mm256_set1_epi8(-1)));
+    return _mm256_or_si256(_mm256_and_si256(is_d, d), _mm256_and_si256(is_l, _mm256_add_epi8(l, _mm256_set1_epi8(10))));
+}
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON) && !defined(__SSSE3__)
+/** NEON version of _xz_hex_values_ssse3() */
+static inline uint8x16_t _xz_hex_values_neon(uint8x16_t c, uint8x16_t* bad) {
+    const uint8x16_t d = vsubq_u8(c, vdupq_n_u8('0'));
+    const uint8x16_t l = vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t is_d = vcleq_u8(d, vdupq_n_u8(9));
+    const uint8x16_t is_l = vcleq_u8(l, vdupq_n_u8(5));
+    *bad = vorrq_u8(*bad, vmvnq_u8(vorrq_u8(is_d, is_l)));
+    return vorrq_u8(vandq_u8(is_d, d), vandq_u8(is_l, vaddq_u8(l, vdupq_n_u8(10))));
+}
+#endif
+
+/**
+ * Encode bytes as lowercase hexadecimal
+ * Nibbles are turned into digits with a 16-entry byte shuffle, 32 bytes
+ * per step with AVX2 and 16 with SSSE3 or NEON; the rest (and builds
+ * without them) use branch-free scalar code
+ *
+ * @param in Bytes to encode
+ * @param len Number of bytes
+ * @param out Output buffer of 2 * len characters (no NUL is written)
+ */
+static inline void xzalgochain_to_hex(const uint8_t* in, size_t len, char* out) {
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i lut256 = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                                            '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    for (; i + 32 <= len; i += 32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*) (in + i));
+        const __m256i hi = _mm256_shuffle_epi8(lut256, _mm256_and_si256(_mm256_srli_epi16(x, 4), _mm256_set1_epi8(0x0F)));
+        const __m256i lo = _mm256_shuffle_epi8(lut256, _mm256_and_si256(x, _mm256_set1_epi8(0x0F)));
+        /* Interleave within 128-bit lanes, then put the lane halves in order */
+        const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256((__m256i*) (out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i*) (out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+#endif
+#if defined(__SSSE3__)
+    const __m128i lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    for (; i + 16 <= len; i += 16) {
+        const __m128i x = _mm_loadu_si128((const __m128i*) (in + i));
+        const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(x, 4), _mm_set1_epi8(0x0F)));
+        const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(x, _mm_set1_epi8(0x0F)));
+        _mm_storeu_si128((__m128i*) (out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i*) (out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    static const uint8_t lut_bytes[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+    const uint8x16_t lut = vld1q_u8(lut_bytes);
+    for (; i + 16 <= len; i += 16) {
+        const uint8x16_t x = vld1q_u8(in + i);
+        uint8x16x2_t digits;
+        digits.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(x, 4));
+        digits.val[1] = vqtbl1q_u8(lut, vandq_u8(x, vdupq_n_u8(0x0F)));
+        vst2q_u8((uint8_t*) out + 2 * i, digits); /* Stores hi, lo, hi, lo, ... */
+    }
+#endif
+
+    for (; i < len; i++) {
+        out[2 * i] = _xz_hex_char(in[i] >> 4);
+        out[2 * i + 1] = _xz_hex_char(in[i] & 0x0Fu);
+    }
+}
+
+/**
+ * Decode hexadecimal digits (either case) into bytes
+ * Runs in constant time for a given length: every character is
+ * classified with arithmetic and masks, with no branch, early exit or
+ * table lookup depending on its value, so the position of an invalid
+ * digit (or of a mismatch against an expected value) is not revealed.
+ * Uses 64 characters per step with AVX2 and 32 with SSSE3 or NEON.
+ *
+ * @param in 2 * len hex digits (need not be NUL-terminated)
+ * @param len Number of bytes to produce
+ * @param out Output buffer of len bytes (contents unspecified on failure)
+ * @return 0 on success, -1 if any character is not a hex digit
+ */
+static inline int xzalgochain_from_hex(const char* in, size_t len, uint8_t* out) {
+    unsigned int bad = 0;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    __m256i bad256 = _mm256_setzero_si256();
+    for (; i + 32 <= len; i += 32) {
+        const __m256i v0 = _xz_hex_values_avx2(_mm256_loadu_si256((const __m256i*) (in + 2 * i)), &bad256);
+        const __m256i v1 = _xz_hex_values_avx2(_mm256_loadu_si256((const __m256i*) (in + 2 * i + 32)), &bad256);
+        /* (even << 4) + odd per digit pair, packed to bytes; packus works per lane, so reorder the quarters */
+        const __m256i p0 = _mm256_maddubs_epi16(v0, _mm256_set1_epi16(0x0110));
+        const __m256i p1 = _mm256_maddubs_epi16(v1, _mm256_set1_epi16(0x0110));
+        _mm256_storeu_si256((__m256i*) (out + i), _mm256_permute4x64_epi64(_mm256_packus_epi16(p0, p1), 0xD8));
+    }
+    bad |= (unsigned int) _mm256_movemask_epi8(bad256) != 0u;
+#endif
+#if defined(__SSSE3__)
+    __m128i bad128 = _mm_setzero_si128();
+    for (; i + 16 <= len; i += 16) {
+        const __m128i v0 = _xz_hex_values_ssse3(_mm_loadu_si128((const __m128i*) (in + 2 * i)), &bad128);
+        const __m128i v1 = _xz_hex_values_ssse3(_mm_loadu_si128((const __m128i*) (in + 2 * i + 16)), &bad128);
+        const __m128i p0 = _mm_maddubs_epi16(v0, _mm_set1_epi16(0x0110));
+        const __m128i p1 = _mm_maddubs_epi16(v1, _mm_set1_epi16(0x0110));
+        _mm_storeu_si128((__m128i*) (out + i), _mm_packus_epi16(p0, p1));
+    }
+    bad |= (unsigned int) _mm_movemask_epi8(bad128) != 0u;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    uint8x16_t bad128 = vdupq_n_u8(0);
+    for (; i + 16 <= len; i += 16) {
+        const uint8x16x2_t c = vld2q_u8((const uint8_t*) in + 2 * i); /* Even and odd digits */
+        const uint8x16_t hi = _xz_hex_values_neon(c.val[0], &bad128);
+        const uint8x16_t lo = _xz_hex_values_neon(c.val[1], &bad128);
+        vst1q_u8(out + i, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+    bad |= vmaxvq_u8(bad128);
+#endif
+
+    for (; i < len; i++) {
+        unsigned int hi = _xz_hex_value((unsigned char) in[2 * i], &bad);
+        unsigned int lo = _xz_hex_value((unsigned char) in[2 * i + 1], &bad);
+        out[i] = (uint8_t) ((hi << 4) | lo);
+    }
+
+    return bad ? -1 : 0;
+}
+
 #endif /* XZALGOCHAIN_UTILS_H */
@@ -0,0 +1,656 @@
+/*
+ * Asynchronous Read Pipeline (Part of XzalgoChain)
+ * Copyright 2026 Xzrayツ
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XZ_AIO_H
+#define XZ_AIO_H
+
+/* Included at the end of XzalgoChain.h, after xz_file.h */
+#include "XzalgoChain.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The pipeline needs POSIX threads and C11 atomics; elsewhere it reads synchronously */
+#if defined(XZ_FILE_HAVE_MMAP) && !defined(__cplusplus) && !defined(__STDC_NO_ATOMICS__)
+    #define XZ_AIO_HAVE_THREADS 1
+    #include <pthread.h>
+    #include <sched.h>
+    #include <stdatomic.h>
+#endif
+
+/* Linux: futex sleeps and io_uring through raw system calls (no liburing).
+ * syscall() is only declared with _DEFAULT_SOURCE, _GNU_SOURCE or _BSD_SOURCE */
+#if defined(XZ_AIO_HAVE_THREADS) && defined(__linux__) && \
+    (defined(_DEFAULT_SOURCE) || defined(_GNU_SOURCE) || defined(_BSD_SOURCE))
+    #include <limits.h>
+    #include <sys/syscall.h>
+    #if defined(SYS_futex)
+        #define XZ_AIO_HAVE_FUTEX 1
+        #include <linux/futex.h>
+    #endif
+    #if defined(__has_include)
+        #if __has_include(<linux/io_uring.h>)
+            #include <linux/io_uring.h>
+        #endif
+    #endif
+    #if defined(IORING_OFF_SQES) && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+        #define XZ_AIO_HAVE_URING 1
+        #include <sys/uio.h>
+    #endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== TUNABLES ==================== */
+
+/** XZ_AIO_DEFAULT_DEPTH: Buffers in flight when the caller passes 0 */
+#ifndef XZ_AIO_DEFAULT_DEPTH
+    #define XZ_AIO_DEFAULT_DEPTH 4
+#endif
+
+/** XZ_AIO_MAX_DEPTH: Largest queue depth accepted */
+#define XZ_AIO_MAX_DEPTH 64
+
+/** XZ_AIO_DEFAULT_BUFFER: Bytes per buffer when the caller passes 0 */
+#ifndef XZ_AIO_DEFAULT_BUFFER
+    #define XZ_AIO_DEFAULT_BUFFER (1024 * 1024)
+#endif
+
+/** XZ_AIO_MAX_BUFFER: Largest buffer accepted */
+#define XZ_AIO_MAX_BUFFER (64 * 1024 * 1024)
+
+/**
+ * XZ_AIO_SPIN: Polls of the ring before a thread goes to sleep
+ * Short, so that a reader waiting on a slow disk does not burn a core
+ */
+#ifndef XZ_AIO_SPIN
+    #define XZ_AIO_SPIN 256
+#endif
+
+#if defined(XZ_AIO_HAVE_THREADS)
+
+/* ==================== SPSC RING ==================== */
+
+/**
+ * One filled buffer, handed from the reader to the hashing thread
+ * Slot n of the ring always uses buffer n % depth, so only the lengths travel
+ */
+typedef struct {
+    size_t len;  /* Bytes read into the buffer */
+    size_t skip; /* Leading bytes before the caller's offset (O_DIRECT alignment) */
+    int error;   /* errno of a failed read, 0 otherwise */
+    int last;    /* End of file or error: nothing follows */
+} _xz_aio_entry;
+
+    #if defined(XZ_AIO_HAVE_URING)
+/* Raw io_uring instance: ring file descriptor and the three shared mappings */
+typedef struct {
+    int fd;
+    unsigned *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe* sqes;
+    struct io_uring_cqe* cqes;
+    void *sq_ring, *cq_ring;
+    size_t sq_ring_size, cq_ring_size, sqes_size;
+} _xz_uring;
+    #endif
+
+/**
+ * Pipeline state shared by the reader and the hashing thread
+ * head is written only by the reader and tail only by the hashing thread;
+ * each sits on its own cache line. A thread that finds the ring empty
+ * (or full) sleeps on the other side's counter after XZ_AIO_SPIN polls.
+ */
+typedef struct {
+    _Alignas(64) atomic_uint head; /* Entries published by the reader */
+    atomic_int head_waiting;       /* Hashing thread asleep on head */
+    _Alignas(64) atomic_uint tail; /* Entries released by the hashing thread */
+    atomic_int tail_waiting;       /* Reader asleep on tail */
+
+    _Alignas(64) int fd;
+    int seekable; /* Regular file: positioned reads from start */
+    int direct;   /* O_DIRECT was enabled on fd */
+    unsigned int depth;
+    size_t bufsize;
+    uint64_t start; /* Offset of the first read */
+    size_t skip;    /* Bytes of the first buffer before the caller's offset */
+    uint8_t* slab;  /* depth buffers of bufsize bytes */
+    _xz_aio_entry entries[XZ_AIO_MAX_DEPTH];
+
+    #if defined(XZ_AIO_HAVE_URING)
+    /* Reader-private io_uring state */
+    _xz_uring uring;
+    struct iovec iov[XZ_AIO_MAX_DEPTH];
+    uint64_t offset[XZ_AIO_MAX_DEPTH];
+    size_t got[XZ_AIO_MAX_DEPTH];
+    uint8_t done[XZ_AIO_MAX_DEPTH];
+    #endif
+} _xz_aio;
+
+static inline void _xz_aio_pause(void) {
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+    #elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+    __asm__ __volatile__("yield");
+    #endif
+}
+
+/**
+ * Wait until *word differs from seen
+ * @param word Counter owned by the other thread
+ * @param waiting Flag telling the other thread to wake us
+ * @param seen Last value observed
+ */
+static inline void _xz_aio_wait(atomic_uint* word, atomic_int* waiting, unsigned int seen) {
+    for (int i = 0; i < XZ_AIO_SPIN; i++) {
+        if (atomic_load_explicit(word, memory_order_acquire) != seen) return;
+        _xz_aio_pause();
+    }
+
+    /* seq_cst store/load pair with _xz_aio_advance(): one side always sees the other */
+    atomic_store(waiting, 1);
+    while (atomic_load(word) == seen) {
+    #if defined(XZ_AIO_HAVE_FUTEX)
+        syscall(SYS_futex, (unsigned int*) word, FUTEX_WAIT_PRIVATE, seen, NULL, NULL, 0);
+    #else
+        sched_yield();
+    #endif
+    }
+    atomic_store(waiting, 0);
+}
+
+/**
+ * Publish one entry (reader) or release one slot (hashing thread)
+ * @param word Counter owned by the calling thread
+ * @param waiting The other thread's sleep flag
+ */
+static inline void _xz_aio_advance(atomic_uint* word, atomic_int* waiting) {
+    atomic_fetch_add(word, 1);
+    if (atomic_load(waiting)) {
+    #if defined(XZ_AIO_HAVE_FUTEX)
+        syscall(SYS_futex, (unsigned int*) word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    #endif
+    }
+}
+
+/* ==================== THREAD READER ==================== */
+
+/**
+ * Reader thread for pipes, terminals, and systems without io_uring
+ * Fills the buffers one after another with blocking read()/pread() while
+ * the hashing thread works on the previous ones
+ */
+static inline void* _xz_aio_thread_reader(void* arg) {
+    _xz_aio* a = (_xz_aio*) arg;
+    uint64_t off = a->start;
+
+    for (unsigned int n = 0;; n++) {
+        unsigned int tail;
+        while (n - (tail = atomic_load_explicit(&a->tail, memory_order_acquire)) >= a->depth)
+            _xz_aio_wait(&a->tail, &a->tail_waiting, tail);
+
+        _xz_aio_entry* e = &a->entries[n % a->depth];
+        uint8_t* buf = a->slab + (size_t) (n % a->depth) * a->bufsize;
+        size_t got = 0;
+        int error = 0;
+
+        while (got < a->bufsize) {
+            ssize_t r = a->seekable ? pread(a->fd, buf + got, a->bufsize - got, (off_t) (off + got))
+                                    : read(a->fd, buf + got, a->bufsize - got);
+            if (r < 0) {
+                if (errno == EINTR) continue;
+                error = errno;
+                break;
+            }
+            if (r == 0) break;
+            got += (size_t) r;
+            /* O_DIRECT cannot continue from an unaligned offset; a short read there is end of file */
+            if (a->direct && got % XZ_FILE_READ_ALIGN) break;
+        }
+
+        e->len = got;
+        e->skip = n == 0 ? a->skip : 0;
+        e->error = error;
+        e->last = error || got < a->bufsize;
+        off += got;
+
+        _xz_aio_advance(&a->head, &a->head_waiting);
+        if (e->last) return NULL;
+    }
+}
+
+/* ==================== IO_URING READER ==================== */
+
+    #if defined(XZ_AIO_HAVE_URING)
+
+static inline void _xz_uring_teardown(_xz_uring* u) {
+    if (u->sqes) munmap(u->sqes, u->sqes_size);
+    if (u->cq_ring && u->cq_ring != u->sq_ring) munmap(u->cq_ring, u->cq_ring_size);
+    if (u->sq_ring) munmap(u->sq_ring, u->sq_ring_size);
+    if (u->fd >= 0) close(u->fd);
+    memset(u, 0, sizeof(*u));
+    u->fd = -1;
+}
+
+/**
+ * Create an io_uring instance and map its rings
+ * @param u Ring to set up
+ * @param entries Submission queue size (the pipeline depth)
+ * @return 0 on success, -1 if io_uring is unavailable (ENOSYS, EPERM under seccomp, ...)
+ */
+static inline int _xz_uring_setup(_xz_uring* u, unsigned int entries) {
+    struct io_uring_params p;
+    memset(u, 0, sizeof(*u));
+    memset(&p, 0, sizeof(p));
+
+    u->fd = (int) syscall(__NR_io_uring_setup, entries, &p);
+    if (u->fd < 0) {
+        u->fd = -1;
+        return -1;
+    }
+
+    u->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    u->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (u->cq_ring_size > u->sq_ring_size) u->sq_ring_size = u->cq_ring_size;
+        u->cq_ring_size = u->sq_ring_size;
+    }
+
+    int map_flags = MAP_SHARED;
+        #ifdef MAP_POPULATE
+    map_flags |= MAP_POPULATE;
+        #endif
+    u->sq_ring = mmap(NULL, u->sq_ring_size, PROT_READ | PROT_WRITE, map_flags, u->fd, IORING_OFF_SQ_RING);
+    if (u->sq_ring == MAP_FAILED) {
+        u->sq_ring = NULL;
+        _xz_uring_teardown(u);
+        return -1;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        u->cq_ring = u->sq_ring;
+    } else {
+        u->cq_ring = mmap(NULL, u->cq_ring_size, PROT_READ | PROT_WRITE, map_flags, u->fd, IORING_OFF_CQ_RING);
+        if (u->cq_ring == MAP_FAILED) {
+            u->cq_ring = NULL;
+            _xz_uring_teardown(u);
+            return -1;
+        }
+    }
+    u->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    u->sqes = (struct io_uring_sqe*) mmap(NULL, u->sqes_size, PROT_READ | PROT_WRITE, map_flags, u->fd, IORING_OFF_SQES);
+    if (u->sqes == MAP_FAILED) {
+        u->sqes = NULL;
+        _xz_uring_teardown(u);
+        return -1;
+    }
+
+    uint8_t* sq = (uint8_t*) u->sq_ring;
+    uint8_t* cq = (uint8_t*) u->cq_ring;
+    u->sq_tail = (unsigned*) (sq + p.sq_off.tail);
+    u->sq_mask = (unsigned*) (sq + p.sq_off.ring_mask);
+    u->sq_array = (unsigned*) (sq + p.sq_off.array);
+    u->cq_head = (unsigned*) (cq + p.cq_off.head);
+    u->cq_tail = (unsigned*) (cq + p.cq_off.tail);
+    u->cq_mask = (unsigned*) (cq + p.cq_off.ring_mask);
+    u->cqes = (struct io_uring_cqe*) (cq + p.cq_off.cqes);
+    return 0;
+}
+
+/**
+ * Queue a read filling the rest of one slot's buffer
+ * A slot has at most one read outstanding, so the depth-sized queue never overflows
+ */
+static inline void _xz_uring_queue_read(_xz_aio* a, unsigned int slot) {
+    _xz_uring* u = &a->uring;
+    unsigned int tail = *u->sq_tail;
+    unsigned int index = tail & *u->sq_mask;
+    struct io_uring_sqe* sqe = &u->sqes[index];
+
+    a->iov[slot].iov_base = a->slab + (size_t) slot * a->bufsize + a->got[slot];
+    a->iov[slot].iov_len = a->bufsize - a->got[slot];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READV; /* Linux 5.1; IORING_OP_READ needs 5.6 */
+    sqe->fd = a->fd;
+    sqe->addr = (uint64_t) (uintptr_t) &a->iov[slot];
+    sqe->len = 1;
+    sqe->off = a->offset[slot] + a->got[slot];
+    sqe->user_data = slot;
+
+    u->sq_array[index] = index;
+    __atomic_store_n(u->sq_tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Reader thread for regular files on Linux
+ * Keeps a read outstanding on every free buffer; completions arrive in any
+ * order and are published to the ring in file order
+ */
+static inline void* _xz_aio_uring_reader(void* arg) {
+    _xz_aio* a = (_xz_aio*) arg;
+    _xz_uring* u = &a->uring;
+    unsigned int submitted = 0; /* Slots handed to the kernel */
+    unsigned int published = 0; /* Slots handed to the hashing thread */
+    unsigned int queued = 0;    /* SQEs not yet passed to io_uring_enter */
+    unsigned int inflight = 0;  /* Reads the kernel has not completed */
+    int stop = 0;               /* End of file or error seen: queue nothing new */
+    int finished = 0;           /* The last entry has been published */
+    uint64_t off = a->start;
+
+    for (;;) {
+        /* Start a read in every buffer the hashing thread has released */
+        unsigned int tail = atomic_load_explicit(&a->tail, memory_order_acquire);
+        while (!stop && submitted - tail < a->depth) {
+            unsigned int slot = submitted % a->depth;
+            a->offset[slot] = off;
+            a->got[slot] = 0;
+            a->done[slot] = 0;
+            a->entries[slot].error = 0;
+            _xz_uring_queue_read(a, slot);
+            off += a->bufsize;
+            submitted++;
+            queued++;
+            inflight++;
+        }
+
+        if (inflight == 0) {
+            if (stop) return NULL;
+            _xz_aio_wait(&a->tail, &a->tail_waiting, tail);
+            continue;
+        }
+
+        long r = syscall(__NR_io_uring_enter, u->fd, queued, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+        if (r < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+            /* The ring itself failed: report it in place of the next buffer */
+            _xz_aio_entry* e = &a->entries[published % a->depth];
+            e->len = 0;
+            e->error = errno;
+            e->last = 1;
+            _xz_aio_advance(&a->head, &a->head_waiting);
+            return NULL;
+        }
+        queued -= (unsigned int) r < queued ? (unsigned int) r : queued;
+
+        /* Reap completions */
+        unsigned int head = *u->cq_head;
+        unsigned int cq_tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != cq_tail; head++) {
+            struct io_uring_cqe* cqe = &u->cqes[head & *u->cq_mask];
+            unsigned int slot = (unsigned int) cqe->user_data;
+            int res = cqe->res;
+            inflight--;
+
+            if (res == -EINTR || res == -EAGAIN) {
+                _xz_uring_queue_read(a, slot);
+                queued++;
+                inflight++;
+            } else if (res < 0) {
+                a->entries[slot].error = -res;
+                a->done[slot] = 1;
+                stop = 1;
+            } else if (res == 0) {
+                a->done[slot] = 1; /* End of file */
+                stop = 1;
+            } else {
+                a->got[slot] += (size_t) res;
+                if (a->got[slot] == a->bufsize) {
+                    a->done[slot] = 1;
+                } else if (a->direct && a->got[slot] % XZ_FILE_READ_ALIGN) {
+                    a->done[slot] = 1; /* Short O_DIRECT read: end of file */
+                    stop = 1;
+                } else {
+                    _xz_uring_queue_read(a, slot); /* Short read: fetch the rest */
+                    queued++;
+                    inflight++;
+                }
+            }
+        }
+        __atomic_store_n(u->cq_head, head, __ATOMIC_RELEASE);
+
+        /* Publish finished buffers in file order, up to the first short one */
+        while (!finished && published < submitted && a->done[published % a->depth]) {
+            unsigned int slot = published % a->depth;
+            _xz_aio_entry* e = &a->entries[slot];
+            e->len = a->got[slot];
+            e->skip = published == 0 ? a->skip : 0;
+            e->last = e->error || e->len < a->bufsize;
+            if (e->last) stop = finished = 1;
+            published++;
+            _xz_aio_advance(&a->head, &a->head_waiting);
+        }
+    }
+}
+
+    #endif /* XZ_AIO_HAVE_URING */
+
+#endif /* XZ_AIO_HAVE_THREADS */
+
+/* ==================== PIPELINED FILE HASHING ==================== */
+
+/**
+ * Absorb the contents of a file descriptor, overlapping reads with hashing
+ * A reader keeps depth page-aligned buffers of buffer_size bytes in flight
+ * and hands them to the calling thread, which hashes them in file order,
+ * through a lock-free single-producer/single-consumer ring. On Linux,
+ * regular files are read with io_uring (raw system calls, Linux 5.1+);
+ * pipes, terminals, and kernels or sandboxes without io_uring use a reader
+ * thread doing blocking read()/pread(). With XZ_AIO_DIRECT, regular files
+ * are read with O_DIRECT so that cold data bypasses the page cache; the
+ * descriptor's flags are restored afterwards. Regular files with holes
+ * are handed to xzalgochain_update_fd(), which absorbs holes without I/O.
+ * Reads from the current offset to end of file and leaves the offset there,
+ * like xzalgochain_update_fd(). Without threads (Windows, WASM, C++) it is
+ * xzalgochain_update_fd() with XZ_FILE_NO_MMAP.
+ *
+ * @param ctx Initialized hash context (not finalized)
+ * @param fd Open file descriptor
+ * @param depth Buffers in flight, 2 to XZ_AIO_MAX_DEPTH (0 for XZ_AIO_DEFAULT_DEPTH)
+ * @param buffer_size Bytes per buffer, rounded up to XZ_FILE_READ_ALIGN, at most
+ *                    XZ_AIO_MAX_BUFFER (0 for XZ_AIO_DEFAULT_BUFFER)
+ * @param flags XZ_AIO_* flags, or XZ_AIO_DEFAULT
+ * @param total If not NULL, receives the number of bytes absorbed
+ * @return 0 on success, -1 on error (errno set)
+ */
+static inline int xzalgochain_update_fd_aio(XzalgoChain_CTX* ctx, int fd, unsigned int depth, size_t buffer_size, int flags, uint64_t* total) {
+    if (total) *total = 0;
+    if (!ctx || fd < 0 || depth > XZ_AIO_MAX_DEPTH || buffer_size > XZ_AIO_MAX_BUFFER) {
+        errno = EINVAL;
+        return -1;
+    }
+
+#if !defined(XZ_AIO_HAVE_THREADS)
+    (void) depth;
+    (void) buffer_size;
+    (void) flags;
+    return xzalgochain_update_fd(ctx, fd, XZ_FILE_NO_MMAP, total);
+#else
+    if (depth == 0) depth = XZ_AIO_DEFAULT_DEPTH;
+    if (depth < 2) depth = 2;
+    if (buffer_size == 0) buffer_size = XZ_AIO_DEFAULT_BUFFER;
+    buffer_size = (buffer_size + XZ_FILE_READ_ALIGN - 1) & ~(size_t) (XZ_FILE_READ_ALIGN - 1);
+
+    _xz_aio* a = (_xz_aio*) aligned_alloc(64, (sizeof(_xz_aio) + 63) & ~(size_t) 63);
+    if (!a) {
+        errno = ENOMEM;
+        return -1;
+    }
+    memset(a, 0, sizeof(*a));
+    a->fd = fd;
+    a->depth = depth;
+    a->bufsize = buffer_size;
+
+    struct stat st;
+    off_t pos = -1;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) pos = lseek(fd, 0, SEEK_CUR);
+
+    #if defined(XZ_FILE_HAVE_SPARSE)
+    /* Sparse files go through the synchronous path, which skips their holes */
+    if (pos >= 0 && st.st_size - pos >= XZ_FILE_SPARSE_MIN) {
+        int sparse = _xz_file_has_hole(fd, pos, st.st_size);
+        if (lseek(fd, pos, SEEK_SET) < 0) {
+            free(a);
+            return -1;
+        }
+        if (sparse) {
+            free(a);
+            return xzalgochain_update_fd(ctx, fd, XZ_FILE_NO_MMAP, total);
+        }
+    }
+    #endif
+    a->seekable = pos >= 0;
+    a->start = a->seekable ? (uint64_t) pos : 0;
+
+    int saved_fl = -1;
+    int use_uring = 0;
+    #if defined(O_DIRECT)
+    if (a->seekable && (flags & XZ_AIO_DIRECT)) {
+        saved_fl = fcntl(fd, F_GETFL);
+        /* Refused by some filesystems (tmpfs); the buffered path is used then */
+        if (saved_fl >= 0 && fcntl(fd, F_SETFL, saved_fl | O_DIRECT) == 0) {
+            a->direct = 1;
+            a->skip = (size_t) (a->start % XZ_FILE_READ_ALIGN);
+            a->start -= a->skip;
+        }
+    }
+    #endif
+    #if defined(POSIX_FADV_SEQUENTIAL)
+    if (!a->direct) posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    #endif
+
+    a->slab = _xz_file_buf_alloc((size_t) depth * buffer_size);
+
+    pthread_t reader;
+    void* (*reader_fn)(void*) = _xz_aio_thread_reader;
+    #if defined(XZ_AIO_HAVE_URING)
+    a->uring.fd = -1;
+    if (a->slab && a->seekable && !(flags & XZ_AIO_NO_URING) && _xz_uring_setup(&a->uring, depth) == 0) {
+        use_uring = 1;
+        reader_fn = _xz_aio_uring_reader;
+    }
+    #else
+    (void) use_uring;
+    #endif
+    #if !defined(O_DIRECT) && !defined(XZ_AIO_HAVE_URING)
+    (void) flags;
+    #endif
+
+    if (!a->slab || pthread_create(&reader, NULL, reader_fn, a) != 0) {
+        /* No memory or no thread: read synchronously instead */
+    #if defined(XZ_AIO_HAVE_URING)
+        if (use_uring) _xz_uring_teardown(&a->uring);
+    #endif
+        if (a->direct) fcntl(fd, F_SETFL, saved_fl);
+        if (a->slab) _xz_file_buf_free(a->slab);
+        free(a);
+        return xzalgochain_update_fd(ctx, fd, XZ_FILE_NO_MMAP, total);
+    }
+
+    /* Hash buffers in file order as the reader publishes them */
+    uint64_t absorbed = 0, raw = 0;
+    int error = 0;
+    for (unsigned int n = 0;; n++) {
+        while (atomic_load_explicit(&a->head, memory_order_acquire) == n)
+            _xz_aio_wait(&a->head, &a->head_waiting, n);
+
+        const _xz_aio_entry* e = &a->entries[n % depth];
+        int last = e->last;
+        if (e->error) {
+            error = e->error;
+            break;
+        }
+        if (e->len > e->skip) {
+            xzalgochain_update(ctx, a->slab + (size_t) (n % depth) * buffer_size + e->skip, e->len - e->skip);
+            absorbed += e->len - e->skip;
+        }
+        raw += e->len;
+
+        _xz_aio_advance(&a->tail, &a->tail_waiting);
+        if (last) break;
+    }
+
+    pthread_join(reader, NULL);
+    #if defined(XZ_AIO_HAVE_URING)
+    if (use_uring) _xz_uring_teardown(&a->uring);
+    #endif
+    if (a->direct) fcntl(fd, F_SETFL, saved_fl);
+
+    /* Leave the offset at end of file, as read() would */
+    if (!error && a->seekable && raw > a->skip && lseek(fd, (off_t) (a->start + raw), SEEK_SET) < 0) error = errno;
+
+    _xz_file_buf_free(a->slab);
+    free(a);
+
+    if (total) *total = absorbed;
+    if (error) {
+        errno = error;
+        return -1;
+    }
+    return 0;
+#endif
+}
+
+/**
+ * Hash a file by path through the read pipeline
+ * See xzalgochain_update_fd_aio() for the parameters
+ *
+ * @param path File path
+ * @param output 40-byte buffer for the hash
+ * @param depth Buffers in flight (0 for the default)
+ * @param buffer_size Bytes per buffer (0 for the default)
+ * @param flags XZ_AIO_* flags, or XZ_AIO_DEFAULT
+ * @return 0 on success, -1 on error (errno set, output untouched)
+ */
+static inline int xzalgochain_file_aio(const char* path, uint8_t output[XZALGOCHAIN_HASH_SIZE], unsigned int depth, size_t buffer_size, int flags) {
+    if (!path) {
+        errno = EINVAL;
+        return -1;
+    }
+
+#if defined(_WIN32)
+    int fd = _open(path, _O_RDONLY | _O_BINARY);
+#elif defined(O_CLOEXEC)
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+#else
+    int fd = open(path, O_RDONLY);
+#endif
+    if (fd < 0) return -1;
+
+    XzalgoChain_CTX ctx;
+    xzalgochain_init(&ctx);
+    int rc = xzalgochain_update_fd_aio(&ctx, fd, depth, buffer_size, flags, NULL);
+    int saved_errno = errno;
+    if (rc == 0) xzalgochain_final(&ctx, output);
+    xzalgochain_ctx_wipe(&ctx);
+
+#if defined(_WIN32)
+    _close(fd);
+#else
+    close(fd);
+#endif
+    errno = saved_errno;
+    return rc;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XZ_AIO_H */
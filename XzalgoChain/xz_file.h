@@ -0,0 +1,449 @@
+/*
+ * File Hashing (Part of XzalgoChain)
+ * Copyright 2026 Xzrayツ
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XZ_FILE_H
+#define XZ_FILE_H
+
+/* Included at the end of XzalgoChain.h; needs the context API */
+#include "XzalgoChain.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* mmap is used on POSIX systems; everything else reads through read() */
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+    #define XZ_FILE_HAVE_MMAP 1
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    /* Linux values, hidden by glibc without _GNU_SOURCE (other systems differ) */
+    #if defined(__linux__) && !defined(SEEK_DATA)
+        #define SEEK_DATA 3
+        #define SEEK_HOLE 4
+    #endif
+    #if defined(SEEK_DATA) && defined(SEEK_HOLE)
+        #define XZ_FILE_HAVE_SPARSE 1
+    #endif
+#elif defined(_WIN32)
+    #include <fcntl.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== TUNABLES ==================== */
+
+/**
+ * XZ_FILE_MMAP_THRESHOLD: Smallest regular file mapped instead of read
+ * Below it the mmap/munmap system calls and page-table setup cost more
+ * than copying the data
+ */
+#ifndef XZ_FILE_MMAP_THRESHOLD
+    #define XZ_FILE_MMAP_THRESHOLD (1024 * 1024)
+#endif
+
+/**
+ * XZ_FILE_MMAP_WINDOW: Bytes mapped at a time (multiple of the page size)
+ * Bounds address-space use on 32-bit systems and the amount prefaulted
+ * by MAP_POPULATE before hashing starts
+ */
+#ifndef XZ_FILE_MMAP_WINDOW
+    #define XZ_FILE_MMAP_WINDOW (64 * 1024 * 1024)
+#endif
+
+/**
+ * XZ_FILE_READ_SIZE: Largest read() request on the read path
+ */
+#ifndef XZ_FILE_READ_SIZE
+    #define XZ_FILE_READ_SIZE (1024 * 1024)
+#endif
+
+/**
+ * XZ_FILE_SPARSE_MIN: Smallest regular file checked for holes
+ * Costs one lseek(SEEK_HOLE) per file; smaller files rarely have holes
+ */
+#ifndef XZ_FILE_SPARSE_MIN
+    #define XZ_FILE_SPARSE_MIN (64 * 1024)
+#endif
+
+/** XZ_FILE_READ_ALIGN: Alignment of the read buffer (one page) */
+#define XZ_FILE_READ_ALIGN 4096
+
+/* ==================== READ BUFFER ==================== */
+
+/**
+ * Allocate a page-aligned read buffer
+ * @param size Buffer size, a multiple of XZ_FILE_READ_ALIGN
+ * @return Buffer, or NULL on failure
+ */
+static inline uint8_t* _xz_file_buf_alloc(size_t size) {
+#if defined(_WIN32)
+    return (uint8_t*) _aligned_malloc(size, XZ_FILE_READ_ALIGN);
+#else
+    return (uint8_t*) aligned_alloc(XZ_FILE_READ_ALIGN, size);
+#endif
+}
+
+static inline void _xz_file_buf_free(uint8_t* buf) {
+#if defined(_WIN32)
+    _aligned_free(buf);
+#else
+    free(buf);
+#endif
+}
+
+/* ==================== READ PATH ==================== */
+
+/**
+ * Absorb everything from the current offset of fd to end of file with read()
+ * Used for pipes, terminals, sockets, small files, and when mapping fails
+ *
+ * @param ctx Initialized hash context
+ * @param fd Open file descriptor
+ * @param size_hint Bytes expected (0 if unknown), to size the buffer
+ * @param total Incremented by the number of bytes absorbed
+ * @return 0 on success, -1 on read error (errno set)
+ */
+static inline int _xz_file_update_read(XzalgoChain_CTX* ctx, int fd, uint64_t size_hint, uint64_t* total) {
+    /* Small files get a buffer just big enough for one read plus the EOF probe */
+    size_t size = XZ_FILE_READ_SIZE;
+    if (size_hint > 0 && size_hint < XZ_FILE_READ_SIZE)
+        size = ((size_t) size_hint + XZ_FILE_READ_ALIGN) & ~(size_t) (XZ_FILE_READ_ALIGN - 1);
+
+    uint8_t* buf = _xz_file_buf_alloc(size);
+    if (!buf) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    for (;;) {
+#if defined(_WIN32)
+        int r = _read(fd, buf, (unsigned int) size);
+#else
+        ssize_t r = read(fd, buf, size);
+#endif
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            int saved_errno = errno;
+            _xz_file_buf_free(buf);
+            errno = saved_errno;
+            return -1;
+        }
+        if (r == 0) break;
+
+        xzalgochain_update(ctx, buf, (size_t) r);
+        *total += (uint64_t) r;
+    }
+
+    _xz_file_buf_free(buf);
+    return 0;
+}
+
+#if defined(XZ_FILE_HAVE_MMAP)
+
+/* ==================== MAPPED PATH ==================== */
+
+/**
+ * Absorb bytes [pos, end) of a regular file through XZ_FILE_MMAP_WINDOW mappings
+ * The file offset is not used or changed.
+ *
+ * @param ctx Initialized hash context
+ * @param fd Open regular file
+ * @param pos First byte to absorb
+ * @param end End of the range
+ * @param flags XZ_FILE_* flags
+ * @param total Incremented by the number of bytes absorbed
+ * @return Offset reached: end, or less if a mapping failed (read the rest)
+ */
+static inline off_t _xz_file_update_map(XzalgoChain_CTX* ctx, int fd, off_t pos, off_t end, int flags, uint64_t* total) {
+    const off_t page = (off_t) sysconf(_SC_PAGESIZE);
+    int map_flags = MAP_PRIVATE;
+    #ifdef MAP_POPULATE
+    map_flags |= MAP_POPULATE;
+    #endif
+    #ifndef MADV_HUGEPAGE
+    (void) flags;
+    #endif
+
+    while (pos < end) {
+        off_t map_off = pos - pos % page;
+        size_t skip = (size_t) (pos - map_off);
+        size_t len = (uint64_t) (end - map_off) < XZ_FILE_MMAP_WINDOW ? (size_t) (end - map_off) : XZ_FILE_MMAP_WINDOW;
+
+        void* map = mmap(NULL, len, PROT_READ, map_flags, fd, map_off);
+        if (map == MAP_FAILED) break; /* e.g. a filesystem without mmap */
+
+        posix_madvise(map, len, POSIX_MADV_SEQUENTIAL);
+    #ifdef MADV_HUGEPAGE
+        if (flags & XZ_FILE_HUGEPAGES) madvise(map, len, MADV_HUGEPAGE);
+    #endif
+        xzalgochain_update(ctx, (const uint8_t*) map + skip, len - skip);
+        munmap(map, len);
+
+        *total += len - skip;
+        pos = map_off + (off_t) len;
+    }
+    return pos;
+}
+
+#endif /* XZ_FILE_HAVE_MMAP */
+
+#if defined(XZ_FILE_HAVE_SPARSE)
+
+/* ==================== SPARSE PATH ==================== */
+
+/**
+ * Check whether a regular file has a hole between pos and end
+ * Every file has a virtual hole at end of file, so only an earlier one counts.
+ * The file offset is moved; callers seek back or reposition it.
+ *
+ * @param fd Open regular file
+ * @param pos Start of the range
+ * @param end End of the range (file size)
+ * @return 1 if the range contains a hole, 0 otherwise (or if unsupported)
+ */
+static inline int _xz_file_has_hole(int fd, off_t pos, off_t end) {
+    off_t hole = lseek(fd, pos, SEEK_HOLE);
+    return hole >= pos && hole < end;
+}
+
+/**
+ * Absorb bytes [pos, end) of a sparse regular file
+ * Holes found with SEEK_DATA/SEEK_HOLE are absorbed with
+ * xzalgochain_update_zeros() without any I/O; data extents are mapped
+ * (large ones) or read with pread(). The digest equals that of a dense
+ * read. Leaves the file offset at the end of what was absorbed.
+ *
+ * @param ctx Initialized hash context
+ * @param fd Open regular file
+ * @param pos First byte to absorb
+ * @param end End of the range (file size when the walk started)
+ * @param flags XZ_FILE_* flags
+ * @param total Incremented by the number of bytes absorbed
+ * @return 0 on success, -1 on error (errno set)
+ */
+static inline int _xz_file_update_sparse(XzalgoChain_CTX* ctx, int fd, off_t pos, off_t end, int flags, uint64_t* total) {
+    uint8_t* buf = NULL;
+    int rc = 0;
+
+    while (pos < end) {
+        off_t data = lseek(fd, pos, SEEK_DATA);
+        if (data < 0) {
+            if (errno != ENXIO) {
+                rc = -1;
+                break;
+            }
+            data = end; /* Only a hole up to end of file is left */
+        }
+        if (data > end) data = end;
+
+        if (data > pos) {
+            xzalgochain_update_zeros(ctx, (uint64_t) (data - pos));
+            *total += (uint64_t) (data - pos);
+            pos = data;
+        }
+        if (pos >= end) break;
+
+        off_t hole = lseek(fd, pos, SEEK_HOLE);
+        if (hole <= pos || hole > end) hole = end;
+
+        if (!(flags & XZ_FILE_NO_MMAP) && hole - pos >= XZ_FILE_MMAP_THRESHOLD)
+            pos = _xz_file_update_map(ctx, fd, pos, hole, flags, total);
+
+        while (pos < hole) {
+            if (!buf && !(buf = _xz_file_buf_alloc(XZ_FILE_READ_SIZE))) {
+                errno = ENOMEM;
+                rc = -1;
+                break;
+            }
+            size_t want = (uint64_t) (hole - pos) < XZ_FILE_READ_SIZE ? (size_t) (hole - pos) : XZ_FILE_READ_SIZE;
+            ssize_t r = pread(fd, buf, want, pos);
+            if (r < 0) {
+                if (errno == EINTR) continue;
+                rc = -1;
+                break;
+            }
+            if (r == 0) {
+                end = pos; /* Truncated while it was hashed */
+                break;
+            }
+            xzalgochain_update(ctx, buf, (size_t) r);
+            *total += (uint64_t) r;
+            pos += (off_t) r;
+        }
+        if (rc != 0) break;
+    }
+
+    int saved_errno = errno;
+    if (buf) _xz_file_buf_free(buf);
+    if (lseek(fd, pos, SEEK_SET) < 0) return -1;
+    errno = saved_errno;
+    return rc;
+}
+
+#endif /* XZ_FILE_HAVE_SPARSE */
+
+/* ==================== FILE HASHING ==================== */
+
+/**
+ * Absorb the contents of a file descriptor into a hash context
+ * Reads from the current offset to end of file and leaves the offset there.
+ * Large regular files are memory-mapped in XZ_FILE_MMAP_WINDOW windows
+ * (MAP_POPULATE, MADV_SEQUENTIAL), so page-cache-hot data is hashed in
+ * place without a copy. Pipes and small files are read with large aligned
+ * read() calls after posix_fadvise(SEQUENTIAL). Holes in sparse files
+ * (found with SEEK_DATA/SEEK_HOLE where the system has them) are absorbed
+ * as zero runs without reading them; XZ_FILE_NO_SPARSE turns that off.
+ * MAP_POPULATE and MADV_HUGEPAGE are Linux extensions, used only when the
+ * system headers expose them (_DEFAULT_SOURCE or _GNU_SOURCE).
+ * A file that grows while it is hashed is read to its new end; one
+ * truncated while mapped raises SIGBUS, as with any mmap-based reader
+ * (use XZ_FILE_NO_MMAP if files may shrink underneath you).
+ *
+ * @param ctx Initialized hash context (not finalized)
+ * @param fd Open file descriptor
+ * @param flags XZ_FILE_* flags, or XZ_FILE_DEFAULT
+ * @param total If not NULL, receives the number of bytes absorbed
+ * @return 0 on success, -1 on error (errno set)
+ */
+static inline int xzalgochain_update_fd(XzalgoChain_CTX* ctx, int fd, int flags, uint64_t* total) {
+    uint64_t absorbed = 0;
+    uint64_t size_hint = 0;
+
+    if (total) *total = 0;
+    if (!ctx || fd < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+#if defined(XZ_FILE_HAVE_MMAP)
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        off_t pos = lseek(fd, 0, SEEK_CUR);
+        if (pos >= 0 && st.st_size > pos) size_hint = (uint64_t) (st.st_size - pos);
+
+    #if defined(XZ_FILE_HAVE_SPARSE)
+        if (pos >= 0 && !(flags & XZ_FILE_NO_SPARSE) && size_hint >= XZ_FILE_SPARSE_MIN) {
+            if (_xz_file_has_hole(fd, pos, st.st_size)) {
+                int rc = _xz_file_update_sparse(ctx, fd, pos, st.st_size, flags, &absorbed);
+                if (rc != 0) {
+                    if (total) *total = absorbed;
+                    return rc;
+                }
+                size_hint = 0; /* Appended data, if any, is read below */
+            } else if (lseek(fd, pos, SEEK_SET) < 0) {
+                return -1;
+            }
+        }
+    #endif
+
+        if (pos >= 0 && !(flags & XZ_FILE_NO_MMAP) && size_hint >= XZ_FILE_MMAP_THRESHOLD) {
+            pos = _xz_file_update_map(ctx, fd, pos, st.st_size, flags, &absorbed);
+
+            /* Continue after the mapped part: appended data, or all of it if mapping failed */
+            if (lseek(fd, pos, SEEK_SET) < 0) {
+                if (total) *total = absorbed;
+                return -1;
+            }
+            size_hint = 0;
+        }
+    }
+
+    #if defined(POSIX_FADV_SEQUENTIAL)
+    /* Fails harmlessly on pipes and terminals */
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    #endif
+#else
+    (void) flags;
+#endif
+
+    int rc = _xz_file_update_read(ctx, fd, size_hint, &absorbed);
+    if (total) *total = absorbed;
+    return rc;
+}
+
+/**
+ * Hash the contents of a file descriptor, from its current offset to end of file
+ * See xzalgochain_update_fd() for how the data is read
+ *
+ * @param fd Open file descriptor
+ * @param output 40-byte buffer for the hash
+ * @param flags XZ_FILE_* flags, or XZ_FILE_DEFAULT
+ * @return 0 on success, -1 on error (errno set, output untouched)
+ */
+static inline int xzalgochain_fd(int fd, uint8_t output[XZALGOCHAIN_HASH_SIZE], int flags) {
+    XzalgoChain_CTX ctx;
+    xzalgochain_init(&ctx);
+
+    if (xzalgochain_update_fd(&ctx, fd, flags, NULL) != 0) {
+        int saved_errno = errno;
+        xzalgochain_ctx_wipe(&ctx);
+        errno = saved_errno;
+        return -1;
+    }
+
+    xzalgochain_final(&ctx, output);
+    xzalgochain_ctx_wipe(&ctx);
+    return 0;
+}
+
+/**
+ * Hash a file by path
+ * See xzalgochain_update_fd() for how the data is read
+ *
+ * @param path File path
+ * @param output 40-byte buffer for the hash
+ * @param flags XZ_FILE_* flags, or XZ_FILE_DEFAULT
+ * @return 0 on success, -1 on error (errno set, output untouched)
+ */
+static inline int xzalgochain_file(const char* path, uint8_t output[XZALGOCHAIN_HASH_SIZE], int flags) {
+    if (!path) {
+        errno = EINVAL;
+        return -1;
+    }
+
+#if defined(_WIN32)
+    int fd = _open(path, _O_RDONLY | _O_BINARY);
+#elif defined(O_CLOEXEC)
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+#else
+    int fd = open(path, O_RDONLY);
+#endif
+    if (fd < 0) return -1;
+
+    int rc = xzalgochain_fd(fd, output, flags);
+    int saved_errno = errno;
+#if defined(_WIN32)
+    _close(fd);
+#else
+    close(fd);
+#endif
+    errno = saved_errno;
+    return rc;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XZ_FILE_H */
@@ -0,0 +1,416 @@
+/*
+ * Binary Manifests (Part of XzalgoChain)
+ * Copyright 2026 Xzrayツ
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XZ_MANIFEST_H
+#define XZ_MANIFEST_H
+
+/* Included at the end of XzalgoChain.h, after xz_file.h (mmap detection) */
+#include "XzalgoChain.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== FILE FORMAT ==================== */
+
+/**
+ * A manifest is a header followed by four sections, each 8-byte aligned,
+ * in the byte order of the machine that wrote it:
+ *   records  count XzalgoChain_ManifestRecord, sorted by digest (then path offset)
+ *   offsets  count uint64_t, the string table offset of each record's path
+ *   paths    count XzalgoChain_ManifestPath, sorted by path hash (then record)
+ *   strings  NUL-terminated paths, in the order they were given to the writer
+ * Readers map the file and use the sections in place.
+ */
+#define XZ_MANIFEST_MAGIC "XZMANIFS"
+#define XZ_MANIFEST_VERSION 2
+#define XZ_MANIFEST_BYTE_ORDER 0x01020304u
+
+/* File header (72 bytes) */
+typedef struct {
+    char magic[8];            /* XZ_MANIFEST_MAGIC */
+    uint32_t version;         /* XZ_MANIFEST_VERSION */
+    uint32_t byte_order;      /* XZ_MANIFEST_BYTE_ORDER as written */
+    uint32_t record_size;     /* sizeof(XzalgoChain_ManifestRecord) */
+    uint32_t path_size;       /* sizeof(XzalgoChain_ManifestPath) */
+    uint64_t count;           /* Entries */
+    uint64_t records_offset;  /* File offsets of the sections */
+    uint64_t offsets_offset;
+    uint64_t paths_offset;
+    uint64_t strings_offset;
+    uint64_t strings_size;    /* Bytes of the string table */
+} XzalgoChain_ManifestHeader;
+
+/* One entry of the digest table (40 bytes); its path offset is in the
+ * offsets section, at the same index */
+typedef struct {
+    uint8_t digest[XZALGOCHAIN_HASH_SIZE];
+} XzalgoChain_ManifestRecord;
+
+/* One entry of the path index (16 bytes) */
+typedef struct {
+    uint64_t hash;   /* xzalgochain_manifest_path_hash() of the path */
+    uint64_t record; /* Index into the digest table */
+} XzalgoChain_ManifestPath;
+
+/* An open manifest */
+typedef struct {
+    const XzalgoChain_ManifestRecord* records;
+    const uint64_t* path_offsets; /* Per record: offset of its path in strings */
+    const XzalgoChain_ManifestPath* paths;
+    const char* strings;
+    uint64_t count;
+    uint64_t strings_size;
+    void* base;  /* Mapping, or buffer without mmap */
+    size_t size; /* File size */
+} XzalgoChain_Manifest;
+
+/* ==================== PATH HASH ==================== */
+
+/**
+ * Hash a path for the path index (64-bit FNV-1a)
+ * The index only has to spread paths out; lookups compare the path itself,
+ * so a fast non-cryptographic hash keeps 50M-entry writes cheap
+ *
+ * @param path NUL-terminated path
+ * @return 64-bit hash
+ */
+static inline uint64_t xzalgochain_manifest_path_hash(const char* path) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (const unsigned char* c = (const unsigned char*) path; *c; c++) {
+        h ^= *c;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+/* ==================== WRITING ==================== */
+
+/* Record plus its path offset and path hash, sorted together while writing */
+typedef struct {
+    XzalgoChain_ManifestRecord record;
+    uint64_t path_offset;
+    uint64_t hash;
+} _xz_manifest_entry;
+
+static inline int _xz_manifest_compare_records(const void* a, const void* b) {
+    const _xz_manifest_entry* x = (const _xz_manifest_entry*) a;
+    const _xz_manifest_entry* y = (const _xz_manifest_entry*) b;
+    int c = memcmp(x->record.digest, y->record.digest, XZALGOCHAIN_HASH_SIZE);
+    if (c != 0) return c;
+    return x->path_offset < y->path_offset ? -1 : (x->path_offset > y->path_offset);
+}
+
+static inline int _xz_manifest_compare_paths(const void* a, const void* b) {
+    const XzalgoChain_ManifestPath* x = (const XzalgoChain_ManifestPath*) a;
+    const XzalgoChain_ManifestPath* y = (const XzalgoChain_ManifestPath*) b;
+    if (x->hash != y->hash) return x->hash < y->hash ? -1 : 1;
+    return x->record < y->record ? -1 : (x->record > y->record);
+}
+
+/**
+ * Write a binary manifest
+ * Builds the sorted tables in memory (72 bytes per entry plus the paths)
+ * and writes the file in one pass
+ *
+ * @param path Output file, replaced if it exists
+ * @param digests One digest per entry
+ * @param paths One NUL-terminated path per entry
+ * @param count Number of entries
+ * @return 0 on success, -1 on error (errno set)
+ */
+static inline int xzalgochain_manifest_write(const char* path, const uint8_t (*digests)[XZALGOCHAIN_HASH_SIZE],
+                                             const char* const* paths, size_t count) {
+    if (!path || (count > 0 && (!digests || !paths))) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    _xz_manifest_entry* entries = (_xz_manifest_entry*) malloc((count ? count : 1) * sizeof(_xz_manifest_entry));
+    XzalgoChain_ManifestPath* index = (XzalgoChain_ManifestPath*) malloc((count ? count : 1) * sizeof(XzalgoChain_ManifestPath));
+    if (!entries || !index) {
+        free(entries);
+        free(index);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    uint64_t strings_size = 0;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(entries[i].record.digest, digests[i], XZALGOCHAIN_HASH_SIZE);
+        entries[i].path_offset = strings_size;
+        entries[i].hash = xzalgochain_manifest_path_hash(paths[i]);
+        strings_size += strlen(paths[i]) + 1;
+    }
+    qsort(entries, count, sizeof(_xz_manifest_entry), _xz_manifest_compare_records);
+    for (size_t i = 0; i < count; i++) {
+        index[i].hash = entries[i].hash;
+        index[i].record = i;
+    }
+    qsort(index, count, sizeof(XzalgoChain_ManifestPath), _xz_manifest_compare_paths);
+
+    XzalgoChain_ManifestHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, XZ_MANIFEST_MAGIC, sizeof(header.magic));
+    header.version = XZ_MANIFEST_VERSION;
+    header.byte_order = XZ_MANIFEST_BYTE_ORDER;
+    header.record_size = sizeof(XzalgoChain_ManifestRecord);
+    header.path_size = sizeof(XzalgoChain_ManifestPath);
+    header.count = count;
+    header.records_offset = sizeof(header);
+    header.offsets_offset = header.records_offset + (uint64_t) count * sizeof(XzalgoChain_ManifestRecord);
+    header.paths_offset = header.offsets_offset + (uint64_t) count * sizeof(uint64_t);
+    header.strings_offset = header.paths_offset + (uint64_t) count * sizeof(XzalgoChain_ManifestPath);
+    header.strings_size = strings_size;
+
+    FILE* fp = fopen(path, "wb");
+    int ok = fp != NULL && fwrite(&header, sizeof(header), 1, fp) == 1;
+    for (size_t i = 0; ok && i < count; i++)
+        ok = fwrite(&entries[i].record, sizeof(XzalgoChain_ManifestRecord), 1, fp) == 1;
+    for (size_t i = 0; ok && i < count; i++)
+        ok = fwrite(&entries[i].path_offset, sizeof(uint64_t), 1, fp) == 1;
+    if (ok && count > 0)
+        ok = fwrite(index, sizeof(XzalgoChain_ManifestPath), count, fp) == count;
+    for (size_t i = 0; ok && i < count; i++)
+        ok = fwrite(paths[i], 1, strlen(paths[i]) + 1, fp) == strlen(paths[i]) + 1;
+
+    int saved_errno = errno;
+    if (fp && fclose(fp) != 0 && ok) {
+        ok = 0;
+        saved_errno = errno;
+    }
+    free(entries);
+    free(index);
+    if (!ok) {
+        errno = saved_errno ? saved_errno : EIO;
+        return -1;
+    }
+    return 0;
+}
+
+/* ==================== READING ==================== */
+
+static inline void _xz_manifest_close_fd(int fd) {
+#if defined(_WIN32)
+    _close(fd);
+#else
+    close(fd);
+#endif
+}
+
+/**
+ * Open a binary manifest
+ * The file is memory-mapped read-only (read into memory where mmap is not
+ * available). Only the header and section bounds are checked; records are
+ * used in place, and paths are bounds-checked as they are looked up.
+ *
+ * @param path Manifest file
+ * @param m Receives the open manifest
+ * @return 0 on success, -1 on error (errno set; EINVAL for a file that is
+ *         not a manifest, or one written on a machine of the other byte order)
+ */
+static inline int xzalgochain_manifest_open(const char* path, XzalgoChain_Manifest* m) {
+    if (!path || !m) {
+        errno = EINVAL;
+        return -1;
+    }
+    memset(m, 0, sizeof(*m));
+
+#if defined(_WIN32)
+    int fd = _open(path, _O_RDONLY | _O_BINARY);
+#elif defined(O_CLOEXEC)
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+#else
+    int fd = open(path, O_RDONLY);
+#endif
+    if (fd < 0) return -1;
+
+#if defined(XZ_FILE_HAVE_MMAP)
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int saved_errno = errno;
+        _xz_manifest_close_fd(fd);
+        errno = saved_errno;
+        return -1;
+    }
+    m->size = (size_t) st.st_size;
+    if (m->size >= sizeof(XzalgoChain_ManifestHeader)) {
+        m->base = mmap(NULL, m->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m->base == MAP_FAILED) {
+            int saved_errno = errno;
+            m->base = NULL;
+            _xz_manifest_close_fd(fd);
+            errno = saved_errno;
+            return -1;
+        }
+    }
+    _xz_manifest_close_fd(fd);
+#else
+    /* No mmap: read the whole file */
+    size_t cap = 0;
+    for (;;) {
+        if (m->size == cap) {
+            cap = cap ? cap * 2 : 1024 * 1024;
+            void* grown = realloc(m->base, cap);
+            if (!grown) {
+                free(m->base);
+                m->base = NULL;
+                _xz_manifest_close_fd(fd);
+                errno = ENOMEM;
+                return -1;
+            }
+            m->base = grown;
+        }
+    #if defined(_WIN32)
+        int r = _read(fd, (char*) m->base + m->size, (unsigned int) (cap - m->size));
+    #else
+        ssize_t r = read(fd, (char*) m->base + m->size, cap - m->size);
+    #endif
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) {
+            int saved_errno = errno;
+            _xz_manifest_close_fd(fd);
+            if (r < 0) {
+                free(m->base);
+                m->base = NULL;
+                errno = saved_errno;
+                return -1;
+            }
+            break;
+        }
+        m->size += (size_t) r;
+    }
+#endif
+
+    const XzalgoChain_ManifestHeader* h = (const XzalgoChain_ManifestHeader*) m->base;
+    uint64_t size = m->size;
+    int valid = h != NULL && size >= sizeof(*h) && memcmp(h->magic, XZ_MANIFEST_MAGIC, sizeof(h->magic)) == 0 &&
+                h->version == XZ_MANIFEST_VERSION && h->byte_order == XZ_MANIFEST_BYTE_ORDER &&
+                h->record_size == sizeof(XzalgoChain_ManifestRecord) && h->path_size == sizeof(XzalgoChain_ManifestPath) &&
+                h->records_offset % 8 == 0 && h->offsets_offset % 8 == 0 && h->paths_offset % 8 == 0 &&
+                h->records_offset <= size && h->offsets_offset <= size && h->paths_offset <= size &&
+                h->strings_offset <= size && h->strings_size <= size - h->strings_offset &&
+                h->count <= (size - h->records_offset) / sizeof(XzalgoChain_ManifestRecord) &&
+                h->count <= (size - h->offsets_offset) / sizeof(uint64_t) &&
+                h->count <= (size - h->paths_offset) / sizeof(XzalgoChain_ManifestPath) &&
+                (h->count == 0 || (h->strings_size > 0 && ((const char*) m->base)[h->strings_offset + h->strings_size - 1] == '\0'));
+    if (!valid) {
+#if defined(XZ_FILE_HAVE_MMAP)
+        if (m->base) munmap(m->base, m->size);
+#else
+        free(m->base);
+#endif
+        memset(m, 0, sizeof(*m));
+        errno = EINVAL;
+        return -1;
+    }
+
+    m->records = (const XzalgoChain_ManifestRecord*) ((const char*) m->base + h->records_offset);
+    m->path_offsets = (const uint64_t*) ((const char*) m->base + h->offsets_offset);
+    m->paths = (const XzalgoChain_ManifestPath*) ((const char*) m->base + h->paths_offset);
+    m->strings = (const char*) m->base + h->strings_offset;
+    m->count = h->count;
+    m->strings_size = h->strings_size;
+    return 0;
+}
+
+/**
+ * Close a manifest opened by xzalgochain_manifest_open()
+ * @param m Manifest; records and paths taken from it become invalid
+ */
+static inline void xzalgochain_manifest_close(XzalgoChain_Manifest* m) {
+    if (!m || !m->base) return;
+#if defined(XZ_FILE_HAVE_MMAP)
+    munmap(m->base, m->size);
+#else
+    free(m->base);
+#endif
+    memset(m, 0, sizeof(*m));
+}
+
+/**
+ * Get the path of a record
+ * @param m Open manifest
+ * @param record Record of m
+ * @return NUL-terminated path inside the manifest, or NULL if its offset is out of range
+ */
+static inline const char* xzalgochain_manifest_path(const XzalgoChain_Manifest* m, const XzalgoChain_ManifestRecord* record) {
+    uint64_t offset = m->path_offsets[record - m->records];
+    return offset < m->strings_size ? m->strings + offset : NULL;
+}
+
+/**
+ * Find the first record with a digest (binary search of the digest table)
+ * Records with the same digest (identical files) follow it
+ *
+ * @param m Open manifest
+ * @param digest 40-byte digest
+ * @return Record, or NULL if no entry has this digest
+ */
+static inline const XzalgoChain_ManifestRecord* xzalgochain_manifest_find_digest(const XzalgoChain_Manifest* m,
+                                                                                 const uint8_t digest[XZALGOCHAIN_HASH_SIZE]) {
+    uint64_t lo = 0, hi = m->count;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (memcmp(m->records[mid].digest, digest, XZALGOCHAIN_HASH_SIZE) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < m->count && memcmp(m->records[lo].digest, digest, XZALGOCHAIN_HASH_SIZE) == 0)
+        return &m->records[lo];
+    return NULL;
+}
+
+/**
+ * Find the record of a path (binary search of the path index)
+ *
+ * @param m Open manifest
+ * @param path NUL-terminated path, exactly as written
+ * @return Record, or NULL if the path is not listed
+ */
+static inline const XzalgoChain_ManifestRecord* xzalgochain_manifest_find_path(const XzalgoChain_Manifest* m, const char* path) {
+    uint64_t hash = xzalgochain_manifest_path_hash(path);
+    uint64_t lo = 0, hi = m->count;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (m->paths[mid].hash < hash)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    /* Same hash: compare the paths themselves */
+    for (; lo < m->count && m->paths[lo].hash == hash; lo++) {
+        if (m->paths[lo].record >= m->count) continue;
+        const XzalgoChain_ManifestRecord* record = &m->records[m->paths[lo].record];
+        const char* p = xzalgochain_manifest_path(m, record);
+        if (p && strcmp(p, path) == 0) return record;
+    }
+    return NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XZ_MANIFEST_H */
@@ -0,0 +1,133 @@
+/*
+ * Multi-Message Hashing (Part of XzalgoChain)
+ * Copyright 2026 Xzrayツ
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XZ_MULTI_H
+#define XZ_MULTI_H
+
+/* Included at the end of XzalgoChain.h; needs the context API */
+#include "XzalgoChain.h"
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== TUNABLES ==================== */
+
+/**
+ * XZ_MULTI_LANES: Messages hashed side by side
+ * Their blocks are absorbed in lockstep, so the block chains of
+ * independent messages are interleaved instead of run one after another.
+ */
+#ifndef XZ_MULTI_LANES
+    #define XZ_MULTI_LANES 8
+#endif
+
+/* ==================== MULTI-MESSAGE HASH ==================== */
+
+/**
+ * Hash many independent messages at once
+ * Messages are taken XZ_MULTI_LANES at a time. Their 128-byte blocks are
+ * absorbed in lockstep while every message in the group still has one,
+ * giving the CPU several independent block chains to overlap. Each lane
+ * is then finished by the same finalization as xzalgochain_final(), so
+ * each digest is identical to xzalgochain() on the same bytes. The
+ * context setup is shared by every message.
+ *
+ * @param data Message pointers (data[i] may be NULL when lens[i] is 0)
+ * @param lens Message lengths in bytes
+ * @param count Number of messages
+ * @param outputs One 40-byte digest per message
+ * @return 0 on success, -1 on invalid arguments (errno = EINVAL)
+ */
+static inline int xzalgochain_many(const uint8_t* const* data, const size_t* lens, size_t count,
+                                   uint8_t (*outputs)[XZALGOCHAIN_HASH_SIZE]) {
+    if (count > 0 && (!data || !lens || !outputs)) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!data[i] && lens[i] > 0) {
+            errno = EINVAL;
+            return -1;
+        }
+    }
+
+    /* Initial state, shared by every message */
+    XzalgoChain_CTX init, ctx;
+    xzalgochain_init(&init);
+
+    for (size_t base = 0; base < count; base += XZ_MULTI_LANES) {
+        const size_t n = count - base < XZ_MULTI_LANES ? count - base : XZ_MULTI_LANES;
+        uint64_t state[XZ_MULTI_LANES][5];
+        size_t common = SIZE_MAX;
+
+        for (size_t l = 0; l < n; l++) {
+            memcpy(state[l], init.h, sizeof(init.h));
+            if (lens[base + l] / 128 < common) common = lens[base + l] / 128;
+        }
+
+        /* Full blocks that every message in the group has, one per lane in turn */
+        for (size_t blk = 0; blk < common; blk++) {
+            for (size_t l = 0; l < n; l++) {
+                uint64_t block[16];
+                const uint8_t* p = data[base + l] + blk * 128;
+                for (int i = 0; i < 16; i++) block[i] = bytes_to_u64(p + i * 8);
+                process_block(state[l], block);
+            }
+        }
+
+        /* Remaining full blocks, the padded last block (0x80, zeros), then finalization */
+        for (size_t l = 0; l < n; l++) {
+            const uint8_t* p = data[base + l];
+            size_t len = lens[base + l];
+            size_t off = common * 128;
+            uint64_t block[16];
+            alignas(32) uint8_t last[128];
+
+            for (; off + 128 <= len; off += 128) {
+                for (int i = 0; i < 16; i++) block[i] = bytes_to_u64(p + off + i * 8);
+                process_block(state[l], block);
+            }
+
+            memset(last, 0, sizeof(last));
+            if (len > off) memcpy(last, p + off, len - off);
+            last[len - off] = 0x80;
+            for (int i = 0; i < 16; i++) block[i] = bytes_to_u64(last + i * 8);
+            process_block(state[l], block);
+            secure_wipe(last, sizeof(last));
+
+            memcpy(&ctx, &init, sizeof(ctx));
+            memcpy(ctx.h, state[l], sizeof(ctx.h));
+            _xz_finalize(&ctx, outputs[base + l]);
+        }
+
+        secure_wipe(state, sizeof(state));
+    }
+
+    xzalgochain_ctx_wipe(&ctx);
+    xzalgochain_ctx_wipe(&init);
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XZ_MULTI_H */
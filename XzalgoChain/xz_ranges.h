@@ -0,0 +1,213 @@
+/*
+ * Byte-Range Hashing (Part of XzalgoChain)
+ * Copyright 2026 Xzrayツ
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XZ_RANGES_H
+#define XZ_RANGES_H
+
+/* Included at the end of XzalgoChain.h; needs xz_file.h and xz_aio.h */
+#include "XzalgoChain.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== TUNABLES ==================== */
+
+/**
+ * XZ_RANGES_MAX_THREADS: Most ranges read and hashed at the same time
+ * Reads are positioned (pread), so the threads share one descriptor; more
+ * requests in flight help on storage with deep queues or high latency
+ */
+#ifndef XZ_RANGES_MAX_THREADS
+    #define XZ_RANGES_MAX_THREADS 8
+#endif
+
+/* ==================== TYPES ==================== */
+
+/** One byte range of a file */
+typedef struct {
+    uint64_t offset; /* First byte */
+    uint64_t length; /* Number of bytes */
+} XzalgoChain_Range;
+
+/* ==================== RANGE READER ==================== */
+
+/**
+ * Hash one byte range with positioned reads
+ *
+ * @param fd Open file descriptor
+ * @param range Range to hash
+ * @param buf Read buffer of XZ_FILE_READ_SIZE bytes
+ * @param output 40-byte buffer for the digest
+ * @return 0 on success, -1 on error (errno set; EINVAL if the range
+ *         reaches past end of file)
+ */
+static inline int _xz_range_hash(int fd, const XzalgoChain_Range* range, uint8_t* buf, uint8_t output[XZALGOCHAIN_HASH_SIZE]) {
+    XzalgoChain_CTX ctx;
+    uint64_t pos = range->offset, left = range->length;
+
+    xzalgochain_init(&ctx);
+    while (left > 0) {
+        size_t want = left < XZ_FILE_READ_SIZE ? (size_t) left : XZ_FILE_READ_SIZE;
+#if defined(XZ_FILE_HAVE_MMAP)
+        ssize_t r = pread(fd, buf, want, (off_t) pos);
+#elif defined(_WIN32)
+        /* No pread(): callers on Windows hash ranges one at a time */
+        int r = _lseeki64(fd, (long long) pos, SEEK_SET) < 0 ? -1 : _read(fd, buf, (unsigned int) want);
+#else
+        ssize_t r = lseek(fd, (off_t) pos, SEEK_SET) < 0 ? -1 : read(fd, buf, want);
+#endif
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) {
+            if (r == 0) errno = EINVAL;
+            int saved_errno = errno;
+            xzalgochain_ctx_wipe(&ctx);
+            errno = saved_errno;
+            return -1;
+        }
+        xzalgochain_update(&ctx, buf, (size_t) r);
+        pos += (uint64_t) r;
+        left -= (uint64_t) r;
+    }
+
+    xzalgochain_final(&ctx, output);
+    xzalgochain_ctx_wipe(&ctx);
+    return 0;
+}
+
+/* Work shared by the range threads */
+typedef struct {
+    int fd;
+    const XzalgoChain_Range* ranges;
+    uint8_t (*outputs)[XZALGOCHAIN_HASH_SIZE];
+    size_t count;
+#if defined(XZ_AIO_HAVE_THREADS)
+    atomic_size_t next;
+    atomic_int error; /* errno of the first failure, 0 if none */
+#else
+    size_t next;
+    int error;
+#endif
+} _xz_ranges;
+
+/**
+ * Thread body: hash ranges in turn until none are left or one fails
+ * @param arg _xz_ranges shared by all threads
+ * @return NULL
+ */
+static inline void* _xz_ranges_worker(void* arg) {
+    _xz_ranges* w = (_xz_ranges*) arg;
+    uint8_t* buf = _xz_file_buf_alloc(XZ_FILE_READ_SIZE);
+
+    for (;;) {
+#if defined(XZ_AIO_HAVE_THREADS)
+        size_t i = atomic_fetch_add(&w->next, 1);
+        if (i >= w->count || atomic_load(&w->error)) break;
+#else
+        size_t i = w->next++;
+        if (i >= w->count || w->error) break;
+#endif
+        int err = !buf ? ENOMEM : _xz_range_hash(w->fd, &w->ranges[i], buf, w->outputs[i]) != 0 ? errno : 0;
+        if (err) {
+#if defined(XZ_AIO_HAVE_THREADS)
+            int none = 0;
+            atomic_compare_exchange_strong(&w->error, &none, err);
+#else
+            w->error = err;
+#endif
+            break;
+        }
+    }
+
+    if (buf) _xz_file_buf_free(buf);
+    return NULL;
+}
+
+/* ==================== RANGE HASHING ==================== */
+
+/**
+ * Hash a list of byte ranges of a file, one digest per range
+ * Ranges are spread over up to XZ_RANGES_MAX_THREADS threads that read
+ * with pread(), so the file offset is neither used nor changed and
+ * requests for different ranges are in flight together. Each digest
+ * equals xzalgochain() over the bytes of its range; ranges may overlap,
+ * come in any order, and be empty. Without threads (Windows, WASM, C++)
+ * the ranges are hashed one after another.
+ *
+ * @param fd Open file descriptor (regular file or block device)
+ * @param ranges Byte ranges to hash
+ * @param count Number of ranges
+ * @param outputs One 40-byte digest per range
+ * @return 0 on success, -1 on error (errno set; EINVAL for invalid
+ *         arguments or a range that reaches past end of file)
+ */
+static inline int xzalgochain_file_ranges(int fd, const XzalgoChain_Range* ranges, size_t count,
+                                          uint8_t (*outputs)[XZALGOCHAIN_HASH_SIZE]) {
+    if (fd < 0 || (count > 0 && (!ranges || !outputs))) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (ranges[i].offset > UINT64_MAX - ranges[i].length || ranges[i].offset + ranges[i].length > (uint64_t) INT64_MAX) {
+            errno = EINVAL;
+            return -1;
+        }
+    }
+
+    _xz_ranges w;
+    memset(&w, 0, sizeof(w));
+    w.fd = fd;
+    w.ranges = ranges;
+    w.outputs = outputs;
+    w.count = count;
+
+#if defined(XZ_AIO_HAVE_THREADS)
+    atomic_init(&w.next, 0);
+    atomic_init(&w.error, 0);
+
+    /* The caller is one of the threads */
+    pthread_t threads[XZ_RANGES_MAX_THREADS];
+    size_t want = count < XZ_RANGES_MAX_THREADS ? count : XZ_RANGES_MAX_THREADS;
+    size_t started = 0;
+    while (started + 1 < want && pthread_create(&threads[started], NULL, _xz_ranges_worker, &w) == 0)
+        started++;
+    _xz_ranges_worker(&w);
+    for (size_t t = 0; t < started; t++)
+        pthread_join(threads[t], NULL);
+
+    int error = atomic_load(&w.error);
+#else
+    _xz_ranges_worker(&w);
+    int error = w.error;
+#endif
+
+    if (error) {
+        errno = error;
+        return -1;
+    }
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XZ_RANGES_H */
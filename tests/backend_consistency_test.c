@@ -0,0 +1,251 @@
+/*
+ * backend_consistency_test.c
+ *
+ * Backend Consistency Test
+ *
+ * Purpose:
+ *   Checks that every backend compiled into this build produces output
+ *   bit-identical to the scalar reference:
+ *     1. Single-block scalar specialization against the general scalar path
+ *     2. LITTLE box executors on 1..9 blocks (partial and full groups of 4)
+ *     3. Full digests via xzalgochain_init_ex() for many message lengths
+ *     4. xzalgochain_many() against xzalgochain(), for batches whose lanes
+ *        have different, equal and empty lengths and a partial last group
+ *     5. xzalgochain_to_hex()/xzalgochain_from_hex() (SIMD in this build, if
+ *        any) against a printf reference, in both cases, and rejection of
+ *        every non-hex character at every position
+ *
+ * Usage:
+ *   Compile: clang -O3 -march=native -mtune=native -flto=full -fopenmp -lm -o backend_consistency_test backend_consistency_test.c
+ *
+ *   Run:
+ *     ./backend_consistency_test
+ *
+ * Author: Xzrayツ
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include "../XzalgoChain/XzalgoChain.h"
+
+/* ======================== CONFIGURATION ======================== */
+#define MAX_BLOCKS 9        /* LITTLE box executor calls cover 1..MAX_BLOCKS blocks */
+#define EXEC_TRIALS 2000    /* Random inputs per block count */
+#define MAX_MSG_LEN 1100    /* Digest test covers lengths 0..MAX_MSG_LEN-1 */
+
+/* ======================== EXECUTORS ======================== */
+typedef void (*executor_fn)(uint64_t*, uint64_t, uint64_t, size_t);
+
+typedef struct {
+    int backend;
+    executor_fn fn;
+} executor_entry;
+
+static const executor_entry executors[] = {
+#if defined(XZALGOCHAIN_HAVE_AVX2)
+    {XZ_BACKEND_AVX2, little_box_execute_simd_avx2},
+#endif
+#if defined(XZALGOCHAIN_HAVE_SSE2)
+    {XZ_BACKEND_SSE2, little_box_execute_simd_sse2},
+#endif
+#if defined(XZALGOCHAIN_HAVE_NEON)
+    {XZ_BACKEND_NEON, little_box_execute_simd_neon},
+#endif
+#if defined(XZALGOCHAIN_HAVE_WASM_SIMD)
+    {XZ_BACKEND_WASM, little_box_execute_simd_wasm},
+#endif
+#if defined(XZALGOCHAIN_HAVE_VECEXT)
+    {XZ_BACKEND_VECEXT, little_box_execute_simd_vecext},
+#endif
+    {XZ_BACKEND_SCALAR, little_box_execute_scalar},
+};
+
+#define NUM_EXECUTORS (sizeof(executors) / sizeof(executors[0]))
+
+/* ======================== UTILITY FUNCTIONS ======================== */
+static uint64_t rng_state = 0x853C49E6748FEA9BULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/* ======================== TESTS ======================== */
+static int test_single_block(void) {
+    uint64_t ref[10], out[10];
+    int mismatches = 0;
+
+    for (int t = 0; t < EXEC_TRIALS * MAX_BLOCKS; t++) {
+        uint64_t salt = next_rand();
+        uint64_t round_base = next_rand() & 0xFFFF;
+        for (int i = 0; i < 10; i++) ref[i] = out[i] = next_rand();
+
+        little_box_execute_scalar(ref, salt, round_base, 1);
+        little_box_execute_scalar_single(out, salt, round_base);
+
+        if (memcmp(ref, out, sizeof(ref)) != 0) mismatches++;
+    }
+
+    printf("  %-8s single:   %s (%d mismatches)\n", "Scalar", mismatches ? "FAIL" : "PASS", mismatches);
+    return mismatches;
+}
+
+static int test_executors(void) {
+    uint64_t ref[MAX_BLOCKS * 10], out[MAX_BLOCKS * 10];
+    int failures = 0;
+
+    for (size_t e = 0; e < NUM_EXECUTORS; e++) {
+        int backend = executors[e].backend;
+        if (backend == XZ_BACKEND_SCALAR || !xzalgochain_backend_available(backend)) continue;
+
+        int mismatches = 0;
+        for (size_t blocks = 1; blocks <= MAX_BLOCKS; blocks++) {
+            for (int t = 0; t < EXEC_TRIALS; t++) {
+                uint64_t salt = next_rand();
+                uint64_t round_base = next_rand() & 0xFFFF;
+                for (size_t i = 0; i < blocks * 10; i++) ref[i] = out[i] = next_rand();
+
+                little_box_execute_scalar(ref, salt, round_base, blocks);
+                executors[e].fn(out, salt, round_base, blocks);
+
+                if (memcmp(ref, out, blocks * 10 * sizeof(uint64_t)) != 0) mismatches++;
+            }
+        }
+
+        printf("  %-8s executor: %s (%d mismatches)\n", xzalgochain_backend_name(backend),
+               mismatches ? "FAIL" : "PASS", mismatches);
+        failures += mismatches;
+    }
+    return failures;
+}
+
+static int test_digests(void) {
+    uint8_t* msg = malloc(MAX_MSG_LEN);
+    uint8_t ref[XZALGOCHAIN_HASH_SIZE], out[XZALGOCHAIN_HASH_SIZE];
+    XzalgoChain_CTX ctx;
+    int failures = 0;
+
+    if (!msg) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return 1;
+    }
+    for (size_t i = 0; i < MAX_MSG_LEN; i++) msg[i] = (uint8_t) next_rand();
+
+    for (int backend = XZ_BACKEND_SCALAR + 1; backend < XZ_BACKEND_COUNT; backend++) {
+        if (!xzalgochain_backend_available(backend)) {
+            printf("  %-8s digests:  SKIP (not available)\n", xzalgochain_backend_name(backend));
+            continue;
+        }
+
+        int mismatches = 0;
+        for (size_t len = 0; len < MAX_MSG_LEN; len++) {
+            xzalgochain_init_ex(&ctx, XZ_BACKEND_SCALAR);
+            xzalgochain_update(&ctx, msg, len);
+            xzalgochain_final(&ctx, ref);
+
+            xzalgochain_init_ex(&ctx, backend);
+            xzalgochain_update(&ctx, msg, len);
+            xzalgochain_final(&ctx, out);
+
+            if (memcmp(ref, out, sizeof(ref)) != 0) mismatches++;
+        }
+
+        printf("  %-8s digests:  %s (%d mismatches)\n", xzalgochain_backend_name(backend),
+               mismatches ? "FAIL" : "PASS", mismatches);
+        failures += mismatches;
+    }
+
+    free(msg);
+    return failures;
+}
+
+static int test_many(void) {
+    const size_t count = 3 * XZ_MULTI_LANES + 3; /* Partial last group */
+    uint8_t* msg = malloc(MAX_MSG_LEN);
+    const uint8_t** data = malloc(count * sizeof(*data));
+    size_t* lens = malloc(count * sizeof(*lens));
+    uint8_t (*out)[XZALGOCHAIN_HASH_SIZE] = malloc(count * sizeof(*out));
+    uint8_t ref[XZALGOCHAIN_HASH_SIZE];
+    int mismatches = 0;
+
+    if (!msg || !data || !lens || !out) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(msg);
+        free(data);
+        free(lens);
+        free(out);
+        return 1;
+    }
+    for (size_t i = 0; i < MAX_MSG_LEN; i++) msg[i] = (uint8_t) next_rand();
+
+    for (int trial = 0; trial < 200; trial++) {
+        for (size_t i = 0; i < count; i++) {
+            /* Mostly random lengths; some trials give every lane the same length */
+            lens[i] = trial % 4 == 0 ? (size_t) trial % MAX_MSG_LEN : next_rand() % MAX_MSG_LEN;
+            data[i] = lens[i] ? msg + next_rand() % (MAX_MSG_LEN - lens[i] + 1) : NULL;
+        }
+        if (xzalgochain_many(data, lens, count, out) != 0) mismatches++;
+
+        for (size_t i = 0; i < count; i++) {
+            xzalgochain(data[i] ? data[i] : msg, lens[i], ref);
+            if (memcmp(ref, out[i], sizeof(ref)) != 0) mismatches++;
+        }
+    }
+
+    printf("  %-8s digests:  %s (%d mismatches)\n", "many", mismatches ? "FAIL" : "PASS", mismatches);
+    free(msg);
+    free(data);
+    free(lens);
+    free(out);
+    return mismatches;
+}
+
+static int test_hex(void) {
+    uint8_t bytes[100], back[100];
+    char hex[201], ref[201];
+    int mismatches = 0;
+
+    for (size_t len = 0; len <= 100; len++) {
+        for (size_t i = 0; i < len; i++) bytes[i] = (uint8_t) next_rand();
+        for (size_t i = 0; i < len; i++) snprintf(ref + 2 * i, 3, "%02x", bytes[i]);
+
+        xzalgochain_to_hex(bytes, len, hex);
+        if (memcmp(hex, ref, 2 * len) != 0) mismatches++;
+        if (xzalgochain_from_hex(hex, len, back) != 0 || memcmp(back, bytes, len) != 0) mismatches++;
+
+        /* Upper case decodes to the same bytes */
+        for (size_t i = 0; i < 2 * len; i++)
+            if (hex[i] >= 'a') hex[i] = (char) (hex[i] - 'a' + 'A');
+        if (xzalgochain_from_hex(hex, len, back) != 0 || memcmp(back, bytes, len) != 0) mismatches++;
+    }
+
+    /* Every non-hex byte value is rejected wherever it appears in a digest */
+    xzalgochain_to_hex(bytes, XZALGOCHAIN_HASH_SIZE, hex);
+    for (int c = 0; c < 256; c++) {
+        int is_hex = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        for (size_t pos = 0; pos < XZALGOCHAIN_HASH_SIZE * 2; pos++) {
+            char saved = hex[pos];
+            hex[pos] = (char) c;
+            if ((xzalgochain_from_hex(hex, XZALGOCHAIN_HASH_SIZE, back) == 0) != is_hex) mismatches++;
+            hex[pos] = saved;
+        }
+    }
+
+    printf("  %-8s encoding: %s (%d mismatches)\n", "hex", mismatches ? "FAIL" : "PASS", mismatches);
+    return mismatches;
+}
+
+/* ======================== MAIN ======================== */
+int main(void) {
+    printf("===== Backend Consistency Test =====\n");
+    printf("Reference: Scalar\n\n");
+
+    int failures = test_single_block() + test_executors() + test_digests() + test_many() + test_hex();
+
+    printf("\nResult: %s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,120 @@
+#!/bin/sh
+
+# XzalgoChain - Digest cache test (xzalgo320sum --cache)
+#
+# Usage: tests/cache_test.sh ./xzalgo320sum
+#
+# Checks, through the command line:
+#   1. A file changed within the settle window is not stored; once settled
+#      it is stored and the next run is a hit with the same digest
+#   2. A same-size rewrite with the old mtime restored misses (ctime moved)
+#   3. A dirty or damaged header empties the cache instead of being trusted
+#   4. --verify-cache 100 rehashes every hit and fails on a flipped digest
+#
+# The cache layout it pokes at: a 64-byte header (dirty flag at offset 16),
+# then 80-byte slots (dev, ino, size, mtime, ctime, 40-byte digest).
+
+set -u
+
+BIN=${1:-./xzalgo320sum}
+case $BIN in /*) ;; *) BIN=$(pwd)/$BIN ;; esac
+
+TMP=$(mktemp -d) || exit 1
+trap 'rm -rf "$TMP"' EXIT
+cd "$TMP" || exit 1
+
+FAILED=0
+
+check() {
+    if [ "$2" = "$3" ]; then
+        echo "  ok    $1"
+    else
+        echo "  FAIL  $1: got '$2', expected '$3'"
+        FAILED=1
+    fi
+}
+
+# Hit count reported by a verbose --cache run; extra arguments go to the binary
+hits() {
+    "$BIN" -V --cache cache "$@" 2>&1 >/dev/null | sed -n 's/^Cache: \([0-9]*\) hits.*/\1/p'
+}
+
+# Entry count the cache had when a verbose run opened it
+entries() {
+    "$BIN" -V --cache cache "$@" 2>&1 >/dev/null | sed -n 's/^Cache cache: \([0-9]*\) entries.*/\1/p'
+}
+
+digest() {
+    "$BIN" "$@" | cut -d' ' -f1
+}
+
+# Overwrite one byte of the cache file: poke OFFSET VALUE
+poke() {
+    printf "\\$(printf %o "$2")" | dd of=cache bs=1 seek="$1" conv=notrunc 2>/dev/null
+}
+
+# Byte value of the cache file at OFFSET
+peek() {
+    od -An -tu1 -j "$1" -N 1 cache | tr -d ' '
+}
+
+# Offset of the digest in the only used slot
+slot_digest() {
+    od -An -v -tu1 cache | awk '
+        { for (i = 1; i <= NF; i++) { if (n >= 64 && $i != 0 && !s) s = n; n++ } }
+        END { print 64 + int((s - 64) / 80) * 80 + 40 }'
+}
+
+echo "Cache test"
+
+printf 'cached file\n' > a
+printf 'other file\n' > b
+A=$(digest a)
+
+echo "1. Settle window"
+check "fresh file is not stored" "$(hits a b)" 0
+check "fresh file still misses" "$(hits a b)" 0
+sleep 3
+check "settled files are stored" "$(hits a b)" 0
+check "settled files hit" "$(hits a b)" 2
+check "hit prints the same digest" "$("$BIN" --cache cache a | cut -d' ' -f1)" "$A"
+
+echo "2. Content change"
+cp -p a ref
+printf 'cached filE\n' > a
+touch -r ref a
+check "same-size rewrite misses" "$(hits a b)" 1
+check "rewrite prints the new digest" "$("$BIN" --cache cache a | cut -d' ' -f1)" "$(digest a)"
+sleep 3
+check "rewrite is stored once settled" "$(hits a b)" 1
+check "rewrite hits" "$(hits a b)" 2
+
+echo "3. Header"
+check "clean cache keeps its entries" "$(entries a b)" 2
+poke 16 1
+check "dirty cache is emptied" "$(entries a b)" 0
+check "emptied cache is refilled" "$(hits a b)" 2
+poke 0 0
+check "bad magic empties the cache" "$(entries a b)" 0
+check "emptied cache is refilled" "$(hits a b)" 2
+dd if=cache of=short bs=100 count=1 2>/dev/null && mv short cache
+check "truncated cache is emptied" "$(entries a b)" 0
+
+echo "4. --verify-cache"
+rm -f cache b
+"$BIN" --cache cache a >/dev/null
+check "one entry" "$(entries a)" 1
+OFF=$(slot_digest)
+poke "$OFF" $(($(peek "$OFF") ^ 1))
+A=$(digest a)
+check "without --verify-cache the flipped digest is printed" "$(digest --cache cache a | grep -c "$A")" 0
+"$BIN" --cache cache --verify-cache 100 a > out 2> err
+check "--verify-cache 100 fails" "$?" 1
+check "... reports the file" "$(grep -c 'cached digest differs' err)" 1
+check "... prints the rehashed digest" "$(cut -d' ' -f1 out)" "$(digest a)"
+
+if [ $FAILED -ne 0 ]; then
+    echo "Cache test FAILED"
+    exit 1
+fi
+echo "Cache test passed"
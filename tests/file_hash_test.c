@@ -0,0 +1,458 @@
+/*
+ * file_hash_test.c
+ *
+ * File Hashing Test
+ *
+ * Purpose:
+ *   Checks that xzalgochain_file() / xzalgochain_fd() and the read pipeline
+ *   (xzalgochain_file_aio() / xzalgochain_update_fd_aio()) return the same
+ *   digest as one-shot hashing of the same bytes:
+ *     1. Files around the mmap threshold and window size, mapped and read
+ *     2. Files through the pipeline: io_uring and reader thread, O_DIRECT,
+ *        queue depths and buffer sizes that split the file unevenly
+ *     3. Descriptors positioned at a non-zero, unaligned offset
+ *     4. Pipes (read path and reader thread)
+ *     5. Errors on missing files
+ *     6. Sparse files: holes skipped with SEEK_DATA/SEEK_HOLE give the
+ *        digest of a dense read, and xzalgochain_update_zeros() matches
+ *        xzalgochain_update() on zero bytes at every buffer position
+ *     7. Byte ranges (xzalgochain_file_ranges()): each digest equals one-shot
+ *        hashing of its slice, for overlapping, empty and unordered ranges,
+ *        more ranges than threads, and EINVAL past end of file
+ *   and that binary manifests (xz_manifest.h) round-trip:
+ *     8. Every entry is found by path and by digest, duplicates included
+ *     9. Truncated or foreign files are rejected
+ *   The mmap threshold and window are shrunk so that multi-window files stay small.
+ *
+ * Usage:
+ *   Compile: clang -O3 -march=native -mtune=native -flto=full -fopenmp -lm -o file_hash_test file_hash_test.c
+ *
+ *   Run:
+ *     ./file_hash_test
+ *
+ * Author: Xzrayツ
+ */
+
+#define _GNU_SOURCE
+#define XZ_FILE_MMAP_THRESHOLD (16 * 1024)
+#define XZ_FILE_MMAP_WINDOW (64 * 1024)
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../XzalgoChain/XzalgoChain.h"
+
+/* ======================== CONFIGURATION ======================== */
+#define MAX_FILE_SIZE (3 * XZ_FILE_MMAP_WINDOW + 777)
+
+static const size_t file_sizes[] = {
+    0, 1, 40, 4095, 4096, 4097,
+    XZ_FILE_MMAP_THRESHOLD - 1, XZ_FILE_MMAP_THRESHOLD, XZ_FILE_MMAP_THRESHOLD + 1,
+    XZ_FILE_MMAP_WINDOW - 1, XZ_FILE_MMAP_WINDOW, XZ_FILE_MMAP_WINDOW + 1,
+    2 * XZ_FILE_MMAP_WINDOW, MAX_FILE_SIZE,
+};
+
+#define NUM_SIZES (sizeof(file_sizes) / sizeof(file_sizes[0]))
+
+/* Pipeline settings: queue depth, buffer size, flags */
+static const struct {
+    unsigned int depth;
+    size_t buffer_size;
+    int flags;
+} aio_configs[] = {
+    {0, 0, XZ_AIO_DEFAULT},
+    {2, 4096, XZ_AIO_DEFAULT},
+    {3, 12288, XZ_AIO_NO_URING},
+    {5, 20000, XZ_AIO_DEFAULT}, /* Rounded up to 20480 */
+    {4, 8192, XZ_AIO_DIRECT},
+    {2, 4096, XZ_AIO_DIRECT | XZ_AIO_NO_URING},
+};
+
+#define NUM_AIO_CONFIGS (sizeof(aio_configs) / sizeof(aio_configs[0]))
+
+/* ======================== UTILITY FUNCTIONS ======================== */
+static uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+
+static uint64_t next_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static int write_file(const char* path, const uint8_t* data, size_t len) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return -1;
+    size_t w = fwrite(data, 1, len, f);
+    return (fclose(f) == 0 && w == len) ? 0 : -1;
+}
+
+/* ======================== TESTS ======================== */
+static int test_files(const char* path, const uint8_t* data) {
+    uint8_t ref[XZALGOCHAIN_HASH_SIZE], out[XZALGOCHAIN_HASH_SIZE];
+    int failures = 0;
+
+    for (size_t s = 0; s < NUM_SIZES; s++) {
+        size_t len = file_sizes[s];
+        if (write_file(path, data, len) != 0) {
+            fprintf(stderr, "Cannot write %s\n", path);
+            return 1;
+        }
+        xzalgochain(data, len, ref);
+
+        /* Default (mmap above the threshold) and read-only paths */
+        int mismatches = 0;
+        static const int flags[] = {XZ_FILE_DEFAULT, XZ_FILE_NO_MMAP, XZ_FILE_HUGEPAGES};
+        for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+            memset(out, 0, sizeof(out));
+            if (xzalgochain_file(path, out, flags[f]) != 0 || memcmp(ref, out, sizeof(ref)) != 0)
+                mismatches++;
+        }
+
+        /* Read pipeline */
+        for (size_t c = 0; c < NUM_AIO_CONFIGS; c++) {
+            memset(out, 0, sizeof(out));
+            if (xzalgochain_file_aio(path, out, aio_configs[c].depth, aio_configs[c].buffer_size, aio_configs[c].flags) != 0 ||
+                memcmp(ref, out, sizeof(ref)) != 0)
+                mismatches++;
+        }
+
+        /* Unaligned start offset: only the rest of the file is hashed */
+        size_t offset = len / 3 + 1;
+        if (offset <= len) {
+            int fd = open(path, O_RDONLY);
+            uint64_t total = 0;
+            XzalgoChain_CTX ctx;
+            xzalgochain_init(&ctx);
+            if (fd < 0 || lseek(fd, (off_t) offset, SEEK_SET) < 0 ||
+                xzalgochain_update_fd(&ctx, fd, XZ_FILE_DEFAULT, &total) != 0 || total != len - offset ||
+                lseek(fd, 0, SEEK_CUR) != (off_t) len)
+                mismatches++;
+            xzalgochain_final(&ctx, out);
+            xzalgochain(data + offset, len - offset, ref);
+            if (memcmp(ref, out, sizeof(ref)) != 0) mismatches++;
+
+            /* Same through the pipeline, with O_DIRECT reading from an aligned offset before it */
+            for (size_t c = 0; c < NUM_AIO_CONFIGS && fd >= 0; c++) {
+                xzalgochain_init(&ctx);
+                if (lseek(fd, (off_t) offset, SEEK_SET) < 0 ||
+                    xzalgochain_update_fd_aio(&ctx, fd, aio_configs[c].depth, aio_configs[c].buffer_size, aio_configs[c].flags, &total) != 0 ||
+                    total != len - offset || lseek(fd, 0, SEEK_CUR) != (off_t) len)
+                    mismatches++;
+                xzalgochain_final(&ctx, out);
+                if (memcmp(ref, out, sizeof(ref)) != 0) mismatches++;
+            }
+            if (fd >= 0) close(fd);
+        }
+
+        printf("  file %-8zu %s (%d mismatches)\n", len, mismatches ? "FAIL" : "PASS", mismatches);
+        failures += mismatches;
+    }
+    return failures;
+}
+
+static int test_pipe(const uint8_t* data) {
+    uint8_t ref[XZALGOCHAIN_HASH_SIZE], out[XZALGOCHAIN_HASH_SIZE];
+    int fds[2];
+    const size_t len = 12345; /* Fits in the pipe buffer, no writer thread needed */
+
+    if (pipe(fds) != 0 || write(fds[1], data, len) != (ssize_t) len) {
+        fprintf(stderr, "Cannot set up pipe\n");
+        return 1;
+    }
+    close(fds[1]);
+
+    xzalgochain(data, len, ref);
+    int mismatches = xzalgochain_fd(fds[0], out, XZ_FILE_DEFAULT) != 0 || memcmp(ref, out, sizeof(ref)) != 0;
+    close(fds[0]);
+
+    /* Reader thread on a pipe, with buffers smaller than the data */
+    if (pipe(fds) != 0 || write(fds[1], data, len) != (ssize_t) len) {
+        fprintf(stderr, "Cannot set up pipe\n");
+        return 1;
+    }
+    close(fds[1]);
+
+    XzalgoChain_CTX ctx;
+    uint64_t total = 0;
+    xzalgochain_init(&ctx);
+    if (xzalgochain_update_fd_aio(&ctx, fds[0], 3, 4096, XZ_AIO_DEFAULT, &total) != 0 || total != len) mismatches++;
+    xzalgochain_final(&ctx, out);
+    if (memcmp(ref, out, sizeof(ref)) != 0) mismatches++;
+    close(fds[0]);
+
+    printf("  pipe %-8zu %s\n", len, mismatches ? "FAIL" : "PASS");
+    return mismatches;
+}
+
+static int test_errors(void) {
+    uint8_t out[XZALGOCHAIN_HASH_SIZE];
+    int failures = 0;
+
+    errno = 0;
+    if (xzalgochain_file("/nonexistent/xzalgochain", out, XZ_FILE_DEFAULT) != -1 || errno != ENOENT) failures++;
+    if (xzalgochain_fd(-1, out, XZ_FILE_DEFAULT) != -1) failures++;
+    errno = 0;
+    if (xzalgochain_file_aio("/nonexistent/xzalgochain", out, 0, 0, XZ_AIO_DEFAULT) != -1 || errno != ENOENT) failures++;
+    if (xzalgochain_file_aio("/dev/null", out, XZ_AIO_MAX_DEPTH + 1, 0, XZ_AIO_DEFAULT) != -1 || errno != EINVAL) failures++;
+
+    printf("  errors        %s\n", failures ? "FAIL" : "PASS");
+    return failures;
+}
+
+static int test_zeros(void) {
+    static const uint8_t zeros[1000] = {0};
+    static const uint8_t prefix[200] = {1, 2, 3};
+    static const size_t prefix_lens[] = {0, 1, 127, 128, 129, 200};
+    static const size_t zero_lens[] = {0, 1, 126, 127, 128, 129, 255, 256, 999, 1000};
+    uint8_t ref[XZALGOCHAIN_HASH_SIZE], out[XZALGOCHAIN_HASH_SIZE];
+    int failures = 0;
+
+    for (size_t p = 0; p < sizeof(prefix_lens) / sizeof(prefix_lens[0]); p++) {
+        for (size_t z = 0; z < sizeof(zero_lens) / sizeof(zero_lens[0]); z++) {
+            XzalgoChain_CTX a, b;
+            xzalgochain_init(&a);
+            xzalgochain_init(&b);
+            xzalgochain_update(&a, prefix, prefix_lens[p]);
+            xzalgochain_update(&b, prefix, prefix_lens[p]);
+            xzalgochain_update(&a, zeros, zero_lens[z]);
+            xzalgochain_update_zeros(&b, zero_lens[z]);
+            xzalgochain_update(&a, prefix, 3);
+            xzalgochain_update(&b, prefix, 3);
+            xzalgochain_final(&a, ref);
+            xzalgochain_final(&b, out);
+            if (memcmp(ref, out, sizeof(ref)) != 0) failures++;
+        }
+    }
+
+    printf("  zero runs     %s (%d mismatches)\n", failures ? "FAIL" : "PASS", failures);
+    return failures;
+}
+
+static int test_sparse(const char* path, const uint8_t* data) {
+    /* Data extents of each layout, at page multiples so that the rest can be holes */
+    static const struct {
+        size_t size;
+        size_t extents[4][2]; /* offset, length; length 0 ends the list */
+    } layouts[] = {
+        {MAX_FILE_SIZE, {{0}}},                                    /* All hole */
+        {MAX_FILE_SIZE, {{65536, 4096}}},                          /* Hole, data, hole */
+        {MAX_FILE_SIZE, {{0, 8192}, {MAX_FILE_SIZE - 777, 777}}},  /* Data, hole, short tail */
+        {MAX_FILE_SIZE, {{4096, 40960}, {131072, 12288}, {0}}},    /* Extents above the mmap threshold */
+        {3 * 4096, {{4096, 4096}}},                                /* Below XZ_FILE_SPARSE_MIN */
+    };
+    uint8_t ref[XZALGOCHAIN_HASH_SIZE], out[XZALGOCHAIN_HASH_SIZE];
+    uint8_t* dense = calloc(1, MAX_FILE_SIZE);
+    int failures = 0, holes = 0;
+
+    if (!dense) return 1;
+
+    for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++) {
+        const size_t size = layouts[l].size;
+        int fd = open(path, O_RDWR | O_TRUNC);
+        int mismatches = fd < 0 || ftruncate(fd, (off_t) size) != 0;
+
+        memset(dense, 0, size);
+        for (int e = 0; e < 4 && layouts[l].extents[e][1] > 0 && !mismatches; e++) {
+            const size_t off = layouts[l].extents[e][0], len = layouts[l].extents[e][1];
+            memcpy(dense + off, data + off, len);
+            if (pwrite(fd, data + off, len, (off_t) off) != (ssize_t) len) mismatches++;
+        }
+        if (fd >= 0) {
+            off_t hole = lseek(fd, 0, SEEK_HOLE);
+            if (hole >= 0 && (size_t) hole < size) holes++;
+            close(fd);
+        }
+        if (mismatches) {
+            fprintf(stderr, "Cannot write %s\n", path);
+            free(dense);
+            return 1;
+        }
+        xzalgochain(dense, size, ref);
+
+        /* Hole-aware, read-only, and dense paths, then the pipeline */
+        static const int flags[] = {XZ_FILE_DEFAULT, XZ_FILE_NO_MMAP, XZ_FILE_NO_SPARSE};
+        for (size_t f = 0; f < sizeof(flags) / sizeof(flags[0]); f++) {
+            memset(out, 0, sizeof(out));
+            if (xzalgochain_file(path, out, flags[f]) != 0 || memcmp(ref, out, sizeof(ref)) != 0) mismatches++;
+        }
+        for (size_t c = 0; c < NUM_AIO_CONFIGS; c++) {
+            memset(out, 0, sizeof(out));
+            if (xzalgochain_file_aio(path, out, aio_configs[c].depth, aio_configs[c].buffer_size, aio_configs[c].flags) != 0 ||
+                memcmp(ref, out, sizeof(ref)) != 0)
+                mismatches++;
+        }
+
+        /* Unaligned start offset inside a hole or extent; the offset ends at end of file */
+        const size_t offset = size / 3 + 1;
+        uint64_t total = 0;
+        XzalgoChain_CTX ctx;
+        xzalgochain_init(&ctx);
+        fd = open(path, O_RDONLY);
+        if (fd < 0 || lseek(fd, (off_t) offset, SEEK_SET) < 0 ||
+            xzalgochain_update_fd(&ctx, fd, XZ_FILE_DEFAULT, &total) != 0 || total != size - offset ||
+            lseek(fd, 0, SEEK_CUR) != (off_t) size)
+            mismatches++;
+        if (fd >= 0) close(fd);
+        xzalgochain_final(&ctx, out);
+        xzalgochain(dense + offset, size - offset, ref);
+        if (memcmp(ref, out, sizeof(ref)) != 0) mismatches++;
+
+        printf("  sparse %-6zu %s (%d mismatches)\n", l, mismatches ? "FAIL" : "PASS", mismatches);
+        failures += mismatches;
+    }
+
+    /* Filesystems without hole support still pass, through the dense path */
+    if (!holes) printf("  (no holes reported by this filesystem)\n");
+    free(dense);
+    return failures;
+}
+
+static int test_ranges(const char* path, const uint8_t* data) {
+    enum { NUM_RANGES = 3 * XZ_RANGES_MAX_THREADS + 1 };
+    XzalgoChain_Range ranges[NUM_RANGES];
+    uint8_t outputs[NUM_RANGES][XZALGOCHAIN_HASH_SIZE];
+    uint8_t ref[XZALGOCHAIN_HASH_SIZE];
+    int failures = 0;
+
+    if (write_file(path, data, MAX_FILE_SIZE) != 0) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 1;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 1;
+
+    /* Fixed edge cases first, then random ranges in no particular order */
+    ranges[0] = (XzalgoChain_Range){0, MAX_FILE_SIZE};
+    ranges[1] = (XzalgoChain_Range){MAX_FILE_SIZE, 0};
+    ranges[2] = (XzalgoChain_Range){MAX_FILE_SIZE - 1, 1};
+    ranges[3] = (XzalgoChain_Range){12345, 0};
+    ranges[4] = (XzalgoChain_Range){1, XZ_FILE_MMAP_WINDOW + 1};
+    for (size_t i = 5; i < NUM_RANGES; i++) {
+        uint64_t offset = next_rand() % MAX_FILE_SIZE;
+        ranges[i] = (XzalgoChain_Range){offset, next_rand() % (MAX_FILE_SIZE - offset + 1)};
+    }
+
+    memset(outputs, 0, sizeof(outputs));
+    if (lseek(fd, 777, SEEK_SET) != 777 || xzalgochain_file_ranges(fd, ranges, NUM_RANGES, outputs) != 0 ||
+        lseek(fd, 0, SEEK_CUR) != 777) {
+        failures++;
+    } else {
+        for (size_t i = 0; i < NUM_RANGES; i++) {
+            xzalgochain(data + ranges[i].offset, (size_t) ranges[i].length, ref);
+            if (memcmp(ref, outputs[i], sizeof(ref)) != 0) failures++;
+        }
+    }
+
+    /* One range past end of file fails the call */
+    ranges[NUM_RANGES / 2] = (XzalgoChain_Range){MAX_FILE_SIZE - 10, 11};
+    errno = 0;
+    if (xzalgochain_file_ranges(fd, ranges, NUM_RANGES, outputs) != -1 || errno != EINVAL) failures++;
+    if (xzalgochain_file_ranges(fd, NULL, 0, NULL) != 0) failures++;
+    errno = 0;
+    if (xzalgochain_file_ranges(-1, ranges, 1, outputs) != -1 || errno != EINVAL) failures++;
+    close(fd);
+
+    printf("  ranges        %s (%d mismatches)\n", failures ? "FAIL" : "PASS", failures);
+    return failures;
+}
+
+static int test_manifest(const char* path) {
+    enum { COUNT = 1000 };
+    static uint8_t digests[COUNT][XZALGOCHAIN_HASH_SIZE];
+    static char names[COUNT][32];
+    const char* paths[COUNT];
+    XzalgoChain_Manifest m;
+    int failures = 0;
+
+    /* Every seventh entry repeats an earlier digest, as identical files do */
+    for (size_t i = 0; i < COUNT; i++) {
+        snprintf(names[i], sizeof(names[i]), i % 3 ? "dir/file-%zu" : "dir\\odd name\n%zu", i);
+        paths[i] = names[i];
+        if (i % 7 == 6)
+            memcpy(digests[i], digests[i - 3], XZALGOCHAIN_HASH_SIZE);
+        else
+            xzalgochain((const uint8_t*) names[i], strlen(names[i]), digests[i]);
+    }
+
+    if (xzalgochain_manifest_write(path, (const uint8_t (*)[XZALGOCHAIN_HASH_SIZE]) digests, paths, COUNT) != 0 ||
+        xzalgochain_manifest_open(path, &m) != 0) {
+        fprintf(stderr, "Cannot write or open %s\n", path);
+        return 1;
+    }
+
+    /* The digest table holds digests only: 40-byte records */
+    if (m.count != COUNT || sizeof(XzalgoChain_ManifestRecord) != XZALGOCHAIN_HASH_SIZE) failures++;
+    for (size_t i = 1; i < m.count; i++)
+        if (memcmp(m.records[i - 1].digest, m.records[i].digest, XZALGOCHAIN_HASH_SIZE) > 0) failures++;
+
+    for (size_t i = 0; i < COUNT; i++) {
+        const XzalgoChain_ManifestRecord* r = xzalgochain_manifest_find_path(&m, paths[i]);
+        const char* p = r ? xzalgochain_manifest_path(&m, r) : NULL;
+        if (!p || strcmp(p, paths[i]) != 0 || memcmp(r->digest, digests[i], XZALGOCHAIN_HASH_SIZE) != 0) failures++;
+
+        /* The digest search lands on the first of a run of equal digests that includes this path */
+        r = xzalgochain_manifest_find_digest(&m, digests[i]);
+        if (!r || (r > m.records && memcmp(r[-1].digest, digests[i], XZALGOCHAIN_HASH_SIZE) == 0)) {
+            failures++;
+            continue;
+        }
+        while (r < m.records + m.count && memcmp(r->digest, digests[i], XZALGOCHAIN_HASH_SIZE) == 0 &&
+               strcmp(xzalgochain_manifest_path(&m, r), paths[i]) != 0)
+            r++;
+        if (r == m.records + m.count || memcmp(r->digest, digests[i], XZALGOCHAIN_HASH_SIZE) != 0) failures++;
+    }
+
+    uint8_t missing[XZALGOCHAIN_HASH_SIZE];
+    memset(missing, 0xff, sizeof(missing));
+    if (xzalgochain_manifest_find_path(&m, "dir/file-1000") || xzalgochain_manifest_find_digest(&m, missing)) failures++;
+    size_t size = m.size;
+    xzalgochain_manifest_close(&m);
+
+    /* A manifest cut short, and a file that is not a manifest */
+    errno = 0;
+    if (truncate(path, (off_t) size - 1) != 0 || xzalgochain_manifest_open(path, &m) != -1 || errno != EINVAL) failures++;
+    errno = 0;
+    if (write_file(path, (const uint8_t*) names[0], sizeof(names)) != 0 || xzalgochain_manifest_open(path, &m) != -1 ||
+        errno != EINVAL)
+        failures++;
+
+    /* An empty manifest */
+    if (xzalgochain_manifest_write(path, NULL, NULL, 0) != 0 || xzalgochain_manifest_open(path, &m) != 0 || m.count != 0 ||
+        xzalgochain_manifest_find_path(&m, "x"))
+        failures++;
+    xzalgochain_manifest_close(&m);
+
+    printf("  manifest %-4d %s (%d mismatches)\n", COUNT, failures ? "FAIL" : "PASS", failures);
+    return failures;
+}
+
+/* ======================== MAIN ======================== */
+int main(void) {
+    char path[] = "/tmp/xzalgochain_file_test_XXXXXX";
+    uint8_t* data = malloc(MAX_FILE_SIZE);
+
+    printf("===== File Hashing Test =====\n");
+    printf("mmap threshold: %d bytes, window: %d bytes\n\n", XZ_FILE_MMAP_THRESHOLD, XZ_FILE_MMAP_WINDOW);
+
+    int fd = mkstemp(path);
+    if (!data || fd < 0) {
+        fprintf(stderr, "Setup failed\n");
+        return 1;
+    }
+    close(fd);
+    for (size_t i = 0; i < MAX_FILE_SIZE; i++) data[i] = (uint8_t) next_rand();
+
+    int failures = test_files(path, data) + test_pipe(data) + test_errors() + test_zeros() + test_sparse(path, data) +
+                   test_ranges(path, data) + test_manifest(path);
+
+    unlink(path);
+    free(data);
+
+    printf("\nResult: %s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
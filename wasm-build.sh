@@ -12,6 +12,22 @@ WASM_OUTPUT_DIR="${PROJECT_ROOT}/wasm"
 WASM_BUILD_DIR="${PROJECT_ROOT}/wasm_build"
 SOURCE_WASM_WRAPPER="${PROJECT_ROOT}/xzalgochain_wasm.c"
 XZALGOCHAIN_INCLUDE_DIR="${PROJECT_ROOT}/XzalgoChain"
+WASM_JS_DIR="${PROJECT_ROOT}/wasm-js"
+
+# Build the SIMD128, threaded and minimal standalone flavors next to the
+# baseline module unless --no-simd / --no-threads / --no-minimal is given
+BUILD_SIMD=1
+BUILD_THREADS=1
+BUILD_MINIMAL=1
+for arg in "$@"; do
+    if [[ "$arg" == "--no-simd" ]]; then
+        BUILD_SIMD=0
+    elif [[ "$arg" == "--no-threads" ]]; then
+        BUILD_THREADS=0
+    elif [[ "$arg" == "--no-minimal" ]]; then
+        BUILD_MINIMAL=0
+    fi
+done
 
 # Colors for output
 RED='\033[0;31m'
@@ -66,6 +82,16 @@ echo -e "${GREEN}✓ Directories created${NC}\n"
 echo -e "${YELLOW}Cleaning previous WASM builds...${NC}"
 rm -f "${WASM_OUTPUT_DIR}/XzalgoChain.wasm"
 rm -f "${WASM_OUTPUT_DIR}/XzalgoChain.js"
+rm -f "${WASM_OUTPUT_DIR}/XzalgoChain-simd.wasm"
+rm -f "${WASM_OUTPUT_DIR}/XzalgoChain-simd.js"
+rm -f "${WASM_OUTPUT_DIR}/XzalgoChain-mt.wasm"
+rm -f "${WASM_OUTPUT_DIR}/XzalgoChain-mt.js"
+rm -f "${WASM_OUTPUT_DIR}/XzalgoChain-mt.worker.js"
+rm -f "${WASM_OUTPUT_DIR}/XzalgoChain-min.wasm"
+rm -f "${WASM_OUTPUT_DIR}/xzalgochain-loader.js"
+rm -f "${WASM_OUTPUT_DIR}/xzalgochain-hasher.js"
+rm -f "${WASM_OUTPUT_DIR}/xzalgochain-worker.js"
+rm -f "${WASM_OUTPUT_DIR}/xzalgochain-stream.js"
 rm -f "${WASM_BUILD_DIR}"/*.o
 echo -e "${GREEN}✓ Cleaned${NC}\n"
 
@@ -78,7 +104,6 @@ BASE_CFLAGS=(
     "-flto"
     "-DNDEBUG"
     "-DXZALGOCHAIN_STATIC=1"
-    "-DXZALGOCHAIN_ENABLE_SIMD=0"
     "-DXZALGOCHAIN_USE_OPENMP=0"
     "-I${XZALGOCHAIN_INCLUDE_DIR}"
 )
@@ -97,13 +122,12 @@ BASE_LDFLAGS=(
     "-s WASM=1"
     "-s WASM_ASYNC_COMPILATION=1"
     "-s MODULARIZE=1"
-    "-s EXPORT_NAME='XzalgoChain'"
-    "-s EXPORTED_FUNCTIONS=['_malloc','_free','_xzalgochain_wasm','_xzalgochain_init_wasm','_xzalgochain_update_wasm','_xzalgochain_final_wasm','_xzalgochain_ctx_reset_wasm','_xzalgochain_ctx_wipe_wasm','_xzalgochain_copy_wasm','_xzalgochain_equals_wasm','_xzalgochain_version_wasm']"
-    "-s EXPORTED_RUNTIME_METHODS=['ccall','cwrap','getValue','setValue','UTF8ToString','stringToUTF8','lengthBytesUTF8']"
+    "-s EXPORTED_FUNCTIONS=['_malloc','_free','_xzalgochain_wasm','_xzalgochain_init_wasm','_xzalgochain_update_wasm','_xzalgochain_final_wasm','_xzalgochain_ctx_reset_wasm','_xzalgochain_ctx_wipe_wasm','_xzalgochain_ctx_size_wasm','_xzalgochain_ctx_new_wasm','_xzalgochain_ctx_free_wasm','_xzalgochain_copy_wasm','_xzalgochain_equals_wasm','_xzalgochain_version_wasm','_xzalgochain_backend_name_wasm','_xzalgochain_batch_wasm']"
+    "-s EXPORTED_RUNTIME_METHODS=['ccall','cwrap','getValue','setValue','UTF8ToString','stringToUTF8','lengthBytesUTF8','HEAPU8','HEAPU32']"
     "-s ALLOW_MEMORY_GROWTH=1"
     "-s MAXIMUM_MEMORY=512MB"
     "-s FILESYSTEM=0"
-    "-s ENVIRONMENT='web'"
+    "-s ENVIRONMENT='web,worker,node'"
     "-s STACK_SIZE=5MB"
     "-s INITIAL_MEMORY=16777216"
     "-s SINGLE_FILE=0"
@@ -127,56 +151,225 @@ else
     BASE_LDFLAGS+=("-g0")
 fi
 
+# Flavor flags
+# Baseline runs on every engine; SIMD128 needs WebAssembly SIMD
+# (Chrome 91+, Firefox 89+, Safari 16.4+, Node.js 16.4+). The loader picks one at runtime.
+# -msimd128 is repeated at link time because LTO generates code there
+BASELINE_FLAGS=(
+    "-DXZALGOCHAIN_ENABLE_SIMD=0"
+)
+SIMD_FLAGS=(
+    "-DXZALGOCHAIN_ENABLE_SIMD=1"
+    "-msimd128"
+)
+
+# Threaded flavor: xzalgochain_batch_wasm() hashes messages on a worker pool
+# with one thread per logical core. Needs SharedArrayBuffer, i.e. a
+# cross-origin isolated page (COOP/COEP headers) or Node.js.
+# The pool size expression runs in every ENVIRONMENT, and Node.js before 21
+# has no navigator, so it falls back to 4 workers. It must not contain spaces
+# or glob characters, because the flag arrays are expanded unquoted.
+# STRICT=2 makes pthread_create() fail instead of waiting for a worker when
+# the pool is exhausted; the batch then runs on fewer threads
+THREADS_FLAGS=(
+    "-DXZALGOCHAIN_ENABLE_SIMD=0"
+    "-pthread"
+)
+THREADS_LDFLAGS=(
+    "-s PTHREAD_POOL_SIZE=(globalThis.navigator&&navigator.hardwareConcurrency)||4"
+    "-s PTHREAD_POOL_SIZE_STRICT=2"
+)
+
+# Minimal flavor: standalone .wasm with no JS glue, for cold-start sensitive
+# hosts (edge functions). Optimized for size, small initial memory, and only
+# the hash exports; instantiated directly with the WebAssembly API.
+# It is also the WASI target (node:wasi, wasmtime) used by xzalgochain-stream.js
+MINIMAL_CFLAGS=(
+    "-Oz"
+    "-flto"
+    "-g0"
+    "-DNDEBUG"
+    "-DXZALGOCHAIN_STATIC=1"
+    "-DXZALGOCHAIN_USE_OPENMP=0"
+    "-DXZALGOCHAIN_ENABLE_SIMD=0"
+    "-D__WASM__=1"
+    "-D__EMSCRIPTEN__=1"
+    "-I${XZALGOCHAIN_INCLUDE_DIR}"
+)
+MINIMAL_LDFLAGS=(
+    "-Oz"
+    "-flto"
+    "-g0"
+    "--no-entry"
+    "-s STANDALONE_WASM=1"
+    "-s EXPORTED_FUNCTIONS=['_malloc','_free','_xzalgochain_wasm','_xzalgochain_ctx_new_wasm','_xzalgochain_ctx_free_wasm','_xzalgochain_init_wasm','_xzalgochain_update_wasm','_xzalgochain_final_wasm']"
+    "-s ALLOW_MEMORY_GROWTH=1"
+    "-s MAXIMUM_MEMORY=512MB"
+    "-s STACK_SIZE=64KB"
+    "-s INITIAL_MEMORY=262144"
+)
+
 echo -e "${GREEN}✓ Configuration complete${NC}\n"
 
-# ==================== COMPILE WASM WRAPPER ====================
-echo -e "${YELLOW}Step 1: Compiling WASM wrapper...${NC}"
+# ==================== BUILD ONE FLAVOR ====================
+# Usage: build_flavor <output name> <export name> <flavor flags...> [-- <link-only flags...>]
+build_flavor() {
+    local name="$1"
+    local export_name="$2"
+    shift 2
+    local flavor_flags=()
+    local link_flags=()
+    while [ $# -gt 0 ] && [ "$1" != "--" ]; do
+        flavor_flags+=("$1")
+        shift
+    done
+    if [ $# -gt 0 ]; then
+        shift
+        link_flags=("$@")
+    fi
 
-emcc "${SOURCE_WASM_WRAPPER}" \
-    ${BASE_CFLAGS[@]} \
-    -c \
-    -o "${WASM_BUILD_DIR}/xzalgochain_wasm.bc"
+    echo -e "${YELLOW}Step 1: Compiling WASM wrapper (${name})...${NC}"
 
-if [ $? -ne 0 ]; then
-    echo -e "${RED}✗ Failed to compile WASM wrapper${NC}"
-    exit 1
-fi
-echo -e "${GREEN}✓ WASM wrapper compiled${NC}\n"
+    emcc "${SOURCE_WASM_WRAPPER}" \
+        ${BASE_CFLAGS[@]} \
+        ${flavor_flags[@]} \
+        -c \
+        -o "${WASM_BUILD_DIR}/${name}.bc"
+
+    if [ $? -ne 0 ]; then
+        echo -e "${RED}✗ Failed to compile WASM wrapper (${name})${NC}"
+        exit 1
+    fi
+    echo -e "${GREEN}✓ WASM wrapper compiled${NC}\n"
 
-# ==================== LINK TO FINAL WASM ====================
-echo -e "${YELLOW}Step 2: Linking to final WebAssembly module...${NC}"
+    echo -e "${YELLOW}Step 2: Linking to final WebAssembly module (${name})...${NC}"
 
-emcc \
-    "${WASM_BUILD_DIR}/xzalgochain_wasm.bc" \
-    ${BASE_LDFLAGS[@]} \
-    -o "${WASM_OUTPUT_DIR}/XzalgoChain.js"
+    emcc \
+        "${WASM_BUILD_DIR}/${name}.bc" \
+        ${BASE_LDFLAGS[@]} \
+        ${flavor_flags[@]} \
+        ${link_flags[@]} \
+        -s EXPORT_NAME="'${export_name}'" \
+        -o "${WASM_OUTPUT_DIR}/${name}.js"
 
-if [ $? -ne 0 ]; then
-    echo -e "${RED}✗ Failed to link WASM module${NC}"
-    exit 1
+    if [ $? -ne 0 ]; then
+        echo -e "${RED}✗ Failed to link WASM module (${name})${NC}"
+        exit 1
+    fi
+
+    echo -e "${GREEN}✓ Linking complete${NC}\n"
+}
+
+# ==================== BUILD MINIMAL FLAVOR ====================
+# Usage: build_minimal <output name>
+build_minimal() {
+    local name="$1"
+
+    echo -e "${YELLOW}Step 1: Compiling WASM wrapper (${name})...${NC}"
+
+    emcc "${SOURCE_WASM_WRAPPER}" \
+        ${MINIMAL_CFLAGS[@]} \
+        -c \
+        -o "${WASM_BUILD_DIR}/${name}.bc"
+
+    if [ $? -ne 0 ]; then
+        echo -e "${RED}✗ Failed to compile WASM wrapper (${name})${NC}"
+        exit 1
+    fi
+    echo -e "${GREEN}✓ WASM wrapper compiled${NC}\n"
+
+    echo -e "${YELLOW}Step 2: Linking standalone WebAssembly module (${name})...${NC}"
+
+    # A .wasm output file makes emcc skip the JS glue
+    emcc \
+        "${WASM_BUILD_DIR}/${name}.bc" \
+        ${MINIMAL_LDFLAGS[@]} \
+        -o "${WASM_OUTPUT_DIR}/${name}.wasm"
+
+    if [ $? -ne 0 ]; then
+        echo -e "${RED}✗ Failed to link WASM module (${name})${NC}"
+        exit 1
+    fi
+
+    # emcc already runs Binaryen at -Oz; a standalone wasm-opt (binaryen package)
+    # gets a few more bytes out and drops the producers section
+    if command -v wasm-opt &> /dev/null; then
+        wasm-opt -Oz --converge --strip-debug --strip-producers \
+            "${WASM_OUTPUT_DIR}/${name}.wasm" \
+            -o "${WASM_OUTPUT_DIR}/${name}.wasm"
+    fi
+
+    echo -e "${GREEN}✓ Linking complete${NC}\n"
+}
+
+# ==================== COMPILE AND LINK ====================
+build_flavor "XzalgoChain" "XzalgoChain" "${BASELINE_FLAGS[@]}"
+
+if [ "$BUILD_SIMD" -eq 1 ]; then
+    build_flavor "XzalgoChain-simd" "XzalgoChainSIMD" "${SIMD_FLAGS[@]}"
+fi
+
+if [ "$BUILD_THREADS" -eq 1 ]; then
+    build_flavor "XzalgoChain-mt" "XzalgoChainMT" "${THREADS_FLAGS[@]}" -- "${THREADS_LDFLAGS[@]}"
+fi
+
+if [ "$BUILD_MINIMAL" -eq 1 ]; then
+    build_minimal "XzalgoChain-min"
 fi
 
-echo -e "${GREEN}✓ Linking complete${NC}\n"
+# Runtime loader that picks the SIMD128 or baseline module, and the zero-copy bindings
+cp "${WASM_JS_DIR}/xzalgochain-loader.js" "${WASM_OUTPUT_DIR}/"
+cp "${WASM_JS_DIR}/xzalgochain-hasher.js" "${WASM_OUTPUT_DIR}/"
+cp "${WASM_JS_DIR}/xzalgochain-worker.js" "${WASM_OUTPUT_DIR}/"
+cp "${WASM_JS_DIR}/xzalgochain-stream.js" "${WASM_OUTPUT_DIR}/"
 
 # ==================== VERIFY OUTPUT ====================
 echo -e "${YELLOW}Step 3: Verifying output...${NC}"
 
-if [ -f "${WASM_OUTPUT_DIR}/XzalgoChain.wasm" ] && [ -f "${WASM_OUTPUT_DIR}/XzalgoChain.js" ]; then
+if [ -f "${WASM_OUTPUT_DIR}/XzalgoChain.wasm" ] && [ -f "${WASM_OUTPUT_DIR}/XzalgoChain.js" ] &&
+    { [ "$BUILD_SIMD" -eq 0 ] || [ -f "${WASM_OUTPUT_DIR}/XzalgoChain-simd.wasm" ]; } &&
+    { [ "$BUILD_THREADS" -eq 0 ] || [ -f "${WASM_OUTPUT_DIR}/XzalgoChain-mt.wasm" ]; } &&
+    { [ "$BUILD_MINIMAL" -eq 0 ] || [ -f "${WASM_OUTPUT_DIR}/XzalgoChain-min.wasm" ]; }; then
     echo -e "${GREEN}✓ Build successful!${NC}"
 
     # Display output files
     echo -e "\n${YELLOW}Generated files:${NC}"
-    ls -lh "${WASM_OUTPUT_DIR}" | grep -E "XzalgoChain\.(wasm|js)"
+    ls -lh "${WASM_OUTPUT_DIR}" | grep -E "(XzalgoChain(-simd|-mt|-min)?(\.worker)?\.(wasm|js)|xzalgochain-(loader|hasher|worker|stream)\.js)"
 
     # Show file sizes
     echo -e "\n${YELLOW}File sizes:${NC}"
-    if [ -f "${WASM_OUTPUT_DIR}/XzalgoChain.wasm" ]; then
-        WASM_SIZE=$(du -h "${WASM_OUTPUT_DIR}/XzalgoChain.wasm" | cut -f1)
-        echo "  WASM: ${WASM_SIZE}"
+    for flavor in XzalgoChain XzalgoChain-simd XzalgoChain-mt; do
+        if [ -f "${WASM_OUTPUT_DIR}/${flavor}.wasm" ]; then
+            WASM_SIZE=$(du -h "${WASM_OUTPUT_DIR}/${flavor}.wasm" | cut -f1)
+            JS_SIZE=$(du -h "${WASM_OUTPUT_DIR}/${flavor}.js" | cut -f1)
+            echo "  ${flavor}: WASM ${WASM_SIZE}, JS ${JS_SIZE}"
+        fi
+    done
+    if [ -f "${WASM_OUTPUT_DIR}/XzalgoChain-min.wasm" ]; then
+        WASM_SIZE=$(du -h "${WASM_OUTPUT_DIR}/XzalgoChain-min.wasm" | cut -f1)
+        echo "  XzalgoChain-min: WASM ${WASM_SIZE}, no JS"
+    fi
+
+    # Size and cold instantiate time, baseline vs minimal, for the generated README
+    STARTUP_REPORT="Not measured (Node.js not found or minimal build skipped)."
+    if [ -f "${WASM_OUTPUT_DIR}/XzalgoChain-min.wasm" ] && command -v node &> /dev/null; then
+        echo -e "\n${YELLOW}Startup:${NC}"
+        if STARTUP_REPORT=$(node "${WASM_JS_DIR}/bench-startup.js" "${WASM_OUTPUT_DIR}" --markdown); then
+            echo "${STARTUP_REPORT}"
+        else
+            echo -e "${RED}✗ Minimal build returned a wrong digest${NC}"
+            echo "${STARTUP_REPORT}"
+            exit 1
+        fi
     fi
-    if [ -f "${WASM_OUTPUT_DIR}/XzalgoChain.js" ]; then
-        JS_SIZE=$(du -h "${WASM_OUTPUT_DIR}/XzalgoChain.js" | cut -f1)
-        echo "  JS:   ${JS_SIZE}"
+
+    # Refresh the demo, which serves the baseline module and the bindings from wasm-demo/wasm
+    DEMO_WASM_DIR="${PROJECT_ROOT}/wasm-demo/wasm"
+    if [ -d "${DEMO_WASM_DIR}" ]; then
+        cp "${WASM_OUTPUT_DIR}/XzalgoChain.js" "${WASM_OUTPUT_DIR}/XzalgoChain.wasm" \
+            "${WASM_OUTPUT_DIR}/xzalgochain-loader.js" "${WASM_OUTPUT_DIR}/xzalgochain-hasher.js" \
+            "${WASM_OUTPUT_DIR}/xzalgochain-worker.js" "${DEMO_WASM_DIR}/"
+        echo -e "${GREEN}✓ Demo module and bindings updated in ${DEMO_WASM_DIR}${NC}"
     fi
 
 # Create README for the WASM output
@@ -187,75 +380,134 @@ This directory contains the WebAssembly build of XzalgoChain cryptographic hash
 
 ## Files
 
-- \`XzalgoChain.wasm\` - WebAssembly binary module
+- \`XzalgoChain.wasm\` - WebAssembly binary module (runs on every engine)
 - \`XzalgoChain.js\` - JavaScript glue code for loading the module
+- \`XzalgoChain-simd.wasm\` - WebAssembly SIMD128 build (\`-msimd128\`)
+- \`XzalgoChain-simd.js\` - JavaScript glue code for the SIMD128 build (factory \`XzalgoChainSIMD\`)
+- \`XzalgoChain-mt.wasm\` - Threaded build (\`-pthread\`, one pool worker per logical core, 4 where \`navigator\` is missing)
+- \`XzalgoChain-mt.js\` - JavaScript glue code for the threaded build (factory \`XzalgoChainMT\`)
+- \`xzalgochain-loader.js\` - Loader that picks the SIMD128 build when the engine supports it
+- \`xzalgochain-hasher.js\` - Zero-copy bindings (\`XzalgoChainHasher\`): reusable arena, batch hashing
+- \`xzalgochain-worker.js\` - Streaming file hashing in a Web Worker (\`XzalgoChainFileHasher\`)
+- \`XzalgoChain-min.wasm\` - Minimal standalone build: no JS glue, \`-Oz\`, hash exports only (also the WASI target)
+- \`xzalgochain-stream.js\` - Node.js streaming (\`stream.Transform\` and async iterators) over the WASI or Emscripten builds
+
+## Choosing a Build
+
+Both builds produce identical digests. Let the loader pick the faster one:
+
+\`\`\`javascript
+// Browser: <script src="wasm/xzalgochain-loader.js"></script>
+// Node.js: const XzalgoChainLoader = require('./wasm/xzalgochain-loader.js');
+const xzalgochain = await XzalgoChainLoader.load();        // { simd: true | false } forces a build
+console.log(xzalgochain.xzalgochainFlavor);                // 'simd', 'baseline' or 'mt'
+\`\`\`
+
+Then hash through the zero-copy bindings instead of per-byte \`setValue\`/\`getValue\`:
+
+\`\`\`javascript
+// Browser: <script src="wasm/xzalgochain-hasher.js"></script>
+const hasher = new XzalgoChainHasher(xzalgochain);
+hasher.hashHex("Hello, XzalgoChain!");                    // 80-character hex string
+hasher.hash(uint8Array);                                   // 40-byte Uint8Array
+hasher.hashBatchHex(["a", "b", new Uint8Array([1, 2])]);   // one call into WASM
+\`\`\`
+
+Pass \`{ threads: true }\` to get the threaded build for \`_xzalgochain_batch_wasm\`. It needs
+\`SharedArrayBuffer\`, so pages must be cross-origin isolated (\`Cross-Origin-Opener-Policy: same-origin\`,
+\`Cross-Origin-Embedder-Policy: require-corp\`). Otherwise the loader falls back to a single-threaded build.
+
+The threaded batch call blocks the calling thread until the pool is done, so in browsers call it
+from a Web Worker. On the page's main thread \`hashBatch()\` runs it with one thread.
+
+## Minimal Build
+
+\`XzalgoChain-min.wasm\` is for hosts where download size and cold start matter more than
+convenience (edge functions). It has no Emscripten runtime. Instantiate it with the WebAssembly
+API and use the raw exports (no leading underscore):
+- \`malloc\`, \`free\`, \`memory\`
+- \`xzalgochain_wasm\`
+- \`xzalgochain_ctx_new_wasm\`, \`xzalgochain_ctx_free_wasm\`
+- \`xzalgochain_init_wasm\`, \`xzalgochain_update_wasm\`, \`xzalgochain_final_wasm\`
+
+\`\`\`javascript
+const module = await WebAssembly.compileStreaming(fetch('XzalgoChain-min.wasm'));
+
+// Imports are only reachable on error paths; stub them
+const imports = {};
+for (const imp of WebAssembly.Module.imports(module)) {
+    (imports[imp.module] = imports[imp.module] || {})[imp.name] = () => 0;
+}
+const { exports } = await WebAssembly.instantiate(module, imports);
+exports._initialize?.();                                    // Reactor init (static constructors)
+
+const data = new TextEncoder().encode("Hello, XzalgoChain!");
+const dataPtr = exports.malloc(data.length);
+const outPtr = exports.malloc(40);
+new Uint8Array(exports.memory.buffer).set(data, dataPtr);   // re-create views after memory growth
+exports.xzalgochain_wasm(dataPtr, data.length, outPtr);
+const digest = new Uint8Array(exports.memory.buffer, outPtr, 40).slice();
+exports.free(dataPtr);
+exports.free(outPtr);
+\`\`\`
+
+Size and cold instantiate time (compile + instantiate + first hash, Node.js), measured by
+\`wasm-js/bench-startup.js\` during this build:
+
+${STARTUP_REPORT}
 
 ## Usage
 
 \`\`\`javascript
 // Load the module
 import XzalgoChain from './XzalgoChain.js';
+// Browser: <script src="wasm/xzalgochain-hasher.js"></script>
+// Node.js: const XzalgoChainHasher = require('./wasm/xzalgochain-hasher.js');
 
 // Initialize
 const xzalgochain = await XzalgoChain();
+const hasher = new XzalgoChainHasher(xzalgochain);
 
-// Hash a string
-function stringToUTF8Array(str) {
-    const utf8 = unescape(encodeURIComponent(str));
-    const arr = new Uint8Array(utf8.length);
-    for (let i = 0; i < utf8.length; i++) {
-        arr[i] = utf8.charCodeAt(i);
-    }
-    return arr;
-}
+// Hash a string (UTF-8) or any Uint8Array/ArrayBuffer/ArrayBufferView
+const hash = hasher.hashHex("Hello, XzalgoChain!");
+console.log("Hash:", hash);
 
-async function calculateHash(input) {
-    // Convert string to bytes
-    const data = stringToUTF8Array(input);
-    const output = new Uint8Array(40); // 320 bits = 40 bytes
+const digest = hasher.hash(new Uint8Array([1, 2, 3]));     // 40-byte Uint8Array, a copy
 
-    // Allocate memory
-    const dataPtr = xzalgochain._malloc(data.length);
-    const outputPtr = xzalgochain._malloc(40);
+// Many small messages: one call into WASM
+const hashes = hasher.hashBatchHex(["first", "second", "third"]);
 
-    try {
-        // Write data to WASM memory using setValue
-        for (let i = 0; i < data.length; i++) {
-            xzalgochain.setValue(dataPtr + i, data[i], 'i8');
-        }
+// Free the arena when done
+hasher.dispose();
+\`\`\`
 
-        // Call hash function
-        xzalgochain._xzalgochain_wasm(dataPtr, data.length, outputPtr);
+The hasher keeps one growable arena in WASM memory and copies bytes in and out with
+\`HEAPU8.set()\`/\`slice()\`, so each hash costs a single call and no per-byte work.
 
-        // Read result back using getValue
-        for (let i = 0; i < 40; i++) {
-            output[i] = xzalgochain.getValue(outputPtr + i, 'i8');
-        }
+## Example: Hashing Files in a Web Worker
 
-        // Convert to hex string (handle negative values)
-        return Array.from(output)
-            .map(b => (b + 256) % 256)
-            .map(b => b.toString(16).padStart(2, '0'))
-            .join('');
-    } finally {
-        // Free memory
-        xzalgochain._free(dataPtr);
-        xzalgochain._free(outputPtr);
-    }
-}
+\`\`\`javascript
+// Browser: <script src="wasm/xzalgochain-worker.js"></script>
+const fileHasher = new XzalgoChainFileHasher({ baseUrl: 'wasm/' });
 
-// Example usage
-const hash = await calculateHash("Hello, XzalgoChain!");
-console.log("Hash:", hash);
+// Streams the file in 1 MiB chunks inside the worker; the page stays responsive
+const hex = await fileHasher.hashFile(file, {
+    onProgress: (done, total) => console.log(done + ' / ' + total)
+});
+
+fileHasher.terminate();
 \`\`\`
 
+In Node.js, \`xzalgochain-stream.js\` provides the same for streams and async iterators.
+
 ## API Reference
 
 ### Memory Management Functions
 - \`_malloc(size)\` - Allocate memory in WASM heap
 - \`_free(ptr)\` - Free allocated memory
-- \`setValue(ptr, value, type)\` - Write value to memory (type: 'i8', 'i16', 'i32', etc.)
-- \`getValue(ptr, type)\` - Read value from memory
+- \`HEAPU8\`, \`HEAPU32\` - Views of WASM memory for bulk copies (re-read after any call that may grow memory)
+- \`setValue(ptr, value, type)\` - Write one value to memory (type: 'i8', 'i16', 'i32', etc.)
+- \`getValue(ptr, type)\` - Read one value from memory
 
 ### Core Hash Functions
 - \`_xzalgochain_wasm(dataPtr, dataLength, outputPtr)\` - One-shot hash calculation
@@ -264,6 +516,9 @@ console.log("Hash:", hash);
   - \`outputPtr\`: Pointer to output buffer (40 bytes)
 
 ### Context Management Functions
+- \`_xzalgochain_ctx_new_wasm()\` - Allocate and initialize a context (returns pointer, 0 on failure)
+- \`_xzalgochain_ctx_free_wasm(ctxPtr)\` - Wipe and free a context from \`_xzalgochain_ctx_new_wasm\`
+- \`_xzalgochain_ctx_size_wasm()\` - Size of a context in bytes
 - \`_xzalgochain_init_wasm(ctxPtr)\` - Initialize hash context
 - \`_xzalgochain_update_wasm(ctxPtr, dataPtr, dataLength)\` - Update hash with data
 - \`_xzalgochain_final_wasm(ctxPtr, outputPtr)\` - Finalize hash
@@ -274,6 +529,14 @@ console.log("Hash:", hash);
 - \`_xzalgochain_copy_wasm(dstPtr, srcPtr)\` - Copy hash value
 - \`_xzalgochain_equals_wasm(h1Ptr, h2Ptr)\` - Constant-time hash comparison (returns 1 if equal, 0 if not)
 - \`_xzalgochain_version_wasm()\` - Get library version (returns pointer to string)
+- \`_xzalgochain_backend_name_wasm()\` - Get the backend used by this build (returns pointer to string)
+
+### Batch Functions
+- \`_xzalgochain_batch_wasm(dataPtr, offsetsPtr, count, outputsPtr, numThreads)\` - Hash many messages in one call (returns 0, or -1 on invalid arguments; the threaded build blocks the caller until done, so call it from a Web Worker in browsers)
+  - \`dataPtr\`: Pointer to the concatenated messages
+  - \`offsetsPtr\`: Pointer to \`count + 1\` uint32 offsets; message i is \`data[offsets[i] .. offsets[i + 1])\`
+  - \`outputsPtr\`: Pointer to \`count * 40\` bytes of digests, in message order
+  - \`numThreads\`: Threads to use in the threaded build, 0 for one per logical core (ignored elsewhere)
 
 ### String Helper Functions
 - \`UTF8ToString(ptr)\` - Convert WASM string to JavaScript string
@@ -282,48 +545,33 @@ console.log("Hash:", hash);
 
 ## Example: Context API Usage
 
+For data that arrives in pieces, drive the context API yourself and reuse one chunk buffer:
+
 \`\`\`javascript
 // Hash large data in chunks
-async function hashLargeData(data) {
-    const ctxPtr = xzalgochain._malloc(256); // Allocate context (size depends on implementation)
-    const output = new Uint8Array(40);
+function hashLargeData(chunks) {
+    // Allocated and initialized by the module, with the real context size and alignment
+    const ctxPtr = xzalgochain._xzalgochain_ctx_new_wasm();
+    const chunkSize = 64 * 1024; // 64KB chunks
+    const bufPtr = xzalgochain._malloc(chunkSize);
     const outputPtr = xzalgochain._malloc(40);
 
     try {
-        // Initialize context
-        xzalgochain._xzalgochain_init_wasm(ctxPtr);
-
-        // Process data in chunks
-        const chunkSize = 64 * 1024; // 64KB chunks
-        for (let i = 0; i < data.length; i += chunkSize) {
-            const chunk = data.slice(i, i + chunkSize);
-            const chunkPtr = xzalgochain._malloc(chunk.length);
-
-            // Copy chunk to WASM memory
-            for (let j = 0; j < chunk.length; j++) {
-                xzalgochain.setValue(chunkPtr + j, chunk[j], 'i8');
-            }
-
-            // Update hash with chunk
-            xzalgochain._xzalgochain_update_wasm(ctxPtr, chunkPtr, chunk.length);
+        for (const chunk of chunks) {
+            for (let i = 0; i < chunk.length; i += chunkSize) {
+                const piece = chunk.subarray(i, i + chunkSize);
 
-            xzalgochain._free(chunkPtr);
+                // Re-read HEAPU8 every time: memory growth replaces the view
+                xzalgochain.HEAPU8.set(piece, bufPtr);
+                xzalgochain._xzalgochain_update_wasm(ctxPtr, bufPtr, piece.length);
+            }
         }
 
-        // Finalize hash
         xzalgochain._xzalgochain_final_wasm(ctxPtr, outputPtr);
-
-        // Read result
-        for (let i = 0; i < 40; i++) {
-            output[i] = xzalgochain.getValue(outputPtr + i, 'i8');
-        }
-
-        return Array.from(output)
-            .map(b => (b + 256) % 256)
-            .map(b => b.toString(16).padStart(2, '0'))
-            .join('');
+        return XzalgoChainHasher.toHex(xzalgochain.HEAPU8.slice(outputPtr, outputPtr + 40));
     } finally {
-        xzalgochain._free(ctxPtr);
+        xzalgochain._xzalgochain_ctx_free_wasm(ctxPtr); // Wipes, then frees
+        xzalgochain._free(bufPtr);
         xzalgochain._free(outputPtr);
     }
 }
@@ -332,32 +580,20 @@ async function hashLargeData(data) {
 ## Example: Compare Two Hashes
 
 \`\`\`javascript
-function compareHashes(hash1, hash2) {
-    // Convert hex strings to bytes
-    const bytes1 = new Uint8Array(40);
-    const bytes2 = new Uint8Array(40);
-
-    for (let i = 0; i < 40; i++) {
-        bytes1[i] = parseInt(hash1.substr(i * 2, 2), 16);
-        bytes2[i] = parseInt(hash2.substr(i * 2, 2), 16);
-    }
-
-    // Allocate memory
-    const ptr1 = xzalgochain._malloc(40);
-    const ptr2 = xzalgochain._malloc(40);
+// Check a message against a known digest
+const ok = hasher.verify("Hello, XzalgoChain!", expectedHex);
 
+// Compare two 40-byte digests in constant time
+function compareHashes(digest1, digest2) {
+    const ptr = xzalgochain._malloc(80);
     try {
-        // Copy bytes to WASM memory
-        for (let i = 0; i < 40; i++) {
-            xzalgochain.setValue(ptr1 + i, bytes1[i], 'i8');
-            xzalgochain.setValue(ptr2 + i, bytes2[i], 'i8');
-        }
+        xzalgochain.HEAPU8.set(digest1, ptr);
+        xzalgochain.HEAPU8.set(digest2, ptr + 40);
 
-        // Compare (returns 1 if equal, 0 if not)
-        return xzalgochain._xzalgochain_equals_wasm(ptr1, ptr2) === 1;
+        // Returns 1 if equal, 0 if not
+        return xzalgochain._xzalgochain_equals_wasm(ptr, ptr + 40) === 1;
     } finally {
-        xzalgochain._free(ptr1);
-        xzalgochain._free(ptr2);
+        xzalgochain._free(ptr);
     }
 }
 \`\`\`
@@ -373,8 +609,8 @@ function compareHashes(hash1, hash2) {
 - All memory allocated with \`_malloc\` must be freed with \`_free\` to prevent memory leaks
 - Output buffer for hash must be exactly 40 bytes (320 bits)
 - Hash comparison function (\`_xzalgochain_equals_wasm\`) is constant-time to prevent timing attacks
-- Use \`setValue\` and \`getValue\` with type 'i8' for byte-level access
-- Byte values from WASM may be negative; use \`(b + 256) % 256\` to convert to unsigned
+- Move bytes with \`HEAPU8.set()\` and \`HEAPU8.slice()\` (or \`XzalgoChainHasher\`), not per-byte \`setValue\`/\`getValue\`
+- \`XzalgoChainHasher\` is not safe to share between concurrent callers of the same module instance
 
 ## License
 
@@ -2,8 +2,14 @@
 // Copyright 2026 Xzrayツ
 
 let xzalgochain = null;
+let hasher = null;
+let fileHasher = null;
 let wasmReady = false;
 
+// Largest file hashed in the page when files cannot be streamed through a Worker;
+// the whole file is read into an ArrayBuffer and copied into WASM memory
+const IN_PAGE_MAX_BYTES = 512 * 1024 * 1024;
+
 // Recent hashes storage
 let recentHashes = JSON.parse(localStorage.getItem('xzalgochain_recent') || '[]');
 
@@ -55,6 +61,27 @@ async function initWASM() {
         console.log('XzalgoChain module loaded:', xzalgochain);
         console.log('Available functions:', Object.keys(xzalgochain).filter(key => key.startsWith('_')).sort());
 
+        // Reusable arena and zero-copy views (see wasm/xzalgochain-hasher.js); modules
+        // built before HEAPU8 was exported go through the per-byte setValue/getValue path
+        hasher = new XzalgoChainHasher(xzalgochain);
+        if (hasher.legacy) {
+            console.warn('WASM module predates HEAPU8; rebuild it with wasm-build.sh for zero-copy hashing');
+        }
+
+        // Files are streamed through a Worker (see wasm/xzalgochain-worker.js), which
+        // loads the same module and needs the context API and HEAPU8
+        const canStream = typeof xzalgochain._xzalgochain_ctx_new_wasm === 'function' && !hasher.legacy;
+        if (!canStream) {
+            console.warn('WASM module too old for streaming, hashing files in page');
+        } else if (typeof Worker !== 'undefined' && typeof XzalgoChainFileHasher !== 'undefined') {
+            try {
+                fileHasher = new XzalgoChainFileHasher({ simd: false });
+            } catch (error) {
+                // e.g. SecurityError when the page is opened from file://
+                console.warn('Cannot start the streaming worker, hashing files in page:', error);
+            }
+        }
+
         // Get version
         if (typeof xzalgochain._xzalgochain_version_wasm === 'function') {
             const versionPtr = xzalgochain._xzalgochain_version_wasm();
@@ -98,16 +125,6 @@ function enableButtons(enable) {
     });
 }
 
-// Helper function to convert string to UTF8 array
-function stringToUTF8Array(str) {
-    const utf8 = unescape(encodeURIComponent(str));
-    const arr = new Uint8Array(utf8.length);
-    for (let i = 0; i < utf8.length; i++) {
-        arr[i] = utf8.charCodeAt(i);
-    }
-    return arr;
-}
-
 // ==================== Clipboard Helper ====================
 
 // Copy text to clipboard
@@ -150,108 +167,33 @@ function showCopyNotification(element, message = '✓ Copied!') {
     }, 2000);
 }
 
-// Calculate hash from string using cwrap
+// Calculate hash from string
 async function calculateHash(str) {
-    if (!wasmReady || !xzalgochain) {
+    if (!wasmReady || !hasher) {
         throw new Error('WASM not ready');
     }
 
-    if (typeof xzalgochain._xzalgochain_wasm !== 'function') {
-        throw new Error('Hash function not found in module');
-    }
-
-    // Convert string to UTF8 array
-    const data = stringToUTF8Array(str);
-    const output = new Uint8Array(40); // 320 bits = 40 bytes
-
-    // Allocate memory
-    const dataPtr = xzalgochain._malloc(data.length);
-    const outputPtr = xzalgochain._malloc(40);
-
-    if (!dataPtr || !outputPtr) {
-        throw new Error('Failed to allocate memory');
-    }
-
-    try {
-        // Write data to WASM memory using stringToUTF8
-        for (let i = 0; i < data.length; i++) {
-            xzalgochain.setValue(dataPtr + i, data[i], 'i8');
-        }
-
-        // Call hash function
-        xzalgochain._xzalgochain_wasm(dataPtr, data.length, outputPtr);
-
-        // Read result back
-        for (let i = 0; i < 40; i++) {
-            output[i] = xzalgochain.getValue(outputPtr + i, 'i8');
-        }
+    // One call into WASM; copied through the hasher's arena unless hasher.legacy
+    return hasher.hashHex(str);
+}
 
-        // Convert to hex string
-        return Array.from(output)
-        .map(b => (b + 256) % 256) // Handle negative values
-        .map(b => b.toString(16).padStart(2, '0'))
-        .join('');
-    } finally {
-        // Free memory
-        xzalgochain._free(dataPtr);
-        xzalgochain._free(outputPtr);
+// Calculate hash from file in memory (fallback without a streaming Worker)
+function calculateFileHashInPage(file) {
+    if (file.size > IN_PAGE_MAX_BYTES) {
+        return Promise.reject(new Error(
+            `File too large to hash without a Web Worker (limit ${IN_PAGE_MAX_BYTES / (1024 * 1024)} MB)`));
     }
-}
 
-// Calculate hash from file
-async function calculateFileHash(file) {
     return new Promise((resolve, reject) => {
         const reader = new FileReader();
 
-        reader.onload = async function(e) {
+        reader.onload = function(e) {
             try {
-                const arrayBuffer = e.target.result;
-                const data = new Uint8Array(arrayBuffer);
-
-                if (!wasmReady || !xzalgochain) {
+                if (!wasmReady || !hasher) {
                     throw new Error('WASM not ready');
                 }
 
-                if (typeof xzalgochain._xzalgochain_wasm !== 'function') {
-                    throw new Error('Hash function not found in module');
-                }
-
-                const output = new Uint8Array(40);
-
-                // Allocate memory
-                const dataPtr = xzalgochain._malloc(data.length);
-                const outputPtr = xzalgochain._malloc(40);
-
-                if (!dataPtr || !outputPtr) {
-                    throw new Error('Failed to allocate memory');
-                }
-
-                try {
-                    // Write data to WASM memory using setValue
-                    for (let i = 0; i < data.length; i++) {
-                        xzalgochain.setValue(dataPtr + i, data[i], 'i8');
-                    }
-
-                    // Call hash function
-                    xzalgochain._xzalgochain_wasm(dataPtr, data.length, outputPtr);
-
-                    // Read result back
-                    for (let i = 0; i < 40; i++) {
-                        output[i] = xzalgochain.getValue(outputPtr + i, 'i8');
-                    }
-
-                    // Convert to hex string
-                    const hashHex = Array.from(output)
-                    .map(b => (b + 256) % 256) // Handle negative values
-                    .map(b => b.toString(16).padStart(2, '0'))
-                    .join('');
-
-                    resolve(hashHex);
-                } finally {
-                    // Free memory
-                    xzalgochain._free(dataPtr);
-                    xzalgochain._free(outputPtr);
-                }
+                resolve(hasher.hashHex(new Uint8Array(e.target.result)));
             } catch (error) {
                 reject(error);
             }
@@ -262,6 +204,24 @@ async function calculateFileHash(file) {
     });
 }
 
+// Calculate hash from file, streamed in chunks through a Worker
+// Errors from the worker (e.g. NotReadableError) are the caller's to show;
+// the worker stays in use for the next file
+async function calculateFileHash(file, onProgress) {
+    if (fileHasher) {
+        return fileHasher.hashFile(file, { onProgress });
+    }
+    return calculateFileHashInPage(file);
+}
+
+// Progress callback that shows the percentage on a button
+function progressOn(button, label) {
+    return (bytes, total) => {
+        const percent = total ? Math.floor((bytes / total) * 100) : 100;
+        button.textContent = `${label} ${percent}%`;
+    };
+}
+
 // Add hash to recent list
 function addToRecent(type, input, hash) {
     const timestamp = new Date().toLocaleTimeString();
@@ -377,7 +337,7 @@ elements.hashFileBtn.addEventListener('click', async () => {
         elements.hashFileBtn.disabled = true;
         elements.hashFileBtn.textContent = 'Hashing...';
 
-        const hash = await calculateFileHash(file);
+        const hash = await calculateFileHash(file, progressOn(elements.hashFileBtn, 'Hashing...'));
         elements.fileHashOutput.textContent = hash;
 
         // Auto copy to clipboard
@@ -463,7 +423,7 @@ elements.verifyFileBtn.addEventListener('click', async () => {
         elements.verifyFileBtn.disabled = true;
         elements.verifyFileBtn.textContent = 'Verifying...';
 
-        const calculatedHash = await calculateFileHash(file);
+        const calculatedHash = await calculateFileHash(file, progressOn(elements.verifyFileBtn, 'Verifying...'));
         const match = calculatedHash.toLowerCase() === hashToVerify.toLowerCase();
 
         if (match) {
@@ -0,0 +1,231 @@
+/*
+ * XzalgoChain - 320-bit Cryptographic Hash Function
+ * Copyright 2026 Xzrayツ
+ *
+ * xzalgochain-worker.js - Streaming file hashing in a Web Worker
+ * Reads a Blob/File with Blob.stream() and feeds it through
+ * xzalgochain_init/update/final in fixed-size chunks, so WASM memory stays
+ * at one context plus one chunk buffer whatever the file size. The page
+ * stays responsive and receives progress events.
+ *
+ * The same file is both sides:
+ *   - loaded with <script> on the page it defines XzalgoChainFileHasher,
+ *     a promise API that spawns the worker
+ *   - run as a Worker it loads the WASM module and hashes the files
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+(function (root) {
+    'use strict';
+
+    /* ==================== CONSTANTS ==================== */
+    const HASH_SIZE = 40;                       /* 320-bit digest */
+    const DEFAULT_CHUNK_SIZE = 1024 * 1024;     /* Bytes per update call */
+    const PROGRESS_INTERVAL_MS = 100;           /* Minimum time between progress events */
+
+    const isWorker = typeof WorkerGlobalScope !== 'undefined' && root instanceof WorkerGlobalScope;
+
+    /* ==================== WORKER SIDE ==================== */
+    if (isWorker) {
+        let modulePromise = null;
+        let moduleOptions = {};
+        const cancelled = new Set();
+
+        /**
+         * Load the WASM module once, on first use
+         * @returns {Promise<Object>} - Ready module
+         */
+        const getModule = function () {
+            if (!modulePromise) {
+                importScripts('xzalgochain-loader.js');
+                modulePromise = XzalgoChainLoader.load(moduleOptions).then(function (wasm) {
+                    if (typeof wasm._xzalgochain_ctx_new_wasm !== 'function' || !wasm.HEAPU8) {
+                        throw new Error('WASM module too old for streaming; rebuild it with wasm-build.sh');
+                    }
+                    return wasm;
+                });
+            }
+            return modulePromise;
+        };
+
+        /**
+         * Hash one Blob in fixed-size chunks
+         * Jobs may interleave at await points, so each one owns its context
+         * and chunk buffer
+         * @param {number} id - Job identifier
+         * @param {Blob} blob - File or Blob to hash
+         * @param {number} chunkSize - Bytes per update call
+         * @returns {Promise<string>} - Hex digest
+         */
+        const hashBlob = async function (id, blob, chunkSize) {
+            const wasm = await getModule();
+            const ctxPtr = wasm._xzalgochain_ctx_new_wasm();
+            const bufPtr = wasm._malloc(chunkSize);
+            const outPtr = wasm._malloc(HASH_SIZE);
+
+            if (!ctxPtr || !bufPtr || !outPtr) {
+                wasm._xzalgochain_ctx_free_wasm(ctxPtr);
+                wasm._free(bufPtr);
+                wasm._free(outPtr);
+                throw new Error('Failed to allocate WASM memory');
+            }
+
+            const reader = blob.stream().getReader();
+            let hashed = 0;
+            let lastProgress = 0;
+
+            try {
+                for (;;) {
+                    const { done, value } = await reader.read();
+                    if (done) break;
+                    if (cancelled.has(id)) throw new Error('Cancelled');
+
+                    /* Stream chunks have browser-chosen sizes; split them so every
+                     * update call fits the fixed WASM buffer */
+                    for (let off = 0; off < value.length; off += chunkSize) {
+                        const piece = value.subarray(off, Math.min(off + chunkSize, value.length));
+                        wasm.HEAPU8.set(piece, bufPtr);
+                        wasm._xzalgochain_update_wasm(ctxPtr, bufPtr, piece.length);
+                        hashed += piece.length;
+                    }
+
+                    const now = Date.now();
+                    if (now - lastProgress >= PROGRESS_INTERVAL_MS) {
+                        lastProgress = now;
+                        root.postMessage({ id: id, type: 'progress', bytes: hashed, total: blob.size });
+                    }
+                }
+
+                wasm._xzalgochain_final_wasm(ctxPtr, outPtr);
+                root.postMessage({ id: id, type: 'progress', bytes: hashed, total: blob.size });
+
+                const digest = wasm.HEAPU8.subarray(outPtr, outPtr + HASH_SIZE);
+                let hex = '';
+                for (let i = 0; i < HASH_SIZE; i++) hex += (digest[i] < 16 ? '0' : '') + digest[i].toString(16);
+                return hex;
+            } finally {
+                reader.releaseLock();
+                wasm._xzalgochain_ctx_free_wasm(ctxPtr);
+                wasm._free(bufPtr);
+                wasm._free(outPtr);
+                cancelled.delete(id);
+            }
+        };
+
+        root.onmessage = function (e) {
+            const msg = e.data;
+
+            if (msg.type === 'init') {
+                moduleOptions = msg.options || {};
+            } else if (msg.type === 'cancel') {
+                cancelled.add(msg.id);
+            } else if (msg.type === 'hash') {
+                hashBlob(msg.id, msg.blob, msg.chunkSize || DEFAULT_CHUNK_SIZE).then(function (hex) {
+                    root.postMessage({ id: msg.id, type: 'done', hash: hex });
+                }, function (error) {
+                    root.postMessage({ id: msg.id, type: 'error', message: error.message });
+                });
+            }
+        };
+        return;
+    }
+
+    /* ==================== PAGE SIDE ==================== */
+    const scriptUrl = typeof document !== 'undefined' && document.currentScript ? document.currentScript.src : null;
+
+    /**
+     * Promise API around the streaming worker
+     * @param {Object} [options]
+     * @param {string} [options.workerUrl] - URL of this script (default: where it was loaded from)
+     * @param {number} [options.chunkSize=1048576] - Bytes per update call
+     * @param {string} [options.baseUrl] - Directory of the WASM module files (default: next to the worker)
+     * @param {boolean|string} [options.simd] - Build choice, as in XzalgoChainLoader.load()
+     */
+    function XzalgoChainFileHasher(options) {
+        options = options || {};
+        const workerUrl = options.workerUrl || scriptUrl;
+        if (!workerUrl) throw new Error('workerUrl required when the script URL is unknown');
+
+        this.chunkSize = options.chunkSize || DEFAULT_CHUNK_SIZE;
+        this.nextId = 1;
+        this.jobs = new Map();
+        this.worker = new Worker(workerUrl);
+
+        const loaderOptions = {};
+        if (options.baseUrl) loaderOptions.baseUrl = new URL(options.baseUrl, location.href).href;
+        if (options.simd !== undefined) loaderOptions.simd = options.simd;
+        this.worker.postMessage({ type: 'init', options: loaderOptions });
+
+        const jobs = this.jobs;
+        this.worker.onmessage = function (e) {
+            const msg = e.data;
+            const job = jobs.get(msg.id);
+            if (!job) return;
+
+            if (msg.type === 'progress') {
+                if (job.onProgress) job.onProgress(msg.bytes, msg.total);
+            } else if (msg.type === 'done') {
+                jobs.delete(msg.id);
+                job.resolve(msg.hash);
+            } else if (msg.type === 'error') {
+                jobs.delete(msg.id);
+                job.reject(new Error(msg.message));
+            }
+        };
+        this.worker.onerror = function (e) {
+            jobs.forEach(function (job) {
+                job.reject(new Error(e.message || 'Worker failed'));
+            });
+            jobs.clear();
+        };
+    }
+
+    /**
+     * Hash a File or Blob without loading it into memory
+     * @param {Blob} blob - File or Blob to hash
+     * @param {Object} [options]
+     * @param {function(number, number)} [options.onProgress] - Called with (bytesHashed, totalBytes)
+     * @param {AbortSignal} [options.signal] - Cancels the job
+     * @returns {Promise<string>} - 80-character hex digest
+     */
+    XzalgoChainFileHasher.prototype.hashFile = function (blob, options) {
+        options = options || {};
+        const id = this.nextId++;
+        const worker = this.worker;
+        const jobs = this.jobs;
+
+        return new Promise(function (resolve, reject) {
+            jobs.set(id, { resolve: resolve, reject: reject, onProgress: options.onProgress });
+            if (options.signal) {
+                options.signal.addEventListener('abort', function () {
+                    worker.postMessage({ type: 'cancel', id: id });
+                });
+            }
+            worker.postMessage({ type: 'hash', id: id, blob: blob, chunkSize: options.chunkSize || this.chunkSize });
+        }.bind(this));
+    };
+
+    /**
+     * Stop the worker; pending jobs are rejected
+     */
+    XzalgoChainFileHasher.prototype.terminate = function () {
+        this.worker.terminate();
+        this.jobs.forEach(function (job) {
+            job.reject(new Error('Terminated'));
+        });
+        this.jobs.clear();
+    };
+
+    root.XzalgoChainFileHasher = XzalgoChainFileHasher;
+})(typeof self !== 'undefined' ? self : this);
@@ -0,0 +1,103 @@
+#!/usr/bin/env node
+/*
+ * bench-batch.js
+ *
+ * WASM Batch Benchmark
+ *
+ * Purpose:
+ *   1. Checks that xzalgochain_batch_wasm() in the threaded build returns the
+ *      same digests as one-shot hashing, for every thread count
+ *   2. Shows how batch throughput scales with the number of threads
+ *
+ * Usage:
+ *   Build:  ./wasm-build.sh
+ *   Run:    node wasm-js/bench-batch.js [wasm-output-dir] [messages] [message-size]
+ *
+ * Author: Xzrayツ
+ */
+
+'use strict';
+
+const os = require('os');
+const path = require('path');
+const XzalgoChainLoader = require('./xzalgochain-loader.js');
+
+/* ======================== CONFIGURATION ======================== */
+const HASH_SIZE = 40;
+const BENCH_MIN_MS = 1000;
+
+/* ======================== MAIN ======================== */
+async function main() {
+    const baseUrl = path.resolve(process.argv[2] || path.join(__dirname, '..', 'wasm')) + path.sep;
+    const count = parseInt(process.argv[3] || '4096', 10);
+    const size = parseInt(process.argv[4] || '4096', 10);
+    const cores = os.cpus().length;
+
+    const wasm = await XzalgoChainLoader.load({ threads: true, baseUrl });
+
+    console.log('===== WASM Batch Benchmark =====');
+    console.log(`Build: ${wasm.xzalgochainFlavor}, logical cores: ${cores}`);
+    console.log(`Batch: ${count} messages x ${size} bytes\n`);
+
+    /* One allocation for data, offsets and digests */
+    const dataPtr = wasm._malloc(count * size);
+    const offsetsPtr = wasm._malloc((count + 1) * 4);
+    const outputsPtr = wasm._malloc(count * HASH_SIZE);
+    const refPtr = wasm._malloc(HASH_SIZE);
+
+    for (let i = 0; i < count * size; i++) wasm.HEAPU8[dataPtr + i] = (i * 131 + 7) & 0xFF;
+    for (let i = 0; i <= count; i++) wasm.HEAPU32[(offsetsPtr >> 2) + i] = i * size;
+
+    let failures = 0;
+    const threadCounts = [];
+    for (let t = 1; t < cores; t *= 2) threadCounts.push(t);
+    threadCounts.push(cores);
+
+    let single = 0;
+    console.log('Threads    MB/s        Speedup    Digests');
+    for (const threads of threadCounts) {
+        wasm.HEAPU8.fill(0, outputsPtr, outputsPtr + count * HASH_SIZE);
+        if (wasm._xzalgochain_batch_wasm(dataPtr, offsetsPtr, count, outputsPtr, threads) !== 0) {
+            throw new Error('xzalgochain_batch_wasm failed');
+        }
+
+        /* Every digest must match one-shot hashing of the same message */
+        let mismatches = 0;
+        for (let i = 0; i < count; i++) {
+            wasm._xzalgochain_wasm(dataPtr + i * size, size, refPtr);
+            const ref = wasm.HEAPU8.subarray(refPtr, refPtr + HASH_SIZE);
+            const out = wasm.HEAPU8.subarray(outputsPtr + i * HASH_SIZE, outputsPtr + (i + 1) * HASH_SIZE);
+            if (!ref.every((b, j) => b === out[j])) mismatches++;
+        }
+        failures += mismatches;
+
+        let batches = 0;
+        const start = process.hrtime.bigint();
+        let elapsedMs = 0;
+        do {
+            wasm._xzalgochain_batch_wasm(dataPtr, offsetsPtr, count, outputsPtr, threads);
+            batches++;
+            elapsedMs = Number(process.hrtime.bigint() - start) / 1e6;
+        } while (elapsedMs < BENCH_MIN_MS);
+
+        const mbPerSec = (count * size * batches) / (elapsedMs / 1000) / (1024 * 1024);
+        if (threads === 1) single = mbPerSec;
+        console.log(`${String(threads).padEnd(11)}${mbPerSec.toFixed(2).padEnd(12)}${(mbPerSec / single).toFixed(2).padEnd(11)}${mismatches ? 'FAIL' : 'PASS'}`);
+    }
+
+    wasm._free(dataPtr);
+    wasm._free(offsetsPtr);
+    wasm._free(outputsPtr);
+    wasm._free(refPtr);
+
+    console.log(`\nResult: ${failures ? 'FAIL' : 'PASS'}`);
+    process.exitCode = failures ? 1 : 0;
+}
+
+main().catch(err => {
+    console.error(err);
+    process.exitCode = 1;
+}).finally(() => {
+    /* The pthread pool keeps Node.js alive; exit explicitly */
+    setImmediate(() => process.exit());
+});
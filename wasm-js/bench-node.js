@@ -0,0 +1,121 @@
+#!/usr/bin/env node
+/*
+ * bench-node.js
+ *
+ * Node.js / WASI Streaming Benchmark
+ *
+ * Purpose:
+ *   1. Checks that streaming a file through xzalgochain-stream.js gives the
+ *      same digest as the native xzalgo320sum
+ *   2. Compares throughput of the WASI build, the Emscripten builds and native
+ *
+ * Usage:
+ *   Build:  make && ./wasm-build.sh
+ *   Run:    node wasm-js/bench-node.js [file] [wasm-output-dir] [xzalgo320sum]
+ *           Without a file, a 256 MiB temporary file is hashed
+ *
+ * Author: Xzrayツ
+ */
+
+'use strict';
+
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const XzalgoChainStream = require('./xzalgochain-stream.js');
+
+/* ======================== CONFIGURATION ======================== */
+const TEMP_FILE_SIZE = 256 * 1024 * 1024;
+const BLOCK = 1024 * 1024;
+
+/* ======================== HELPERS ======================== */
+function makeTempFile() {
+    const file = path.join(os.tmpdir(), `xzalgochain-bench-${process.pid}.bin`);
+    const fd = fs.openSync(file, 'w');
+    const block = Buffer.alloc(BLOCK);
+    for (let off = 0; off < TEMP_FILE_SIZE; off += BLOCK) {
+        for (let i = 0; i < BLOCK; i++) block[i] = ((off + i) * 131 + 7) & 0xFF;
+        fs.writeSync(fd, block);
+    }
+    fs.closeSync(fd);
+    return file;
+}
+
+function findNative(hint) {
+    const candidates = hint ? [hint] : [path.join(__dirname, '..', 'xzalgo320sum')];
+    for (const candidate of candidates) {
+        if (fs.existsSync(candidate)) return path.resolve(candidate);
+    }
+    return hint ? null : 'xzalgo320sum'; /* Fall back to PATH */
+}
+
+function runNative(binary, file) {
+    const start = process.hrtime.bigint();
+    const result = spawnSync(binary, [file], { encoding: 'utf8' });
+    const ms = Number(process.hrtime.bigint() - start) / 1e6;
+    if (result.error || result.status !== 0) return null;
+    return { hex: result.stdout.split(/\s+/)[0], ms };
+}
+
+async function runWasm(options, file) {
+    const xz = await XzalgoChainStream.load(options);
+    const start = process.hrtime.bigint();
+    const hex = (await xz.hashFile(file)).toString('hex');
+    return { flavor: xz.flavor, hex, ms: Number(process.hrtime.bigint() - start) / 1e6 };
+}
+
+/* ======================== MAIN ======================== */
+async function main() {
+    const temp = !process.argv[2];
+    const file = temp ? makeTempFile() : path.resolve(process.argv[2]);
+    const baseUrl = path.resolve(process.argv[3] || path.join(__dirname, '..', 'wasm')) + path.sep;
+    const native = findNative(process.argv[4]);
+    const mib = fs.statSync(file).size / (1024 * 1024);
+
+    try {
+        console.log('===== Node.js / WASI Streaming Benchmark =====');
+        console.log(`File: ${file} (${mib.toFixed(1)} MiB)\n`);
+
+        /* Warm the page cache so every run reads from memory */
+        if (native) runNative(native, file);
+        const nativeRun = native ? runNative(native, file) : null;
+
+        const rows = [];
+        if (nativeRun) rows.push({ flavor: 'native', ...nativeRun });
+        else console.log('xzalgo320sum not found; build it with make (native row skipped)\n');
+
+        for (const options of [{ standalone: true }, { standalone: false, simd: true }, { standalone: false, simd: false }]) {
+            try {
+                rows.push(await runWasm(Object.assign({ baseUrl }, options), file));
+            } catch (e) {
+                /* Build not present (--no-minimal, --no-simd) */
+            }
+        }
+
+        const reference = nativeRun ? nativeRun.hex : rows.length ? rows[0].hex : null;
+        let failures = 0;
+        console.log('Build        MB/s        vs native   Digest');
+        for (const row of rows) {
+            const ok = row.hex === reference;
+            if (!ok) failures++;
+            const mbPerSec = mib / (row.ms / 1000);
+            const ratio = nativeRun ? (nativeRun.ms / row.ms).toFixed(2) + 'x' : '-';
+            console.log(`${row.flavor.padEnd(13)}${mbPerSec.toFixed(2).padEnd(12)}${ratio.padEnd(12)}${ok ? 'PASS' : 'FAIL'}`);
+        }
+
+        if (!rows.some(row => row.flavor !== 'native')) {
+            console.log('\nNo WASM build found; run ./wasm-build.sh first');
+            failures++;
+        }
+        console.log(`\nResult: ${failures ? 'FAIL' : 'PASS'}`);
+        process.exitCode = failures ? 1 : 0;
+    } finally {
+        if (temp) fs.unlinkSync(file);
+    }
+}
+
+main().catch(err => {
+    console.error(err);
+    process.exitCode = 1;
+});
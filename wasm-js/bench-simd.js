@@ -0,0 +1,155 @@
+#!/usr/bin/env node
+/*
+ * bench-simd.js
+ *
+ * WASM SIMD128 Benchmark
+ *
+ * Purpose:
+ *   1. Checks that the baseline and SIMD128 WebAssembly builds produce the
+ *      same digests as the native library (reference vectors below)
+ *   2. Compares their throughput for several message sizes
+ *
+ * Usage:
+ *   Build:  ./wasm-build.sh
+ *   Run:    node wasm-js/bench-simd.js [wasm-output-dir]
+ *
+ * Author: Xzrayツ
+ */
+
+'use strict';
+
+const path = require('path');
+const XzalgoChainLoader = require('./xzalgochain-loader.js');
+
+/* ======================== CONFIGURATION ======================== */
+const HASH_SIZE = 40;
+const BENCH_SIZES = [64, 1024, 64 * 1024, 1024 * 1024];
+const BENCH_MIN_MS = 500;
+
+/* Native digests of buf[i] = (i * 131 + 7) & 0xFF for each length */
+const REFERENCE_VECTORS = [
+    [0, '6b6ef71c2d5a4bd8527a596124a39b251900a95cdbaa5ca419ce172343820dd6c15bdd3cc5b023b8'],
+    [1, '1aa82539edfd417771d9bfeebe5370d89b9f12151ccf7381beee4fef3009e53623812630ffd0a385'],
+    [3, 'e45695da071180ea0d462f93cb8fbe32d736b9eead509c8212f2f610d36a672f9ad51be9e6212b17'],
+    [64, '1510326a57002d8ba770311d43e338ea11c5bb5a1c841cda267660e6f7a141b51256eab570109932'],
+    [127, '380e05a3cd347dcf3f97439d3234d04329ffd24add86d070c5936e08619595d12d021cac68ffa77d'],
+    [128, 'c25c7f9baf0dabbce20d76aeb37fd515de85be61776a4354930f157135d7f7da6b7c29af8658cf23'],
+    [129, 'd07db414de94ff083f8f85464b21b3532f09c1a620aaeb38fe27f1402f0384a3ac912653f141640d'],
+    [255, 'f32f65a7560681ee7f30834c047b6d88bcb282c86661994b138714c9dac492bc20323ac547de9de3'],
+    [256, '6b87fc3f9d91695efeb223f536a0ff2ac56d5faf49504875025eb679a490b51b14380c29a7a8432a'],
+    [1000, '102991b8c5f81bee64a9d730c7bd4cadb46193415432e00e95e4e0bd534be76ab1c18855d8903b77'],
+    [4999, '0939f0ad29d1d50dd698ecd47c16276db12e02f533ca656f777d89455d639f4bd0b524b679c4f98a']
+];
+
+/* ======================== UTILITY FUNCTIONS ======================== */
+function patternBytes(len) {
+    const data = new Uint8Array(len);
+    for (let i = 0; i < len; i++) data[i] = (i * 131 + 7) & 0xFF;
+    return data;
+}
+
+function bytesToHex(bytes) {
+    return Array.from(bytes, b => b.toString(16).padStart(2, '0')).join('');
+}
+
+/**
+ * Hasher bound to one module, reusing a single input/output allocation
+ */
+function makeHasher(wasm, maxLen) {
+    const dataPtr = wasm._malloc(Math.max(maxLen, 1));
+    const outputPtr = wasm._malloc(HASH_SIZE);
+
+    return {
+        load(data) {
+            wasm.HEAPU8.set(data, dataPtr);
+        },
+        hash(len) {
+            wasm._xzalgochain_wasm(dataPtr, len, outputPtr);
+            return wasm.HEAPU8.subarray(outputPtr, outputPtr + HASH_SIZE);
+        },
+        free() {
+            wasm._free(dataPtr);
+            wasm._free(outputPtr);
+        }
+    };
+}
+
+/* ======================== TESTS ======================== */
+function checkVectors(name, wasm) {
+    const maxLen = REFERENCE_VECTORS[REFERENCE_VECTORS.length - 1][0];
+    const hasher = makeHasher(wasm, maxLen);
+    let failures = 0;
+
+    hasher.load(patternBytes(maxLen));
+    for (const [len, expected] of REFERENCE_VECTORS) {
+        if (bytesToHex(hasher.hash(len)) !== expected) {
+            console.log(`  ${name}: MISMATCH at length ${len}`);
+            failures++;
+        }
+    }
+    hasher.free();
+
+    console.log(`  ${name.padEnd(8)} vectors: ${failures ? 'FAIL' : 'PASS'} (${REFERENCE_VECTORS.length - failures}/${REFERENCE_VECTORS.length})`);
+    return failures;
+}
+
+function bench(wasm, size) {
+    const hasher = makeHasher(wasm, size);
+    hasher.load(patternBytes(size));
+
+    /* Warm up, then run until BENCH_MIN_MS has elapsed */
+    for (let i = 0; i < 3; i++) hasher.hash(size);
+
+    let iterations = 0;
+    const start = process.hrtime.bigint();
+    let elapsedMs = 0;
+    do {
+        hasher.hash(size);
+        iterations++;
+        elapsedMs = Number(process.hrtime.bigint() - start) / 1e6;
+    } while (elapsedMs < BENCH_MIN_MS);
+
+    hasher.free();
+    return {
+        usPerHash: (elapsedMs * 1000) / iterations,
+        mbPerSec: (size * iterations) / (elapsedMs / 1000) / (1024 * 1024)
+    };
+}
+
+/* ======================== MAIN ======================== */
+async function main() {
+    const baseUrl = path.resolve(process.argv[2] || path.join(__dirname, '..', 'wasm')) + path.sep;
+
+    console.log('===== WASM SIMD128 Benchmark =====');
+    console.log(`Engine SIMD128 support: ${XzalgoChainLoader.simdSupported() ? 'Yes' : 'No'}\n`);
+
+    const modules = [['Baseline', await XzalgoChainLoader.load({ simd: false, baseUrl })]];
+    if (XzalgoChainLoader.simdSupported()) {
+        modules.push(['SIMD128', await XzalgoChainLoader.load({ simd: true, baseUrl })]);
+    }
+
+    for (const [name, wasm] of modules) {
+        console.log(`  ${name.padEnd(8)} backend: ${wasm.UTF8ToString(wasm._xzalgochain_backend_name_wasm())}`);
+    }
+    console.log('');
+
+    let failures = 0;
+    for (const [name, wasm] of modules) failures += checkVectors(name, wasm);
+    console.log('');
+
+    console.log('Size       ' + modules.map(([name]) => `${name} (us/hash, MB/s)`.padEnd(30)).join('') + 'Speedup');
+    for (const size of BENCH_SIZES) {
+        const results = modules.map(([, wasm]) => bench(wasm, size));
+        const cells = results.map(r => `${r.usPerHash.toFixed(2).padStart(10)} ${r.mbPerSec.toFixed(2).padStart(10)}`.padEnd(30));
+        const speedup = results.length > 1 ? `${(results[0].usPerHash / results[1].usPerHash).toFixed(2)}x` : '-';
+        console.log(`${String(size).padEnd(11)}${cells.join('')}${speedup}`);
+    }
+
+    console.log(`\nResult: ${failures ? 'FAIL' : 'PASS'}`);
+    process.exitCode = failures ? 1 : 0;
+}
+
+main().catch(err => {
+    console.error(err);
+    process.exitCode = 1;
+});
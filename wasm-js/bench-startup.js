@@ -0,0 +1,159 @@
+#!/usr/bin/env node
+/*
+ * bench-startup.js
+ *
+ * WASM Startup Benchmark
+ *
+ * Purpose:
+ *   1. Checks that the minimal standalone build (XzalgoChain-min.wasm, no JS glue)
+ *      returns the same digest as the baseline Emscripten build
+ *   2. Compares download size and cold instantiate time of the two builds
+ *
+ * Usage:
+ *   Build:  ./wasm-build.sh
+ *   Run:    node wasm-js/bench-startup.js [wasm-output-dir] [--markdown]
+ *
+ * Author: Xzrayツ
+ */
+
+'use strict';
+
+const fs = require('fs');
+const path = require('path');
+
+/* ======================== CONFIGURATION ======================== */
+const HASH_SIZE = 40;
+const RUNS = 25;
+const REFERENCE_INPUT = 'Hello, World';
+const REFERENCE_HEX = 'e8154c62a6afde90685824f16e5e537358e9b53fda49260f5139c699e78534988ee922d11d38c35f';
+
+/* ======================== HELPERS ======================== */
+function toHex(bytes) {
+    return Array.from(bytes, b => b.toString(16).padStart(2, '0')).join('');
+}
+
+function median(values) {
+    const sorted = values.slice().sort((a, b) => a - b);
+    return sorted[Math.floor(sorted.length / 2)];
+}
+
+function kib(bytes) {
+    return (bytes / 1024).toFixed(1) + ' KiB';
+}
+
+/**
+ * Instantiate a standalone module, stubbing whatever it imports
+ * The minimal build imports at most a memory-growth notification and a few
+ * WASI calls that the hash exports never reach
+ */
+async function instantiateStandalone(bytes) {
+    const module = await WebAssembly.compile(bytes);
+    const imports = {};
+    for (const imp of WebAssembly.Module.imports(module)) {
+        if (imp.kind !== 'function') continue;
+        imports[imp.module] = imports[imp.module] || {};
+        imports[imp.module][imp.name] = () => 0;
+    }
+    const instance = await WebAssembly.instantiate(module, imports);
+    if (instance.exports._initialize) instance.exports._initialize();
+    return instance.exports;
+}
+
+function hashStandalone(exports, text) {
+    const data = Buffer.from(text, 'utf8');
+    const dataPtr = exports.malloc(data.length);
+    const outPtr = exports.malloc(HASH_SIZE);
+    new Uint8Array(exports.memory.buffer).set(data, dataPtr);
+    exports.xzalgochain_wasm(dataPtr, data.length, outPtr);
+    const hex = toHex(new Uint8Array(exports.memory.buffer, outPtr, HASH_SIZE));
+    exports.free(dataPtr);
+    exports.free(outPtr);
+    return hex;
+}
+
+function hashGlue(wasm, text) {
+    const data = Buffer.from(text, 'utf8');
+    const dataPtr = wasm._malloc(data.length);
+    const outPtr = wasm._malloc(HASH_SIZE);
+    for (let i = 0; i < data.length; i++) wasm.setValue(dataPtr + i, data[i], 'i8');
+    wasm._xzalgochain_wasm(dataPtr, data.length, outPtr);
+    const out = new Uint8Array(HASH_SIZE);
+    for (let i = 0; i < HASH_SIZE; i++) out[i] = wasm.getValue(outPtr + i, 'i8') & 0xFF;
+    wasm._free(dataPtr);
+    wasm._free(outPtr);
+    return toHex(out);
+}
+
+/**
+ * Time RUNS cold instantiations (compile + instantiate + first hash)
+ * @returns {Promise<{ms: number, hex: string}>} - Median time and the digest
+ */
+async function timeRuns(start) {
+    const times = [];
+    let hex = '';
+    for (let i = 0; i < RUNS; i++) {
+        const t0 = process.hrtime.bigint();
+        hex = await start();
+        times.push(Number(process.hrtime.bigint() - t0) / 1e6);
+    }
+    return { ms: median(times), hex };
+}
+
+/* ======================== MAIN ======================== */
+async function main() {
+    const args = process.argv.slice(2);
+    const markdown = args.includes('--markdown');
+    const dir = path.resolve(args.find(a => !a.startsWith('--')) || path.join(__dirname, '..', 'wasm'));
+    const rows = [];
+
+    /* Baseline: Emscripten glue; its script is parsed once, the factory compiles each run.
+     * Both builds get their bytes from memory so that only startup is timed */
+    const glueScript = path.join(dir, 'XzalgoChain.js');
+    const glueWasm = path.join(dir, 'XzalgoChain.wasm');
+    if (fs.existsSync(glueScript) && fs.existsSync(glueWasm)) {
+        const factory = require(glueScript);
+        const bytes = fs.readFileSync(glueWasm);
+        const run = await timeRuns(async () => hashGlue(await factory({ wasmBinary: bytes }), REFERENCE_INPUT));
+        rows.push({ name: 'XzalgoChain (Emscripten glue)', wasm: bytes.length, js: fs.statSync(glueScript).size, ...run });
+    }
+
+    /* Minimal: raw WebAssembly API, no glue */
+    const minWasm = path.join(dir, 'XzalgoChain-min.wasm');
+    if (fs.existsSync(minWasm)) {
+        const bytes = fs.readFileSync(minWasm);
+        const run = await timeRuns(async () => hashStandalone(await instantiateStandalone(bytes), REFERENCE_INPUT));
+        rows.push({ name: 'XzalgoChain-min (standalone)', wasm: bytes.length, js: 0, ...run });
+    }
+
+    if (rows.length === 0) {
+        throw new Error(`No WASM builds found in ${dir}`);
+    }
+
+    let failures = 0;
+    for (const row of rows) {
+        row.ok = row.hex === REFERENCE_HEX;
+        if (!row.ok) failures++;
+    }
+
+    if (markdown) {
+        console.log(`| Build | .wasm | JS glue | Instantiate (median of ${RUNS}) | Digest |`);
+        console.log('|-------|-------|---------|------------------------|--------|');
+        for (const row of rows) {
+            console.log(`| ${row.name} | ${kib(row.wasm)} | ${row.js ? kib(row.js) : '-'} | ${row.ms.toFixed(2)} ms | ${row.ok ? 'PASS' : 'FAIL'} |`);
+        }
+    } else {
+        console.log('===== WASM Startup Benchmark =====');
+        console.log(`Node.js ${process.version}, ${RUNS} runs each\n`);
+        console.log('Build                          .wasm        JS glue      Instantiate   Digest');
+        for (const row of rows) {
+            console.log(`${row.name.padEnd(31)}${kib(row.wasm).padEnd(13)}${(row.js ? kib(row.js) : '-').padEnd(13)}${(row.ms.toFixed(2) + ' ms').padEnd(14)}${row.ok ? 'PASS' : 'FAIL'}`);
+        }
+        console.log(`\nResult: ${failures ? 'FAIL' : 'PASS'}`);
+    }
+    process.exitCode = failures ? 1 : 0;
+}
+
+main().catch(err => {
+    console.error(err);
+    process.exitCode = 1;
+});
@@ -0,0 +1,291 @@
+/*
+ * XzalgoChain - 320-bit Cryptographic Hash Function
+ * Copyright 2026 Xzrayツ
+ *
+ * xzalgochain-hasher.js - Zero-copy JavaScript bindings for the WebAssembly module
+ * Keeps one reusable, growable arena in WASM memory for input and output,
+ * moves bytes with HEAPU8.set()/subarray() instead of per-byte setValue/getValue,
+ * and hashes whole arrays of messages in a single call into WASM.
+ * Works as a classic <script>, in Web Workers and in Node.js.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+(function (root, factory) {
+    if (typeof module === 'object' && module.exports) {
+        module.exports = factory();
+    } else {
+        root.XzalgoChainHasher = factory();
+    }
+})(typeof self !== 'undefined' ? self : this, function () {
+    'use strict';
+
+    /* ==================== CONSTANTS ==================== */
+    const HASH_SIZE = 40;              /* 320-bit digest */
+    const ARENA_INITIAL_SIZE = 64 * 1024;
+
+    const encoder = new TextEncoder();
+
+    /* A browser page's main thread must not block on the threaded batch call */
+    const onPageThread = typeof window !== 'undefined' && typeof document !== 'undefined';
+
+    /**
+     * Convert digest bytes to a lowercase hex string
+     * @param {Uint8Array} bytes - Digest bytes
+     * @returns {string} - Hex string
+     */
+    function toHex(bytes) {
+        let hex = '';
+        for (let i = 0; i < bytes.length; i++) {
+            hex += (bytes[i] < 16 ? '0' : '') + bytes[i].toString(16);
+        }
+        return hex;
+    }
+
+    /**
+     * View any supported input as bytes without copying
+     * @param {string|Uint8Array|ArrayBuffer|ArrayBufferView} input - Message
+     * @returns {Uint8Array|string} - Byte view, or the string itself (encoded later)
+     */
+    function asBytes(input) {
+        if (typeof input === 'string' || input instanceof Uint8Array) return input;
+        if (input instanceof ArrayBuffer) return new Uint8Array(input);
+        if (ArrayBuffer.isView(input)) return new Uint8Array(input.buffer, input.byteOffset, input.byteLength);
+        throw new TypeError('Input must be a string, Uint8Array, ArrayBuffer or ArrayBufferView');
+    }
+
+    /* ==================== HASHER ==================== */
+
+    /**
+     * Hasher bound to one XzalgoChain WASM module instance
+     * Not safe to share between concurrent callers of the same module.
+     * Modules built before HEAPU8/HEAPU32 were exported still work, through
+     * the slow setValue/getValue path.
+     * @param {Object} wasm - Module returned by XzalgoChain() or XzalgoChainLoader.load()
+     */
+    function XzalgoChainHasher(wasm) {
+        if (!wasm || typeof wasm._xzalgochain_wasm !== 'function') {
+            throw new Error('XzalgoChain module required');
+        }
+        this.wasm = wasm;
+        this.legacy = !wasm.HEAPU8 || !wasm.HEAPU32;
+        this.arenaPtr = 0;
+        this.arenaSize = 0;
+        this.reserve(ARENA_INITIAL_SIZE);
+    }
+
+    /**
+     * Load a module with XzalgoChainLoader and wrap it
+     * @param {Object} [options] - Options for XzalgoChainLoader.load()
+     * @returns {Promise<XzalgoChainHasher>}
+     */
+    XzalgoChainHasher.create = function (options) {
+        const loader = typeof XzalgoChainLoader !== 'undefined'
+            ? XzalgoChainLoader
+            : require('./xzalgochain-loader.js');
+        return loader.load(options).then(function (wasm) {
+            return new XzalgoChainHasher(wasm);
+        });
+    };
+
+    XzalgoChainHasher.HASH_SIZE = HASH_SIZE;
+    XzalgoChainHasher.toHex = toHex;
+
+    /**
+     * Make sure the arena holds at least size bytes
+     * Grows geometrically, so a run of growing inputs reallocates O(log n) times
+     * @param {number} size - Required arena size in bytes
+     */
+    XzalgoChainHasher.prototype.reserve = function (size) {
+        if (size <= this.arenaSize) return;
+
+        let newSize = Math.max(this.arenaSize, ARENA_INITIAL_SIZE);
+        while (newSize < size) newSize *= 2;
+
+        const ptr = this.wasm._malloc(newSize);
+        if (!ptr) throw new Error('Failed to allocate ' + newSize + ' bytes of WASM memory');
+        if (this.arenaPtr) this.wasm._free(this.arenaPtr);
+
+        this.arenaPtr = ptr;
+        this.arenaSize = newSize;
+    };
+
+    /**
+     * Copy one message into WASM memory at ptr
+     * Strings are UTF-8 encoded straight into the heap when it is not shared
+     * @param {Uint8Array|string} bytes - Message from asBytes()
+     * @param {number} ptr - Destination address
+     * @returns {number} - Number of bytes written
+     */
+    XzalgoChainHasher.prototype.write = function (bytes, ptr) {
+        if (this.legacy) {
+            if (typeof bytes === 'string') bytes = encoder.encode(bytes);
+            for (let i = 0; i < bytes.length; i++) this.wasm.setValue(ptr + i, bytes[i], 'i8');
+            return bytes.length;
+        }
+
+        /* Re-read HEAPU8 every time: memory growth replaces the view */
+        const heap = this.wasm.HEAPU8;
+
+        if (typeof bytes !== 'string') {
+            heap.set(bytes, ptr);
+            return bytes.length;
+        }
+        if (typeof encoder.encodeInto === 'function' && heap.buffer instanceof ArrayBuffer) {
+            return encoder.encodeInto(bytes, heap.subarray(ptr, ptr + bytes.length * 3)).written;
+        }
+        const encoded = encoder.encode(bytes);
+        heap.set(encoded, ptr);
+        return encoded.length;
+    };
+
+    /**
+     * Copy len bytes out of WASM memory
+     * @param {number} ptr - Source address
+     * @param {number} len - Number of bytes
+     * @returns {Uint8Array} - Copy of the bytes
+     */
+    XzalgoChainHasher.prototype.read = function (ptr, len) {
+        if (this.legacy) {
+            const out = new Uint8Array(len);
+            for (let i = 0; i < len; i++) out[i] = this.wasm.getValue(ptr + i, 'i8');
+            return out;
+        }
+        return this.wasm.HEAPU8.slice(ptr, ptr + len);
+    };
+
+    /**
+     * Store a uint32 in WASM memory
+     * @param {number} ptr - 4-byte aligned address
+     * @param {number} value - Value to store
+     */
+    XzalgoChainHasher.prototype.writeU32 = function (ptr, value) {
+        if (this.legacy) {
+            this.wasm.setValue(ptr, value, 'i32');
+        } else {
+            this.wasm.HEAPU32[ptr >> 2] = value;
+        }
+    };
+
+    /**
+     * Hash one message
+     * @param {string|Uint8Array|ArrayBuffer|ArrayBufferView} input - Message (strings are UTF-8)
+     * @returns {Uint8Array} - 40-byte digest (a copy, safe to keep)
+     */
+    XzalgoChainHasher.prototype.hash = function (input) {
+        const bytes = asBytes(input);
+        const maxLen = typeof bytes === 'string' ? bytes.length * 3 : bytes.length;
+
+        /* Arena layout: [digest][message] */
+        this.reserve(HASH_SIZE + maxLen);
+        const outPtr = this.arenaPtr;
+        const dataPtr = outPtr + HASH_SIZE;
+
+        const len = this.write(bytes, dataPtr);
+        this.wasm._xzalgochain_wasm(dataPtr, len, outPtr);
+        return this.read(outPtr, HASH_SIZE);
+    };
+
+    /**
+     * Hash one message and return the digest as hex
+     * @param {string|Uint8Array|ArrayBuffer|ArrayBufferView} input - Message
+     * @returns {string} - 80-character lowercase hex digest
+     */
+    XzalgoChainHasher.prototype.hashHex = function (input) {
+        return toHex(this.hash(input));
+    };
+
+    /**
+     * Hash many messages with a single call into WASM
+     * Uses xzalgochain_batch_wasm(), which runs on the worker pool in the
+     * threaded build and serially in the others. The threaded call blocks
+     * until the pool is done, so on a page's main thread it is given one
+     * thread; call from a Web Worker to use the pool.
+     * @param {Array<string|Uint8Array|ArrayBuffer|ArrayBufferView>} inputs - Messages
+     * @param {number} [numThreads=0] - Threads for the threaded build, 0 for all cores
+     * @returns {Uint8Array[]} - 40-byte digests, in input order
+     */
+    XzalgoChainHasher.prototype.hashBatch = function (inputs, numThreads) {
+        const count = inputs.length;
+        if (count === 0) return [];
+        if (typeof this.wasm._xzalgochain_batch_wasm !== 'function') {
+            return inputs.map(this.hash, this);
+        }
+
+        const messages = new Array(count);
+        let maxTotal = 0;
+        for (let i = 0; i < count; i++) {
+            messages[i] = asBytes(inputs[i]);
+            maxTotal += typeof messages[i] === 'string' ? messages[i].length * 3 : messages[i].length;
+        }
+
+        /* Arena layout: [offsets: (count + 1) x uint32][digests: count x 40][messages] */
+        const offsetsSize = (count + 1) * 4;
+        const outputsSize = count * HASH_SIZE;
+        this.reserve(offsetsSize + outputsSize + maxTotal);
+
+        const offsetsPtr = this.arenaPtr;
+        const outputsPtr = offsetsPtr + offsetsSize;
+        const dataPtr = outputsPtr + outputsSize;
+
+        let offset = 0;
+        for (let i = 0; i < count; i++) {
+            this.writeU32(offsetsPtr + i * 4, offset);
+            offset += this.write(messages[i], dataPtr + offset);
+        }
+        this.writeU32(offsetsPtr + count * 4, offset);
+
+        const threads = onPageThread ? 1 : numThreads || 0;
+        if (this.wasm._xzalgochain_batch_wasm(dataPtr, offsetsPtr, count, outputsPtr, threads) !== 0) {
+            throw new Error('xzalgochain_batch_wasm failed');
+        }
+
+        const all = this.read(outputsPtr, outputsSize);
+        const digests = new Array(count);
+        for (let i = 0; i < count; i++) {
+            digests[i] = all.subarray(i * HASH_SIZE, (i + 1) * HASH_SIZE);
+        }
+        return digests;
+    };
+
+    /**
+     * Hash many messages and return the digests as hex
+     * @param {Array<string|Uint8Array|ArrayBuffer|ArrayBufferView>} inputs - Messages
+     * @param {number} [numThreads=0] - Threads for the threaded build, 0 for all cores
+     * @returns {string[]} - Hex digests, in input order
+     */
+    XzalgoChainHasher.prototype.hashBatchHex = function (inputs, numThreads) {
+        return this.hashBatch(inputs, numThreads).map(toHex);
+    };
+
+    /**
+     * Compare a message against an expected hex digest
+     * @param {string|Uint8Array|ArrayBuffer|ArrayBufferView} input - Message
+     * @param {string} expectedHex - Expected 80-character hex digest
+     * @returns {boolean} - True if the digest matches
+     */
+    XzalgoChainHasher.prototype.verify = function (input, expectedHex) {
+        return this.hashHex(input) === String(expectedHex).trim().toLowerCase();
+    };
+
+    /**
+     * Release the arena; the hasher must not be used afterwards
+     */
+    XzalgoChainHasher.prototype.dispose = function () {
+        if (this.arenaPtr) this.wasm._free(this.arenaPtr);
+        this.arenaPtr = 0;
+        this.arenaSize = 0;
+    };
+
+    return XzalgoChainHasher;
+});
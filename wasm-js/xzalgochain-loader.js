@@ -0,0 +1,202 @@
+/*
+ * XzalgoChain - 320-bit Cryptographic Hash Function
+ * Copyright 2026 Xzrayツ
+ *
+ * xzalgochain-loader.js - Loads the best WebAssembly build for the running engine
+ * Picks XzalgoChain-simd.{js,wasm} (built with -msimd128) when the engine
+ * validates SIMD128 code, and the baseline XzalgoChain.{js,wasm} otherwise.
+ * With { threads: true } it loads the threaded XzalgoChain-mt.{js,wasm}
+ * when SharedArrayBuffer is usable.
+ * Works as a classic <script>, in Web Workers (importScripts) and in Node.js.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+(function (root, factory) {
+    if (typeof module === 'object' && module.exports) {
+        module.exports = factory(root);
+    } else {
+        root.XzalgoChainLoader = factory(root);
+    }
+})(typeof self !== 'undefined' ? self : this, function (root) {
+    'use strict';
+
+    /* ==================== BUILD FLAVORS ==================== */
+    const FLAVORS = {
+        simd: { script: 'XzalgoChain-simd.js', exportName: 'XzalgoChainSIMD' },
+        baseline: { script: 'XzalgoChain.js', exportName: 'XzalgoChain' },
+        mt: { script: 'XzalgoChain-mt.js', exportName: 'XzalgoChainMT' }
+    };
+
+    /**
+     * Smallest module using a SIMD128 instruction:
+     * (func (result v128) (i8x16.popcnt (i8x16.splat (i32.const 0))))
+     * Engines without SIMD128 reject it in WebAssembly.validate()
+     */
+    const SIMD_PROBE = new Uint8Array([
+        0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3,
+        2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11
+    ]);
+
+    const isNode = typeof process === 'object' && process.versions != null && process.versions.node != null;
+
+    /* Directory of this script, used as the default location of the modules */
+    let defaultBaseUrl = '';
+    if (isNode) {
+        defaultBaseUrl = __dirname + '/';
+    } else if (typeof document !== 'undefined' && document.currentScript) {
+        defaultBaseUrl = document.currentScript.src.replace(/[^/]*$/, '');
+    } else if (typeof location !== 'undefined') {
+        defaultBaseUrl = location.href.replace(/[^/]*$/, '');
+    }
+
+    let simdCache = null;
+
+    /**
+     * Check whether this engine can run the SIMD128 build
+     * @returns {boolean} - True if WebAssembly SIMD128 is supported
+     */
+    function simdSupported() {
+        if (simdCache === null) {
+            try {
+                simdCache = typeof WebAssembly === 'object' && WebAssembly.validate(SIMD_PROBE);
+            } catch (e) {
+                simdCache = false;
+            }
+        }
+        return simdCache;
+    }
+
+    /**
+     * Check whether this engine can run the threaded build
+     * Browsers only expose SharedArrayBuffer to cross-origin isolated pages
+     * @returns {boolean} - True if WebAssembly threads are usable
+     */
+    function threadsSupported() {
+        if (typeof SharedArrayBuffer === 'undefined' || typeof Atomics === 'undefined') {
+            return false;
+        }
+        return isNode || typeof crossOriginIsolated === 'undefined' || crossOriginIsolated === true;
+    }
+
+    /**
+     * Get the Emscripten factory of one build flavor, loading its glue script if needed
+     * @param {string} flavor - 'simd' or 'baseline'
+     * @param {string} baseUrl - Directory containing the module files
+     * @returns {Promise<Function>} - Emscripten MODULARIZE factory
+     */
+    function loadFactory(flavor, baseUrl) {
+        const info = FLAVORS[flavor];
+
+        /* Synchronous loaders run inside a promise so that errors reject it */
+        if (isNode) {
+            return new Promise(function (resolve) {
+                /* The threaded build sizes its pool from navigator.hardwareConcurrency,
+                 * which Node.js only provides from version 21 */
+                if (flavor === 'mt' && typeof navigator === 'undefined') {
+                    globalThis.navigator = { hardwareConcurrency: require('os').cpus().length };
+                }
+                resolve(require(require('path').join(baseUrl, info.script)));
+            });
+        }
+        if (typeof root[info.exportName] === 'function') {
+            return Promise.resolve(root[info.exportName]);
+        }
+        if (typeof importScripts === 'function') {
+            return new Promise(function (resolve) {
+                importScripts(baseUrl + info.script);
+                resolve(root[info.exportName]);
+            });
+        }
+
+        return new Promise(function (resolve, reject) {
+            const script = document.createElement('script');
+            script.src = baseUrl + info.script;
+            script.async = true;
+            script.onload = function () {
+                resolve(root[info.exportName]);
+            };
+            script.onerror = function () {
+                reject(new Error('Failed to load ' + script.src));
+            };
+            document.head.appendChild(script);
+        });
+    }
+
+    /**
+     * Instantiate one build flavor
+     * @param {string} flavor - 'simd' or 'baseline'
+     * @param {string} baseUrl - Directory containing the module files
+     * @param {Object} overrides - Extra Emscripten Module settings
+     * @returns {Promise<Object>} - Ready module, tagged with its flavor
+     */
+    function instantiate(flavor, baseUrl, overrides) {
+        return loadFactory(flavor, baseUrl).then(function (factory) {
+            const settings = Object.assign({
+                locateFile: function (path) {
+                    return baseUrl + path;
+                }
+            }, overrides);
+
+            return factory(settings).then(function (module) {
+                module.xzalgochainFlavor = flavor;
+                return module;
+            });
+        });
+    }
+
+    /**
+     * Load XzalgoChain, choosing the SIMD128 build when the engine supports it
+     * @param {Object} [options]
+     * @param {boolean|string} [options.simd='auto'] - true forces SIMD128, false forces baseline
+     * @param {boolean} [options.threads=false] - Prefer the threaded build when threads are usable
+     * @param {string} [options.baseUrl] - Directory of the module files (default: next to this script)
+     * @param {Object} [options.module] - Extra Emscripten Module settings
+     * @returns {Promise<Object>} - Ready module; module.xzalgochainFlavor is 'simd', 'baseline' or 'mt'
+     */
+    function load(options) {
+        options = options || {};
+        const baseUrl = options.baseUrl || defaultBaseUrl;
+        const overrides = options.module || {};
+        const simd = options.simd === undefined ? 'auto' : options.simd;
+
+        /* Without threads (or the threaded files) use a single-threaded build;
+         * its xzalgochain_batch_wasm() hashes the batch serially */
+        if (options.threads && threadsSupported()) {
+            return instantiate('mt', baseUrl, overrides).catch(function () {
+                return load(Object.assign({}, options, { threads: false }));
+            });
+        }
+
+        if (simd === false) {
+            return instantiate('baseline', baseUrl, overrides);
+        }
+        if (simd === true) {
+            return instantiate('simd', baseUrl, overrides);
+        }
+        if (!simdSupported()) {
+            return instantiate('baseline', baseUrl, overrides);
+        }
+
+        /* A missing SIMD build (built with --no-simd) falls back to baseline */
+        return instantiate('simd', baseUrl, overrides).catch(function () {
+            return instantiate('baseline', baseUrl, overrides);
+        });
+    }
+
+    return {
+        load: load,
+        simdSupported: simdSupported,
+        threadsSupported: threadsSupported
+    };
+});
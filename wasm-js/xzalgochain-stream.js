@@ -0,0 +1,264 @@
+/*
+ * XzalgoChain - 320-bit Cryptographic Hash Function
+ * Copyright 2026 Xzrayツ
+ *
+ * xzalgochain-stream.js - Streaming hashing for Node.js and WASI hosts
+ * Wraps xzalgochain_init/update/final in a stream.Transform and an
+ * async-iterator helper, so files and streams of any size are hashed with
+ * backpressure through one fixed-size chunk buffer in WASM memory.
+ * Runs the standalone XzalgoChain-min.wasm under node:wasi when it is
+ * present, and the Emscripten builds (through xzalgochain-loader.js) otherwise.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+'use strict';
+
+const fs = require('fs');
+const path = require('path');
+const { Transform } = require('stream');
+
+/* ==================== CONSTANTS ==================== */
+const HASH_SIZE = 40;                       /* 320-bit digest */
+const DEFAULT_CHUNK_SIZE = 1024 * 1024;     /* Bytes per update call */
+const STANDALONE_WASM = 'XzalgoChain-min.wasm';
+
+/* ==================== MODULE ADAPTERS ==================== */
+
+/**
+ * Common view of an Emscripten module or of raw standalone exports
+ * @param {Object} module - Emscripten module, or WebAssembly instance exports
+ * @param {string} flavor - Build name, for reporting
+ * @returns {Object} - { malloc, free, heap, ctxNew, ctxFree, update, final, flavor }
+ */
+function adapt(module, flavor) {
+    const raw = typeof module._malloc !== 'function';
+    const fn = function (name) {
+        const f = module[raw ? name : '_' + name];
+        if (typeof f !== 'function') {
+            throw new Error('WASM module lacks ' + name + '; rebuild it with wasm-build.sh');
+        }
+        return f;
+    };
+
+    if (!raw && !module.HEAPU8) {
+        throw new Error('WASM module lacks HEAPU8; rebuild it with wasm-build.sh');
+    }
+
+    return {
+        malloc: fn('malloc'),
+        free: fn('free'),
+        ctxNew: fn('xzalgochain_ctx_new_wasm'),
+        ctxFree: fn('xzalgochain_ctx_free_wasm'),
+        update: fn('xzalgochain_update_wasm'),
+        final: fn('xzalgochain_final_wasm'),
+        /* Re-read on every use: memory growth replaces the buffer */
+        heap: raw
+            ? function () { return new Uint8Array(module.memory.buffer); }
+            : function () { return module.HEAPU8; },
+        flavor: flavor || module.xzalgochainFlavor || 'unknown'
+    };
+}
+
+/**
+ * Instantiate the standalone build as a WASI reactor
+ * Imports outside WASI are only reachable on error paths and are stubbed
+ * @param {string} file - Path to XzalgoChain-min.wasm
+ * @returns {Promise<Object>} - Instance exports
+ */
+async function instantiateWasi(file) {
+    const { WASI } = require('wasi');
+    const wasi = new WASI({ version: 'preview1' });
+    const module = await WebAssembly.compile(await fs.promises.readFile(file));
+
+    const imports = { wasi_snapshot_preview1: wasi.wasiImport };
+    for (const imp of WebAssembly.Module.imports(module)) {
+        if (imp.kind !== 'function') continue;
+        imports[imp.module] = imports[imp.module] || {};
+        if (!imports[imp.module][imp.name]) imports[imp.module][imp.name] = () => 0;
+    }
+
+    const instance = await WebAssembly.instantiate(module, imports);
+    wasi.initialize(instance);
+    return instance.exports;
+}
+
+/* ==================== HASH STREAM ==================== */
+
+/**
+ * Transform stream computing an XzalgoChain digest
+ * Behaves like crypto.Hash: write the message, end the stream, read one
+ * 40-byte Buffer. update()/digest() work without piping.
+ * @param {Object} engine - Adapter from adapt()
+ * @param {Object} [options] - Transform options plus chunkSize
+ */
+class XzalgoChainHashStream extends Transform {
+    constructor(engine, options) {
+        options = options || {};
+        super(options);
+        this.engine = engine;
+        this.chunkSize = options.chunkSize || DEFAULT_CHUNK_SIZE;
+        this.ctxPtr = engine.ctxNew();
+        this.bufPtr = engine.malloc(this.chunkSize);
+        this.outPtr = engine.malloc(HASH_SIZE);
+
+        if (!this.ctxPtr || !this.bufPtr || !this.outPtr) {
+            this.release();
+            throw new Error('Failed to allocate WASM memory');
+        }
+    }
+
+    /**
+     * Absorb data, split into chunkSize pieces
+     * @param {Buffer|Uint8Array|string} data - Message bytes (strings are UTF-8)
+     * @returns {XzalgoChainHashStream} - this, for chaining
+     */
+    update(data) {
+        if (!this.ctxPtr) throw new Error('Digest already called');
+        if (typeof data === 'string') data = Buffer.from(data, 'utf8');
+
+        for (let off = 0; off < data.length; off += this.chunkSize) {
+            const piece = data.subarray(off, Math.min(off + this.chunkSize, data.length));
+            this.engine.heap().set(piece, this.bufPtr);
+            this.engine.update(this.ctxPtr, this.bufPtr, piece.length);
+        }
+        return this;
+    }
+
+    /**
+     * Finalize and release WASM memory; the hash cannot be updated afterwards
+     * @param {string} [encoding] - 'hex', 'base64', ... or none for a Buffer
+     * @returns {Buffer|string} - 40-byte digest
+     */
+    digest(encoding) {
+        if (!this.ctxPtr) throw new Error('Digest already called');
+        this.engine.final(this.ctxPtr, this.outPtr);
+        const out = Buffer.from(this.engine.heap().subarray(this.outPtr, this.outPtr + HASH_SIZE));
+        this.release();
+        return encoding ? out.toString(encoding) : out;
+    }
+
+    release() {
+        if (this.ctxPtr) this.engine.ctxFree(this.ctxPtr);
+        if (this.bufPtr) this.engine.free(this.bufPtr);
+        if (this.outPtr) this.engine.free(this.outPtr);
+        this.ctxPtr = this.bufPtr = this.outPtr = 0;
+    }
+
+    _transform(chunk, encoding, callback) {
+        try {
+            this.update(chunk);
+            callback();
+        } catch (error) {
+            callback(error);
+        }
+    }
+
+    _flush(callback) {
+        try {
+            this.push(this.digest());
+            callback();
+        } catch (error) {
+            callback(error);
+        }
+    }
+
+    _destroy(error, callback) {
+        this.release();
+        callback(error);
+    }
+}
+
+/* ==================== ENGINE ==================== */
+
+/**
+ * Streaming hash functions bound to one loaded module
+ * @param {Object} engine - Adapter from adapt()
+ */
+function XzalgoChainStream(engine) {
+    this.engine = engine;
+    this.flavor = engine.flavor;
+}
+
+/**
+ * Create a hash stream
+ * @param {Object} [options] - { chunkSize } and Transform options
+ * @returns {XzalgoChainHashStream}
+ */
+XzalgoChainStream.prototype.createHash = function (options) {
+    return new XzalgoChainHashStream(this.engine, options);
+};
+
+/**
+ * Hash an async iterable of chunks (a Readable, an async generator, ...)
+ * Pulls one chunk at a time, so the producer is paused while WASM works
+ * @param {AsyncIterable<Buffer|Uint8Array|string>} source - Message chunks
+ * @param {Object} [options] - { chunkSize }
+ * @returns {Promise<Buffer>} - 40-byte digest
+ */
+XzalgoChainStream.prototype.hash = async function (source, options) {
+    const hash = this.createHash(options);
+    try {
+        for await (const chunk of source) hash.update(chunk);
+        return hash.digest();
+    } finally {
+        hash.release();
+    }
+};
+
+/**
+ * Hash a file without reading it into memory
+ * @param {string} file - Path to the file
+ * @param {Object} [options] - { chunkSize }
+ * @returns {Promise<Buffer>} - 40-byte digest
+ */
+XzalgoChainStream.prototype.hashFile = function (file, options) {
+    const chunkSize = (options && options.chunkSize) || DEFAULT_CHUNK_SIZE;
+    return this.hash(fs.createReadStream(file, { highWaterMark: chunkSize }), options);
+};
+
+/**
+ * Load a build and wrap it
+ * @param {Object} [options]
+ * @param {boolean|string} [options.standalone='auto'] - true forces the WASI build, false the Emscripten builds
+ * @param {string} [options.baseUrl] - Directory of the module files (default: next to this script)
+ * @returns {Promise<XzalgoChainStream>} - flavor is 'wasi', 'simd' or 'baseline'
+ */
+XzalgoChainStream.load = async function (options) {
+    options = options || {};
+    const baseUrl = options.baseUrl || __dirname + path.sep;
+    const standalone = options.standalone === undefined ? 'auto' : options.standalone;
+    const wasiFile = path.join(baseUrl, STANDALONE_WASM);
+
+    if (standalone === true || (standalone === 'auto' && fs.existsSync(wasiFile))) {
+        return new XzalgoChainStream(adapt(await instantiateWasi(wasiFile), 'wasi'));
+    }
+
+    const loader = require('./xzalgochain-loader.js');
+    const module = await loader.load(Object.assign({}, options, { baseUrl: baseUrl, threads: false }));
+    return new XzalgoChainStream(adapt(module));
+};
+
+/**
+ * Wrap a module that is already loaded
+ * @param {Object} module - Emscripten module, or standalone instance exports
+ * @returns {XzalgoChainStream}
+ */
+XzalgoChainStream.fromModule = function (module) {
+    return new XzalgoChainStream(adapt(module));
+};
+
+XzalgoChainStream.HASH_SIZE = HASH_SIZE;
+XzalgoChainStream.XzalgoChainHashStream = XzalgoChainHashStream;
+
+module.exports = XzalgoChainStream;
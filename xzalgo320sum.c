@@ -15,6 +15,12 @@
  * limitations under the License.
  */
 
+/* Linux: expose MAP_POPULATE, MADV_HUGEPAGE, O_DIRECT and syscall() (io_uring)
+ * to the file hashing code alongside the -D_XOPEN_SOURCE=700 set by the Makefile */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE
+#endif
+
 /* Standard C library headers for basic I/O, memory management, and string operations */
 #include <stdio.h>
 #include <stdlib.h>
@@ -23,6 +29,7 @@
 #include <stdarg.h>
 #include <stdint.h>
 #include <string.h>
+#include <sys/stat.h> /* stat() for largest-first scheduling */
 
 /* Platform detection and conditional includes
  * Each platform block defines platform-specific macros and includes necessary headers
@@ -168,14 +175,37 @@ static FILE* fmemopen_win(void* buf, size_t size, const char* mode) {
 #define XZALGOCHAIN_IMPLEMENTATION
 #include "XzalgoChain/XzalgoChain.h"
 
-/* Buffer size for reading files/streams - 16KB for efficient I/O */
+/* Buffer size for reading in-memory streams (-i); files and stdin go through xzalgochain_update_fd() */
 #define BUFFER_SIZE 16384
 
+/* stdout buffer when it is not a terminal: one write() per ~12000 digest lines */
+#define OUTPUT_BUFFER_SIZE (1024 * 1024)
+
+/* Multi-file mode: regular files up to SMALL_FILE_MAX bytes are read whole,
+ * SMALL_FILE_BATCH at a time, and hashed together by xzalgochain_many() */
+#define SMALL_FILE_MAX 16384
+#define SMALL_FILE_BATCH (4 * XZ_MULTI_LANES)
+
+/* Duplicate finder (--dupes): bytes hashed at each end of a file in the first pass */
+#define DUPES_EDGE (64 * 1024)
+
+/* Sampled fingerprints (--sample N): bytes per window */
+#define SAMPLE_WINDOW (64 * 1024)
+
+/* Piece hashes (--chunks): default and smallest --chunk-size */
+#define CHUNKS_DEFAULT_SIZE (4 * 1024 * 1024)
+#define CHUNKS_MIN_SIZE 4096
+
 /* Global verbosity, quiet, and salt mode flags */
 static int verbose_mode = 0; /* Enable detailed output */
 static int quiet_mode = 0;   /* Suppress normal output */
 static int use_salt = 0;     /* Generate HASH with SALT */
 
+/* Read pipeline settings (-Q, -B, -D); queue depth 0 selects mmap/read() */
+static unsigned int aio_depth = XZ_AIO_DEFAULT_DEPTH;
+static size_t aio_buffer = XZ_AIO_DEFAULT_BUFFER;
+static int aio_flags = XZ_AIO_DEFAULT;
+
 /**
  * Get human-readable platform name based on detected macros
  * @return String containing platform name
@@ -216,7 +246,7 @@ static void print_usage(const char* prog) {
 #endif
 
     fprintf(stderr,
-            "Usage: %s [OPTIONS] [FILE]\n"
+            "Usage: %s [OPTIONS] [FILE]...\n"
             "Try '%s -h' for help.\n",
             prog_name, prog_name);
 }
@@ -240,7 +270,7 @@ static void print_help(const char* prog) {
 
     printf("XzalgoChain 320-bit hash utility (Version%.8s)\n\n", xzalgochain_version() + 11);
     printf("Platform: %s\n\n", get_platform_name());
-    printf("Usage: %s [OPTIONS] [FILE]\n\n", prog_name);
+    printf("Usage: %s [OPTIONS] [FILE]...\n\n", prog_name);
 
     /* Operation modes explanation */
     printf("Modes:\n");
@@ -252,6 +282,12 @@ static void print_help(const char* prog) {
     printf("    %s file.txt\n", prog_name);
     printf("    Opens file and streams its contents internally.\n\n");
 
+    printf("  Files:\n");
+    printf("    %s -j 8 *.iso\n", prog_name);
+    printf("    Hashes files in parallel, largest first, and prints \"HASH  FILE\"\n");
+    printf("    lines in command-line order (sha256sum format; - is stdin).\n");
+    printf("    Files that cannot be read are reported and skipped.\n\n");
+
     printf("  String:\n");
     printf("    %s -i \"text\"\n", prog_name);
     printf("    Hashes the exact bytes of the provided string.\n\n");
@@ -261,6 +297,40 @@ static void print_help(const char* prog) {
     printf("    Verifies computed hash against HASH.\n");
     printf("    If no FILE or -i is provided, stdin is used.\n\n");
 
+    printf("  Tree:\n");
+    printf("    %s -r DIR...\n", prog_name);
+    printf("    One digest per directory tree, from the sorted names, modes, sizes\n");
+    printf("    and digests of its entries; --files also prints a line per file.\n\n");
+
+    printf("  Duplicates:\n");
+    printf("    %s --dupes DIR...\n", prog_name);
+    printf("    Prints sets of identical files as \"HASH  FILE\" lines separated by\n");
+    printf("    blank lines. Files are compared by size, then by their first and\n");
+    printf("    last %dK, and only read in full while they still match.\n\n", DUPES_EDGE / 1024);
+
+    printf("  Sample:\n");
+    printf("    %s --sample 64 disk.img\n", prog_name);
+    printf("    Fingerprints the size and 64 evenly spaced %dK windows, read in\n", SAMPLE_WINDOW / 1024);
+    printf("    parallel, as \"sample64:HASH  FILE\". Detects most changes, not all;\n");
+    printf("    never equal to the full digest.\n\n");
+
+    printf("  Chunks:\n");
+    printf("    %s --chunks --chunk-size 1M big.iso > big.chunks\n", prog_name);
+    printf("    %s --chunks -c big.chunks\n", prog_name);
+    printf("    Prints \"HASH  FILE\", then \"chunkSIZE:INDEX:HASH  FILE\" for every\n");
+    printf("    SIZE bytes (default %dM), from one read; the check names failing chunks.\n\n",
+           CHUNKS_DEFAULT_SIZE >> 20);
+
+    printf("  Tee:\n");
+    printf("    curl -s URL | %s --tee=SUMS | tar x\n", prog_name);
+    printf("    Copies stdin to stdout unchanged while hashing it; the \"HASH  -\"\n");
+    printf("    line goes to SUMS, or to stderr with plain --tee.\n\n");
+
+    printf("  Manifest check:\n");
+    printf("    %s -c SUMS [--status]\n", prog_name);
+    printf("    Verifies every \"HASH  FILE\" line of SUMS (- is stdin) in parallel.\n");
+    printf("    Prints only failures, then a summary; --status prints nothing.\n\n");
+
     /* Standard input explanation */
     printf("Using stdin (Standard Input):\n");
     printf("  stdin allows data to be piped or redirected into the program.\n");
@@ -291,8 +361,25 @@ static void print_help(const char* prog) {
     printf("Options:\n");
     printf("  -i STRING         Hash string\n");
     printf("  -c HASH           Check mode\n");
+    printf("  -c FILE           Check the files listed in FILE (sha256sum -c)\n");
+    printf("  --status          Check mode: no output, exit status only\n");
     printf("  -c HASH -s SALT   Check with salt mode\n");
+    printf("  -r                Hash each FILE operand as a directory tree\n");
+    printf("  --files           Tree mode: also print every regular file's line\n");
+    printf("  --manifest-out F  Also write the digests to binary manifest F\n");
+    printf("  --manifest-in F   Check the files listed in binary manifest F (or the FILEs given)\n");
+    printf("  --dupes           Find duplicate files below the DIR operands\n");
+    printf("  --sample N        Fingerprint N sampled windows of each FILE\n");
+    printf("  --chunks          Also print a digest per chunk of each FILE (with -c: check one)\n");
+    printf("  --chunk-size N    Chunk size for --chunks, K/M/G suffix (default: %dM)\n", CHUNKS_DEFAULT_SIZE >> 20);
+    printf("  --tee[=FILE]      Copy stdin to stdout, digest to stderr (or FILE)\n");
+    printf("  --cache FILE      Skip files whose size, times and inode match FILE's entry\n");
+    printf("  --verify-cache N  With --cache: rehash N%% of the skipped files, fail on mismatch\n");
     printf("  -f                Force scalar mode (disable SIMD)\n");
+    printf("  -j N              Hash files on N threads (default: one per core)\n");
+    printf("  -Q DEPTH          Read buffers in flight (default: %d on multi-core, 0: mmap/read)\n", XZ_AIO_DEFAULT_DEPTH);
+    printf("  -B SIZE           Read buffer size, K/M suffix (default: %dK)\n", XZ_AIO_DEFAULT_BUFFER / 1024);
+    printf("  -D                Read files with O_DIRECT (bypass page cache)\n");
     printf("  -u                Use salt (yes/no, default: no)\n");
     printf("  -q                Quiet\n");
     printf("  -v                Version\n");
@@ -308,12 +395,14 @@ static void print_version(void) {
     int simd_type = xzalgochain_get_simd_type();
     const char* simd_name = "None";
     int avx2_detected = 0;
+    int sse2_detected = 0;
     int neon_detected = 0;
     int force_seq = xzalgochain_is_forced_scalar();
 
     /* Detect SIMD support based on architecture */
     if (xzalgochain_is_x86()) {
         avx2_detected = xzalgochain_avx2_supported();
+        sse2_detected = xzalgochain_sse2_supported();
     }
 
     if (xzalgochain_is_arm()) {
@@ -323,6 +412,8 @@ static void print_version(void) {
     /* Get SIMD type name */
     if (simd_type == SIMD_AVX2) {
         simd_name = "AVX2";
+    } else if (simd_type == SIMD_SSE2) {
+        simd_name = "SSE2";
     } else if (simd_type == SIMD_NEON) {
         simd_name = "NEON";
     }
@@ -335,6 +426,7 @@ static void print_version(void) {
 
     if (xzalgochain_is_x86()) {
         printf("AVX2 Support: %s\n", avx2_detected ? "Yes" : "No");
+        printf("SSE2 Support: %s\n", sse2_detected ? "Yes" : "No");
     }
 
     if (xzalgochain_is_arm()) {
@@ -375,101 +467,189 @@ static int parse_hash(const char* s, uint8_t* hash) {
     if (len != XZALGOCHAIN_HASH_SIZE * 2)
         return -1;
 
-    /* Parse each pair of hex digits */
-    for (size_t i = 0; i < XZALGOCHAIN_HASH_SIZE; ++i) {
-        unsigned int b;
-        if (sscanf(s + (i * 2), "%02x", &b) != 1)
-            return -1;
-        hash[i] = (uint8_t) b;
+    return xzalgochain_from_hex(s, XZALGOCHAIN_HASH_SIZE, hash);
+}
+
+/**
+ * Parse a byte count with an optional K, M or G suffix (powers of 1024)
+ * @param s Input string
+ * @param out Parsed size
+ * @return 0 on success, -1 on invalid format
+ */
+static int parse_size(const char* s, size_t* out) {
+    char* end;
+    errno = 0;
+    unsigned long long v = strtoull(s, &end, 10);
+    if (end == s || errno != 0 || s[0] == '-')
+        return -1;
+
+    switch (*end) {
+        case 'k':
+        case 'K':
+            v <<= 10;
+            end++;
+            break;
+        case 'm':
+        case 'M':
+            v <<= 20;
+            end++;
+            break;
+        case 'g':
+        case 'G':
+            v <<= 30;
+            end++;
+            break;
+        default:
+            break;
     }
+    if (*end != '\0' || v > SIZE_MAX)
+        return -1;
 
+    *out = (size_t) v;
     return 0;
 }
 
 /**
- * Read from a stream and compute its hash
+ * Decide whether a descriptor is read through the pipeline
+ * The pipeline costs a reader thread, so it only pays off for streams and
+ * for files longer than one buffer
+ * @param fd Open file descriptor
+ * @return 1 to use xzalgochain_update_fd_aio(), 0 for xzalgochain_update_fd()
+ */
+static int use_pipeline(int fd) {
+    if (aio_depth == 0)
+        return 0;
+#if defined(XZ_AIO_HAVE_THREADS)
+    struct stat st;
+    off_t pos;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && (pos = lseek(fd, 0, SEEK_CUR)) >= 0)
+        return st.st_size - pos > (off_t) aio_buffer;
+    return 1;
+#else
+    (void) fd;
+    return 0;
+#endif
+}
+
+/**
+ * Read from a stream and compute its hash, without printing anything
+ * Safe to call from several threads on different streams
  * @param fp FILE pointer to read from
  * @param desc Description of input source (for verbose output)
  * @param hash Output buffer for computed hash (must be XZALGOCHAIN_HASH_SIZE bytes)
  * @param ctx Pointer to hash context (will be initialized and wiped)
- * @param external_salt Pointer to 32-byte salt if provided externally (for check mode), NULL otherwise
- * @return 0 on success, -1 on error
+ * @param salt Pointer to 32-byte salt (salt || data || length || salt), NULL for none
+ * @return 0 on success, -1 on read error (errno set)
  */
-static int hash_stream(FILE* fp, const char* desc, uint8_t* hash, XzalgoChain_CTX* ctx, const uint8_t* external_salt) {
+static int digest_stream(FILE* fp, const char* desc, uint8_t* hash, XzalgoChain_CTX* ctx, const uint8_t* salt) {
     uint8_t buffer[BUFFER_SIZE];
-    size_t total = 0;
-    uint8_t salt[XZALGOCHAIN_SALT_SIZE];
-    const uint8_t* current_salt = NULL;
+    uint64_t total = 0;
 
     // Initialize the hash context
     xzalgochain_init(ctx);
-
-    // Handle salt based on mode
-    if (external_salt != NULL) {
-        // External salt provided (check mode with -s)
-        current_salt = external_salt;
-        xzalgochain_update(ctx, current_salt, XZALGOCHAIN_SALT_SIZE);
-        if (!quiet_mode) {
-            printf("Using external salt: ");
-            for (int i = 0; i < XZALGOCHAIN_SALT_SIZE; ++i) {
-                printf("%02x", current_salt[i]);
-            }
-            printf("\n");
-        }
-    } else if (use_salt) {
-        // Generate new salt (normal mode with -u yes)
-        if (xz_generate_salt(salt, 0) != 0) {
-            if (!quiet_mode) {
-                fprintf(stderr, "Failed to generate salt\n");
-            }
+    if (salt != NULL)
+        xzalgochain_update(ctx, salt, XZALGOCHAIN_SALT_SIZE);
+
+    // Files and stdin: read pipeline (or mmap/read() with -Q 0) straight from
+    // the descriptor. Nothing has been read through fp yet, so its buffer is empty
+    int fd = fileno(fp);
+    if (fd >= 0) {
+        int rc = use_pipeline(fd) ? xzalgochain_update_fd_aio(ctx, fd, aio_depth, aio_buffer, aio_flags, &total)
+                                  : xzalgochain_update_fd(ctx, fd, XZ_FILE_DEFAULT, &total);
+        if (rc != 0) {
+            int saved_errno = errno;
             xzalgochain_ctx_wipe(ctx);
+            errno = saved_errno;
             return -1;
         }
-        current_salt = salt;
-        xzalgochain_update(ctx, current_salt, XZALGOCHAIN_SALT_SIZE);
-        if (!quiet_mode) {
-            printf("Salt: ");
-            for (int i = 0; i < XZALGOCHAIN_SALT_SIZE; ++i) {
-                printf("%02x", current_salt[i]);
-            }
-            printf("\n");
-        }
+        verbose("Read %llu bytes from %s\n", (unsigned long long) total, desc ? desc : "stdin");
     }
 
-    // Read and process data in chunks
-    while (1) {
+    // In-memory streams (-i) have no descriptor: read and process data in chunks
+    while (fd < 0) {
         size_t r = fread(buffer, 1, BUFFER_SIZE, fp);
         if (r > 0) {
             xzalgochain_update(ctx, buffer, r);
             total += r;
-            verbose("Read %zu bytes from %s\r", total, desc ? desc : "stdin");
+            verbose("Read %llu bytes from %s\r", (unsigned long long) total, desc ? desc : "stdin");
         }
 
         if (r < BUFFER_SIZE) {
             if (ferror(fp)) {
-                if (!quiet_mode) {
-                    fprintf(stderr, "Error reading %s: %s\n", desc ? desc : "stdin", strerror(errno));
-                }
+                int saved_errno = errno;
                 xzalgochain_ctx_wipe(ctx);
+                errno = saved_errno;
                 return -1;
             }
+            verbose("\n");
             break;
         }
     }
 
     // Append total data length in bits (64-bit little-endian) and salt again if salt is active
-    if (current_salt != NULL) {
+    if (salt != NULL) {
         uint64_t total_bits = total * 8;
         uint8_t bits_le[8];
         u64_to_bytes(total_bits, bits_le); // Convert to little-endian bytes
         xzalgochain_update(ctx, bits_le, 8);
-        xzalgochain_update(ctx, current_salt, XZALGOCHAIN_SALT_SIZE);
+        xzalgochain_update(ctx, salt, XZALGOCHAIN_SALT_SIZE);
     }
 
     xzalgochain_final(ctx, hash);
     xzalgochain_ctx_wipe(ctx);
+    return 0;
+}
+
+/**
+ * Print a labelled salt in hexadecimal
+ * @param label Line prefix
+ * @param salt Salt bytes (XZALGOCHAIN_SALT_SIZE)
+ */
+static void print_salt(const char* label, const uint8_t* salt) {
+    char hex[XZALGOCHAIN_SALT_SIZE * 2 + 1];
+    xzalgochain_to_hex(salt, XZALGOCHAIN_SALT_SIZE, hex);
+    hex[XZALGOCHAIN_SALT_SIZE * 2] = '\n';
+
+    fputs(label, stdout);
+    fwrite(hex, 1, sizeof(hex), stdout);
+}
+
+/**
+ * Read from a stream and compute its hash, reporting salt and errors
+ * @param fp FILE pointer to read from
+ * @param desc Description of input source (for verbose output)
+ * @param hash Output buffer for computed hash (must be XZALGOCHAIN_HASH_SIZE bytes)
+ * @param ctx Pointer to hash context (will be initialized and wiped)
+ * @param external_salt Pointer to 32-byte salt if provided externally (for check mode), NULL otherwise
+ * @return 0 on success, -1 on error
+ */
+static int hash_stream(FILE* fp, const char* desc, uint8_t* hash, XzalgoChain_CTX* ctx, const uint8_t* external_salt) {
+    uint8_t salt[XZALGOCHAIN_SALT_SIZE];
+    const uint8_t* current_salt = NULL;
+
+    // Handle salt based on mode
+    if (external_salt != NULL) {
+        // External salt provided (check mode with -s)
+        current_salt = external_salt;
+        if (!quiet_mode) print_salt("Using external salt: ", current_salt);
+    } else if (use_salt) {
+        // Generate new salt (normal mode with -u yes)
+        if (xz_generate_salt(salt, 0) != 0) {
+            if (!quiet_mode) {
+                fprintf(stderr, "Failed to generate salt\n");
+            }
+            return -1;
+        }
+        current_salt = salt;
+        if (!quiet_mode) print_salt("Salt: ", current_salt);
+    }
 
-    if (verbose_mode && !quiet_mode) fprintf(stderr, "\n");
+    if (digest_stream(fp, desc, hash, ctx, current_salt) != 0) {
+        if (!quiet_mode) {
+            fprintf(stderr, "Error reading %s: %s\n", desc ? desc : "stdin", strerror(errno));
+        }
+        return -1;
+    }
     return 0;
 }
 
@@ -490,15 +670,7 @@ static int parse_salt(const char* s, uint8_t* salt) {
     if (len != XZALGOCHAIN_SALT_SIZE * 2)
         return -1;
 
-    /* Parse each pair of hex digits */
-    for (size_t i = 0; i < XZALGOCHAIN_SALT_SIZE; ++i) {
-        unsigned int b;
-        if (sscanf(s + (i * 2), "%02x", &b) != 1)
-            return -1;
-        salt[i] = (uint8_t) b;
-    }
-
-    return 0;
+    return xzalgochain_from_hex(s, XZALGOCHAIN_SALT_SIZE, salt);
 }
 
 /**
@@ -511,6 +683,15 @@ static int parse_salt(const char* s, uint8_t* salt) {
 static FILE* open_input_stream(const char* filename,
                                const char* string_input,
                                const char** label_out) {
+    /* "-" names standard input, as in sha256sum */
+    if (filename && strcmp(filename, "-") == 0) {
+        *label_out = "-";
+#ifdef PLATFORM_WINDOWS
+        _setmode(_fileno(stdin), _O_BINARY);
+#endif
+        return stdin;
+    }
+
     /* String input mode */
     if (string_input) {
         *label_out = string_input;
@@ -568,8 +749,9 @@ static FILE* open_input_stream(const char* filename,
  */
 static void print_hash(const uint8_t* hash, const char* label) {
     /* Print each byte as two hex digits */
-    for (int i = 0; i < XZALGOCHAIN_HASH_SIZE; ++i)
-        printf("%02x", hash[i]);
+    char hex[XZALGOCHAIN_HASH_SIZE * 2];
+    xzalgochain_to_hex(hash, XZALGOCHAIN_HASH_SIZE, hex);
+    fwrite(hex, 1, sizeof(hex), stdout);
 
     /* Format output based on input type */
     if (label) {
@@ -585,129 +767,3200 @@ static void print_hash(const uint8_t* hash, const char* label) {
     }
 }
 
-/* Windows getopt implementation (if not provided by compiler) */
-#ifdef PLATFORM_WINDOWS
-    #ifndef HAVE_GETOPT
-int optind = 1;
-int optopt;
-char* optarg;
+/* One FILE operand in multi-file mode, or one manifest entry in check mode */
+typedef struct {
+    const char* path;                        /* Operand as given ("-" is stdin) */
+    uint64_t size;                           /* Bytes, for largest-first scheduling */
+    uint8_t hash[XZALGOCHAIN_HASH_SIZE];     /* Digest, valid when err == 0 */
+    uint8_t expected[XZALGOCHAIN_HASH_SIZE]; /* Digest listed in the manifest (-c FILE) */
+    uint8_t salt[XZALGOCHAIN_SALT_SIZE];     /* Generated salt (-u yes) */
+    uint64_t dev;                            /* Device and inode, for --cache (0 if not looked up) */
+    uint64_t ino;
+    uint64_t mtime_ns;                       /* Change times, for --cache */
+    uint64_t ctime_ns;
+    int err;                                 /* errno of the failure, 0 on success */
+    int open_failed;                         /* err came from opening the file */
+    int small;                               /* Regular file of at most SMALL_FILE_MAX bytes */
+    int cached;                              /* hash came from --cache */
+    int edges;                               /* --dupes first pass: hash only the first and last DUPES_EDGE bytes */
+    int done;                                /* Result ready to print */
+} file_job_t;
 
 /**
- * Simple getopt implementation for Windows
- * @param argc Argument count
- * @param argv Argument vector
- * @param optstring Option string (e.g., "i:c:qvVhf")
- * @return Option character, or -1 if done, or '?' on error
+ * Get the default worker count (-j)
+ * @return Number of online processors, at least 1
  */
-static int getopt_win(int argc, char* const argv[], const char* optstring) {
-    static char* nextchar = NULL;
+static int default_jobs(void) {
+#if defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int) n : 1;
+#else
+    return 1;
+#endif
+}
 
-    if (optind >= argc)
-        return -1;
+/**
+ * Check whether a file name must be escaped in sha256sum-format output
+ * @param name File name
+ * @return 1 if it contains a backslash or newline
+ */
+static int name_needs_escape(const char* name) {
+    return strchr(name, '\\') != NULL || strchr(name, '\n') != NULL;
+}
 
-    if (nextchar == NULL || *nextchar == '\0') {
-        nextchar = argv[optind];
-        if (nextchar[0] != '-' || nextchar[1] == '\0') {
-            return -1;
+/**
+ * Print a file name, escaping backslashes and newlines if asked to
+ * @param name File name
+ * @param escape Result of name_needs_escape()
+ */
+static void print_file_name(const char* name, int escape) {
+    if (!escape) {
+        fputs(name, stdout);
+        return;
+    }
+    for (const char* c = name; *c; c++) {
+        if (escape && *c == '\\') {
+            fputs("\\\\", stdout);
+        } else if (escape && *c == '\n') {
+            fputs("\\n", stdout);
+        } else {
+            putchar(*c);
         }
-        nextchar++;
     }
+}
 
-    char opt = *nextchar++;
-    const char* pos = strchr(optstring, opt);
+/**
+ * Print a file digest line in sha256sum format: HASH, two spaces, name
+ * Names containing a backslash or newline are escaped and the line is
+ * prefixed with a backslash, as coreutils does
+ * @param hash Hash bytes to print
+ * @param name File name as given on the command line
+ */
+static void print_file_hash(const uint8_t* hash, const char* name) {
+    int escape = name_needs_escape(name);
+    char line[1 + XZALGOCHAIN_HASH_SIZE * 2 + 2];
+    size_t n = 0;
+
+    if (escape) line[n++] = '\\';
+    xzalgochain_to_hex(hash, XZALGOCHAIN_HASH_SIZE, line + n);
+    n += XZALGOCHAIN_HASH_SIZE * 2;
+    line[n++] = ' ';
+    line[n++] = ' ';
+
+    fwrite(line, 1, n, stdout);
+    print_file_name(name, escape);
+    putchar('\n');
+}
 
-    if (pos == NULL || opt == ':') {
-        optopt = opt;
-        return '?';
+#if defined(XZ_FILE_HAVE_MMAP)
+/**
+ * Hash the first and last DUPES_EDGE bytes of a file (--dupes first pass)
+ * The digest only tells files of the same size apart: equal edges still
+ * need a full read. Files of at most 2 * DUPES_EDGE bytes are never
+ * hashed this way.
+ * @param job File to hash; hash and err are filled in
+ */
+static void hash_file_edges(file_job_t* job) {
+    uint8_t* buf = (uint8_t*) malloc(2 * DUPES_EDGE);
+    int fd = open(job->path, O_RDONLY | O_CLOEXEC);
+    if (!buf || fd < 0) {
+        job->err = buf ? errno : ENOMEM;
+        job->open_failed = fd < 0;
+        if (fd >= 0) close(fd);
+        free(buf);
+        return;
     }
 
-    if (pos[1] == ':') {
-        if (*nextchar != '\0') {
-            optarg = nextchar;
-            nextchar = NULL;
-        } else if (optind + 1 < argc) {
-            optarg = argv[++optind];
-            nextchar = NULL;
-        } else {
-            optopt = opt;
-            return ':';
+    /* A file that shrank since stat() gets a short read and a digest of its own */
+    size_t got = 0;
+    for (int end = 0; end < 2 && !job->err; end++) {
+        off_t pos = end ? (off_t) (job->size - DUPES_EDGE) : 0;
+        size_t want = got + DUPES_EDGE;
+        while (got < want) {
+            ssize_t r = pread(fd, buf + got, want - got, pos);
+            if (r < 0 && errno == EINTR)
+                continue;
+            if (r < 0)
+                job->err = errno;
+            if (r <= 0)
+                break;
+            got += (size_t) r;
+            pos += r;
         }
     }
+    close(fd);
 
-    return opt;
+    if (!job->err) {
+        verbose("Read %zu bytes from the ends of %s\n", got, job->path);
+        xzalgochain(buf, got, job->hash);
+    }
+    free(buf);
 }
-
-        #define getopt getopt_win
-    #endif
 #endif
 
 /**
- * Main program entry point
- * @param argc Argument count
- * @param argv Argument vector
- * @return 0 on success, non-zero on error
+ * Hash one FILE operand; runs on a worker thread, prints nothing
+ * @param job File to hash; hash, salt and err are filled in
  */
-int main(int argc, char** argv) {
-    int opt;
-    const char* check_str = NULL;    /* Hash to check against */
-    const char* check_salt = NULL;   /* Salt for hash check */
-    const char* string_input = NULL; /* String input mode */
-    const char* filename = NULL;     /* File input mode */
+static void hash_file_job(file_job_t* job) {
+    const char* label = NULL;
     XzalgoChain_CTX ctx;
-    uint8_t hash[XZALGOCHAIN_HASH_SIZE];
-    uint8_t expected[XZALGOCHAIN_HASH_SIZE];
-    int has_expected = 0;
 
-#ifdef PLATFORM_WINDOWS
-    /* Set stdout to binary mode on Windows to avoid output corruption */
-    _setmode(_fileno(stdout), _O_BINARY);
+#if defined(XZ_FILE_HAVE_MMAP)
+    if (job->edges) {
+        hash_file_edges(job);
+        return;
+    }
 #endif
 
-    /* Parse command-line options */
-    while ((opt = getopt(argc, argv, "i:c:s:qvVhfu:")) != -1) {
-        switch (opt) {
-            case 'i':
-                string_input = optarg;
-                break;
-            case 'c':
-                check_str = optarg;
-                break;
-            case 's':
-                check_salt = optarg;
-                break;
-            case 'u':
-                if (strcmp(optarg, "yes") == 0) {
-                    use_salt = 1;
-                } else if (strcmp(optarg, "no") == 0) {
-                    use_salt = 0;
-                } else {
-                    fprintf(stderr, "Invalid value for -u: %s\n", optarg);
-                    return 1;
-                }
-                break;
-            case 'q':
-                quiet_mode = 1;
-                break;
-            case 'v':
-                print_version();
-                return 0;
-            case 'V':
-                verbose_mode = 1;
-                break;
-            case 'h':
-                print_help(argv[0]);
-                return 0;
-            case 'f':
-                xzalgochain_force_scalar(1);
-                if (verbose_mode) fprintf(stderr, "Force scalar mode enabled\n");
-                break;
-            case '?':
-            default:
-                print_usage(argv[0]);
-                return 1;
+    FILE* fp = open_input_stream(job->path, NULL, &label);
+    if (!fp) {
+        job->err = errno ? errno : EIO;
+        job->open_failed = 1;
+        return;
+    }
+
+    if (use_salt && xz_generate_salt(job->salt, 0) != 0) {
+        job->err = EIO;
+    } else if (digest_stream(fp, job->path, job->hash, &ctx, use_salt ? job->salt : NULL) != 0) {
+        job->err = errno ? errno : EIO;
+    }
+
+    if (fp != stdin)
+        fclose(fp);
+}
+
+/**
+ * Read a whole small file into a slab slot
+ * @param path File path
+ * @param buf Slot of SMALL_FILE_MAX + 1 bytes
+ * @param len Receives the number of bytes read
+ * @param open_failed Set to 1 if the file could not be opened
+ * @return 0 on success, 1 if the file no longer fits the slot, -1 on error (errno set)
+ */
+static int read_small_file(const char* path, uint8_t* buf, size_t* len, int* open_failed) {
+#if defined(XZ_FILE_HAVE_MMAP)
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        *open_failed = 1;
+        return -1;
+    }
+
+    /* One byte of headroom tells a file that grew since stat() from one that did not */
+    size_t got = 0;
+    while (got <= SMALL_FILE_MAX) {
+        ssize_t r = read(fd, buf + got, SMALL_FILE_MAX + 1 - got);
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r < 0) {
+            int saved_errno = errno;
+            close(fd);
+            errno = saved_errno;
+            return -1;
+        }
+        if (r == 0)
+            break;
+        got += (size_t) r;
+    }
+    close(fd);
+
+    *len = got;
+    return got > SMALL_FILE_MAX;
+#else
+    (void) path;
+    (void) buf;
+    (void) len;
+    (void) open_failed;
+    return 1;
+#endif
+}
+
+/**
+ * Hash a batch of FILE operands; runs on a worker thread, prints nothing
+ * Small files are read into the slab and hashed side by side with
+ * xzalgochain_many(), which absorbs them in lockstep and shares one
+ * context setup; anything else (or every file, without a slab) goes through
+ * hash_file_job() on the streaming path
+ * @param jobs Files to hash
+ * @param count Number of files
+ * @param slab SMALL_FILE_BATCH slots of SMALL_FILE_MAX + 1 bytes, or NULL
+ */
+static void hash_small_files(file_job_t** jobs, size_t count, uint8_t* slab) {
+    const uint8_t* data[SMALL_FILE_BATCH];
+    size_t lens[SMALL_FILE_BATCH];
+    file_job_t* batch[SMALL_FILE_BATCH];
+    uint8_t digests[SMALL_FILE_BATCH][XZALGOCHAIN_HASH_SIZE];
+    size_t n = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        file_job_t* job = jobs[i];
+        uint8_t* slot = slab ? slab + n * (SMALL_FILE_MAX + 1) : NULL;
+        int rc = slot && job->small && !use_salt ? read_small_file(job->path, slot, &lens[n], &job->open_failed) : 1;
+
+        if (rc < 0) {
+            job->err = errno ? errno : EIO;
+        } else if (rc > 0) {
+            hash_file_job(job);
+        } else {
+            verbose("Read %llu bytes from %s\n", (unsigned long long) lens[n], job->path);
+            data[n] = slot;
+            batch[n++] = job;
         }
     }
 
+    if (n == 0)
+        return;
+    xzalgochain_many(data, lens, n, digests);
+    for (size_t i = 0; i < n; i++)
+        memcpy(batch[i]->hash, digests[i], XZALGOCHAIN_HASH_SIZE);
+}
+
+/**
+ * Report one finished FILE operand
+ * @param job Finished job
+ */
+static void print_file_job(const file_job_t* job) {
+    if (quiet_mode)
+        return;
+
+    if (job->err) {
+        fflush(stdout); /* Keep errors next to the lines they follow */
+        fprintf(stderr, "%s %s: %s\n", job->open_failed ? "Cannot open" : "Error reading", job->path, strerror(job->err));
+        return;
+    }
+
+    if (use_salt) print_salt("Salt: ", job->salt);
+    print_file_hash(job->hash, job->path);
+}
+
+/* Digest cache (--cache): an open-addressing table of cache_slot_t in a
+ * memory-mapped file, keyed by (device, inode) and valid while size, mtime
+ * and ctime are unchanged. Only the main thread reads or writes it: lookups
+ * happen where files are stat()ed, before any worker starts, and new
+ * digests are stored after the workers are done. */
+#define CACHE_MAGIC "XZCACHE1"
+#define CACHE_BYTE_ORDER 0x01020304u
+#define CACHE_MIN_SLOTS 4096
+
+/* Files changed less than CACHE_SETTLE_NS before the run started are not
+ * stored: a write in the same timestamp tick could go unnoticed */
+#define CACHE_SETTLE_NS (2ULL * 1000000000ULL)
+
+/* Cache file header, followed by capacity slots */
+typedef struct {
+    char magic[8];       /* CACHE_MAGIC */
+    uint32_t byte_order; /* CACHE_BYTE_ORDER as written by this machine */
+    uint32_t slot_size;  /* sizeof(cache_slot_t) */
+    uint32_t dirty;      /* Set while open; a crashed run leaves it set */
+    uint32_t reserved0;
+    uint64_t capacity; /* Slots, a power of two */
+    uint64_t count;    /* Slots in use */
+    uint8_t reserved[24];
+} cache_header_t;
+
+/* One cached digest; dev and ino both zero marks an empty slot */
+typedef struct {
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    uint64_t mtime_ns;
+    uint64_t ctime_ns;
+    uint8_t hash[XZALGOCHAIN_HASH_SIZE];
+} cache_slot_t;
+
+/* The open cache; header is NULL without --cache */
+static struct {
+    int fd;
+    cache_header_t* header;
+    cache_slot_t* slots;
+    uint64_t start_ns;        /* Wall clock when the cache was opened */
+    unsigned int verify_rate; /* --verify-cache: percent of hits rehashed */
+    uint64_t rng;             /* Picks the hits to rehash */
+    size_t hits;
+    size_t verified;
+    size_t mismatches;
+} cache;
+
+/* stat() times in nanoseconds */
+#define CACHE_NS(ts) ((uint64_t) (ts).tv_sec * 1000000000ULL + (uint64_t) (ts).tv_nsec)
+#if defined(__APPLE__)
+    #define CACHE_MTIME_NS(st) CACHE_NS((st)->st_mtimespec)
+    #define CACHE_CTIME_NS(st) CACHE_NS((st)->st_ctimespec)
+#elif defined(XZ_FILE_HAVE_MMAP)
+    #define CACHE_MTIME_NS(st) CACHE_NS((st)->st_mtim)
+    #define CACHE_CTIME_NS(st) CACHE_NS((st)->st_ctim)
+#else
+    #define CACHE_MTIME_NS(st) ((uint64_t) (st)->st_mtime * 1000000000ULL)
+    #define CACHE_CTIME_NS(st) ((uint64_t) (st)->st_ctime * 1000000000ULL)
+#endif
+
+/**
+ * Find the slot of a file, or the empty slot where it belongs
+ * The table is kept at most half full, so probes stay short and always end
+ * @param dev Device number
+ * @param ino Inode number
+ * @return Slot
+ */
+static cache_slot_t* cache_slot(uint64_t dev, uint64_t ino) {
+    uint64_t mask = cache.header->capacity - 1;
+    uint64_t i = ((ino * 0x9E3779B97F4A7C15ULL) ^ (dev * 0xC2B2AE3D27D4EB4FULL)) >> 17;
+
+    for (;; i++) {
+        cache_slot_t* slot = &cache.slots[i & mask];
+        if ((slot->dev == dev && slot->ino == ino) || (slot->dev == 0 && slot->ino == 0))
+            return slot;
+    }
+}
+
+#if defined(XZ_FILE_HAVE_MMAP)
+/**
+ * Map the cache file at its current size
+ * @param size File size: header plus capacity slots
+ * @return 0 on success, -1 on error (errno set)
+ */
+static int cache_map(size_t size) {
+    void* map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, cache.fd, 0);
+    if (map == MAP_FAILED)
+        return -1;
+    cache.header = (cache_header_t*) map;
+    cache.slots = (cache_slot_t*) (cache.header + 1);
+    return 0;
+}
+
+/**
+ * Resize the cache file to a new capacity and map it, emptied
+ * @param capacity Slots, a power of two
+ * @return 0 on success, -1 on error (errno set, cache unmapped)
+ */
+static int cache_reset(uint64_t capacity) {
+    size_t size = sizeof(cache_header_t) + (size_t) capacity * sizeof(cache_slot_t);
+    if (cache.header) {
+        munmap(cache.header, sizeof(cache_header_t) + (size_t) cache.header->capacity * sizeof(cache_slot_t));
+        cache.header = NULL;
+    }
+    if (ftruncate(cache.fd, 0) != 0 || ftruncate(cache.fd, (off_t) size) != 0 || cache_map(size) != 0)
+        return -1;
+
+    memcpy(cache.header->magic, CACHE_MAGIC, sizeof(cache.header->magic));
+    cache.header->byte_order = CACHE_BYTE_ORDER;
+    cache.header->slot_size = sizeof(cache_slot_t);
+    cache.header->dirty = 1;
+    cache.header->capacity = capacity;
+    return 0;
+}
+
+/**
+ * Double the capacity of the cache, rehashing every entry
+ * @return 0 on success, -1 on error (errno set, cache unmapped)
+ */
+static int cache_grow(void) {
+    uint64_t capacity = cache.header->capacity;
+    cache_slot_t* old = (cache_slot_t*) malloc((size_t) capacity * sizeof(cache_slot_t));
+    if (!old) {
+        errno = ENOMEM;
+        return -1;
+    }
+    memcpy(old, cache.slots, (size_t) capacity * sizeof(cache_slot_t));
+
+    if (cache_reset(capacity * 2) != 0) {
+        int saved_errno = errno;
+        free(old);
+        errno = saved_errno;
+        return -1;
+    }
+    for (uint64_t i = 0; i < capacity; i++) {
+        if (old[i].dev == 0 && old[i].ino == 0)
+            continue;
+        *cache_slot(old[i].dev, old[i].ino) = old[i];
+        cache.header->count++;
+    }
+    free(old);
+    return 0;
+}
+#endif
+
+/**
+ * Open (or create) the digest cache and lock it for this run
+ * A file with another layout, or one left dirty by a run that did not
+ * finish, is emptied rather than trusted
+ * @param path Cache file
+ * @param verify_rate Percent of hits to rehash (--verify-cache)
+ * @return 0 on success, -1 on error (reported)
+ */
+static int cache_open(const char* path, unsigned int verify_rate) {
+#if defined(XZ_FILE_HAVE_MMAP)
+    struct stat st;
+    struct flock lock;
+    struct timespec now;
+    uint8_t seed[XZALGOCHAIN_SALT_SIZE];
+
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+
+    cache.fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (cache.fd < 0) {
+        fprintf(stderr, "Cannot open cache %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    /* One run at a time; a second one waits here */
+    int rc = 0;
+    while ((rc = fcntl(cache.fd, F_SETLKW, &lock)) != 0 && errno == EINTR)
+        ;
+    if (rc == 0)
+        rc = fstat(cache.fd, &st);
+
+    if (rc == 0 && (size_t) st.st_size >= sizeof(cache_header_t)) {
+        rc = cache_map((size_t) st.st_size);
+        const cache_header_t* h = cache.header;
+        if (rc == 0 && (memcmp(h->magic, CACHE_MAGIC, sizeof(h->magic)) != 0 || h->byte_order != CACHE_BYTE_ORDER ||
+                        h->slot_size != sizeof(cache_slot_t) || h->dirty || h->capacity < CACHE_MIN_SLOTS ||
+                        (h->capacity & (h->capacity - 1)) != 0 || h->count * 2 > h->capacity ||
+                        (uint64_t) st.st_size != sizeof(cache_header_t) + h->capacity * sizeof(cache_slot_t))) {
+            verbose("Cache %s is damaged or from another build; starting over\n", path);
+            munmap(cache.header, (size_t) st.st_size);
+            cache.header = NULL;
+        }
+    }
+    if (rc == 0 && !cache.header)
+        rc = cache_reset(CACHE_MIN_SLOTS);
+    if (rc != 0) {
+        fprintf(stderr, "Cannot open cache %s: %s\n", path, strerror(errno));
+        close(cache.fd);
+        cache.header = NULL;
+        return -1;
+    }
+
+    cache.header->dirty = 1;
+    clock_gettime(CLOCK_REALTIME, &now);
+    cache.start_ns = CACHE_NS(now);
+    cache.verify_rate = verify_rate;
+    if (xz_generate_salt(seed, 0) != 0)
+        memcpy(seed, &cache.start_ns, sizeof(cache.start_ns));
+    memcpy(&cache.rng, seed, sizeof(cache.rng));
+    cache.rng |= 1;
+    verbose("Cache %s: %llu entries\n", path, (unsigned long long) cache.header->count);
+    return 0;
+#else
+    (void) verify_rate;
+    fprintf(stderr, "Cannot open cache %s: not supported on this platform\n", path);
+    return -1;
+#endif
+}
+
+/**
+ * Flush and unlock the digest cache
+ * @return 1 if a rehashed file did not match its cached digest, 0 otherwise
+ */
+static int cache_close(void) {
+    if (!cache.header)
+        return 0;
+#if defined(XZ_FILE_HAVE_MMAP)
+    size_t size = sizeof(cache_header_t) + (size_t) cache.header->capacity * sizeof(cache_slot_t);
+    msync(cache.header, size, MS_SYNC);
+    cache.header->dirty = 0;
+    msync(cache.header, sizeof(cache_header_t), MS_SYNC);
+    munmap(cache.header, size);
+    close(cache.fd);
+#endif
+    cache.header = NULL;
+
+    verbose("Cache: %zu hits, %zu rehashed to verify, %zu mismatches\n", cache.hits, cache.verified, cache.mismatches);
+    return cache.mismatches > 0;
+}
+
+/**
+ * Record the identity of a regular file and look it up in the cache
+ * A hit fills in the digest and marks the job cached, unless
+ * --verify-cache picks it to be rehashed
+ * @param job File job
+ * @param st stat() of the file
+ */
+static void cache_lookup(file_job_t* job, const struct stat* st) {
+    job->dev = (uint64_t) st->st_dev;
+    job->ino = (uint64_t) st->st_ino;
+    job->mtime_ns = CACHE_MTIME_NS(st);
+    job->ctime_ns = CACHE_CTIME_NS(st);
+    if (job->dev == 0 && job->ino == 0)
+        return;
+
+    const cache_slot_t* slot = cache_slot(job->dev, job->ino);
+    if (slot->ino != job->ino || slot->dev != job->dev || slot->size != job->size || slot->mtime_ns != job->mtime_ns ||
+        slot->ctime_ns != job->ctime_ns)
+        return;
+
+    cache.hits++;
+    if (cache.verify_rate) {
+        cache.rng ^= cache.rng << 13;
+        cache.rng ^= cache.rng >> 7;
+        cache.rng ^= cache.rng << 17;
+        if (cache.rng % 100 < cache.verify_rate) {
+            cache.verified++;
+            return;
+        }
+    }
+    memcpy(job->hash, slot->hash, XZALGOCHAIN_HASH_SIZE);
+    job->cached = 1;
+}
+
+/**
+ * Store the digest of a hashed file, after checking it against a cached
+ * entry for the same unchanged file (a --verify-cache pick)
+ * @param job Finished job; ignored if it failed, came from the cache or
+ *            is not a regular file
+ */
+static void cache_store(const file_job_t* job) {
+    if (!cache.header || job->cached || job->err || (job->dev == 0 && job->ino == 0))
+        return;
+
+    cache_slot_t* slot = cache_slot(job->dev, job->ino);
+    int found = slot->dev == job->dev && slot->ino == job->ino;
+    if (found && slot->size == job->size && slot->mtime_ns == job->mtime_ns && slot->ctime_ns == job->ctime_ns &&
+        !xzalgochain_equals(slot->hash, job->hash)) {
+        cache.mismatches++;
+        if (!quiet_mode) {
+            fflush(stdout);
+            fprintf(stderr, "%s: contents changed but size and times did not (cached digest differs)\n", job->path);
+        }
+    }
+
+    /* Too recent to trust: leave any older entry to miss on its times */
+    if ((job->mtime_ns > job->ctime_ns ? job->mtime_ns : job->ctime_ns) + CACHE_SETTLE_NS > cache.start_ns)
+        return;
+
+#if defined(XZ_FILE_HAVE_MMAP)
+    if (!found && (cache.header->count + 1) * 2 > cache.header->capacity) {
+        /* On failure the cache stops taking entries; if it was unmapped, it is
+         * left dirty and emptied by the next run */
+        if (cache_grow() != 0) {
+            if (!quiet_mode) fprintf(stderr, "Cannot grow cache: %s\n", strerror(errno));
+            return;
+        }
+        slot = cache_slot(job->dev, job->ino);
+    }
+#endif
+    if (!found)
+        cache.header->count++;
+
+    slot->dev = job->dev;
+    slot->ino = job->ino;
+    slot->size = job->size;
+    slot->mtime_ns = job->mtime_ns;
+    slot->ctime_ns = job->ctime_ns;
+    memcpy(slot->hash, job->hash, XZALGOCHAIN_HASH_SIZE);
+}
+
+/* Worker pool state shared by run_file_pool() threads */
+typedef struct {
+    file_job_t* files;  /* Command-line order */
+    file_job_t** order; /* Largest first, without the files found in --cache */
+    size_t count;       /* Entries of files[] */
+    size_t pending;     /* Entries of order[] */
+    size_t small_start; /* First entry of order[] that fits SMALL_FILE_MAX */
+    size_t next_print;  /* First result not printed yet (under lock) */
+    void (*report)(const file_job_t* job); /* Prints one result, in files[] order */
+#if defined(XZ_AIO_HAVE_THREADS)
+    atomic_size_t next; /* Next entry of order[] to start */
+    pthread_mutex_t lock;
+#else
+    size_t next;
+#endif
+} file_pool_t;
+
+/**
+ * Worker loop: take the next file in largest-first order, hash it, then
+ * report every result whose predecessors in files[] are all done
+ * Once the large files are handed out, the small ones are taken
+ * SMALL_FILE_BATCH at a time and hashed together
+ * @param arg file_pool_t shared by all workers
+ * @return NULL
+ */
+static void* file_pool_worker(void* arg) {
+    file_pool_t* pool = (file_pool_t*) arg;
+    uint8_t* slab = NULL;
+
+    for (;;) {
+#if defined(XZ_AIO_HAVE_THREADS)
+        size_t step = atomic_load(&pool->next) >= pool->small_start ? SMALL_FILE_BATCH : 1;
+        size_t k = atomic_fetch_add(&pool->next, step);
+#else
+        size_t step = pool->next >= pool->small_start ? SMALL_FILE_BATCH : 1;
+        size_t k = pool->next;
+        pool->next += step;
+#endif
+        if (k >= pool->pending) {
+            free(slab);
+            return NULL;
+        }
+
+        size_t end = pool->pending - k < step ? pool->pending : k + step;
+        if (step > 1) {
+            if (!slab)
+                slab = (uint8_t*) malloc((size_t) SMALL_FILE_BATCH * (SMALL_FILE_MAX + 1));
+            hash_small_files(pool->order + k, end - k, slab);
+        } else {
+            hash_file_job(pool->order[k]);
+        }
+
+#if defined(XZ_AIO_HAVE_THREADS)
+        pthread_mutex_lock(&pool->lock);
+#endif
+        for (size_t j = k; j < end; j++)
+            pool->order[j]->done = 1;
+        while (pool->next_print < pool->count && pool->files[pool->next_print].done)
+            pool->report(&pool->files[pool->next_print++]);
+#if defined(XZ_AIO_HAVE_THREADS)
+        pthread_mutex_unlock(&pool->lock);
+#endif
+    }
+}
+
+/* qsort comparator: larger files first, command-line order among equals */
+static int compare_jobs_largest_first(const void* a, const void* b) {
+    const file_job_t* x = *(const file_job_t* const*) a;
+    const file_job_t* y = *(const file_job_t* const*) b;
+    if (x->size != y->size)
+        return x->size < y->size ? 1 : -1;
+    return x < y ? -1 : (x > y);
+}
+
+/**
+ * Hash a list of files on a pool of worker threads
+ * Files are started largest first, so that one huge file does not finish
+ * last on a single worker; the small files left at the end are read whole
+ * and hashed in batches (see hash_small_files()). Each result is reported
+ * in files[] order as soon as all earlier files are done. With --cache,
+ * unchanged files are not read at all, and new digests are stored at the end.
+ * @param files Files to hash, path set and everything else zero
+ * @param count Number of files
+ * @param jobs Worker threads (-j)
+ * @param report Called once per file, in order, under the pool lock
+ * @return 0 on success, -1 if out of memory (nothing hashed)
+ */
+static int run_file_pool(file_job_t* files, size_t count, int jobs, void (*report)(const file_job_t* job)) {
+    file_job_t** order = (file_job_t**) malloc((count ? count : 1) * sizeof(file_job_t*));
+    if (!order)
+        return -1;
+
+    /* Sizes for scheduling; stdin goes first since its size is unknown.
+     * Files with a valid --cache entry are done already */
+    size_t pending = 0;
+    for (size_t i = 0; i < count; i++) {
+        struct stat st;
+        if (strcmp(files[i].path, "-") == 0)
+            files[i].size = UINT64_MAX;
+        else if (stat(files[i].path, &st) == 0) {
+            files[i].size = (uint64_t) st.st_size;
+            files[i].small = S_ISREG(st.st_mode) && st.st_size <= SMALL_FILE_MAX;
+            if (cache.header && S_ISREG(st.st_mode))
+                cache_lookup(&files[i], &st);
+        }
+        if (files[i].cached)
+            files[i].done = 1;
+        else
+            order[pending++] = &files[i];
+    }
+    qsort(order, pending, sizeof(file_job_t*), compare_jobs_largest_first);
+
+    /* Everything from here on is at most SMALL_FILE_MAX bytes (or unreadable) */
+    size_t small_start = pending;
+    while (small_start > 0 && order[small_start - 1]->size <= SMALL_FILE_MAX)
+        small_start--;
+
+    if (jobs < 1) jobs = 1;
+    if ((size_t) jobs > pending) jobs = pending > 0 ? (int) pending : 1;
+    verbose("Hashing %zu files on %d workers\n", pending, jobs);
+
+    /* The hash kernels use orphaned OpenMP worksharing, which must not bind
+     * to a team of ours; the pool is plain threads, the main thread included */
+    file_pool_t pool;
+    memset(&pool, 0, sizeof(pool));
+    pool.files = files;
+    pool.order = order;
+    pool.count = count;
+    pool.pending = pending;
+    pool.small_start = small_start;
+    pool.report = report;
+#if defined(XZ_AIO_HAVE_THREADS)
+    atomic_init(&pool.next, 0);
+    pthread_mutex_init(&pool.lock, NULL);
+
+    pthread_t* threads = (pthread_t*) malloc((size_t) jobs * sizeof(pthread_t));
+    int started = 0;
+    while (threads && started < jobs - 1 && pthread_create(&threads[started], NULL, file_pool_worker, &pool) == 0)
+        started++;
+    file_pool_worker(&pool);
+    for (int t = 0; t < started; t++)
+        pthread_join(threads[t], NULL);
+
+    free(threads);
+    pthread_mutex_destroy(&pool.lock);
+#else
+    file_pool_worker(&pool);
+#endif
+
+    /* Cached files after the last hashed one (or all of them) */
+    while (pool.next_print < count)
+        report(&files[pool.next_print++]);
+    for (size_t i = 0; i < count; i++)
+        cache_store(&files[i]);
+
+    free(order);
+    return 0;
+}
+
+/* Binary manifest being collected (--manifest-out): digests, and the paths
+ * packed one after another in names */
+static struct {
+    const char* path; /* Output file, NULL without --manifest-out */
+    uint8_t (*digests)[XZALGOCHAIN_HASH_SIZE];
+    size_t* offsets; /* Start of each path in names */
+    char* names;
+    size_t count;
+    size_t cap;
+    size_t names_len;
+    size_t names_cap;
+    int failed; /* Out of memory; nothing is written */
+} manifest_out;
+
+/**
+ * Add a hashed file to the binary manifest (--manifest-out)
+ * @param path File path
+ * @param hash Its digest
+ */
+static void manifest_add(const char* path, const uint8_t* hash) {
+    size_t len = strlen(path) + 1;
+    if (!manifest_out.path || manifest_out.failed)
+        return;
+
+    if (manifest_out.count == manifest_out.cap) {
+        size_t cap = manifest_out.cap ? manifest_out.cap * 2 : 1024;
+        void* digests = realloc(manifest_out.digests, cap * XZALGOCHAIN_HASH_SIZE);
+        if (digests)
+            manifest_out.digests = (uint8_t (*)[XZALGOCHAIN_HASH_SIZE]) digests;
+        void* offsets = digests ? realloc(manifest_out.offsets, cap * sizeof(size_t)) : NULL;
+        if (!offsets) {
+            manifest_out.failed = 1;
+            return;
+        }
+        manifest_out.offsets = (size_t*) offsets;
+        manifest_out.cap = cap;
+    }
+    while (manifest_out.names_len + len > manifest_out.names_cap) {
+        size_t cap = manifest_out.names_cap ? manifest_out.names_cap * 2 : 64 * 1024;
+        char* names = (char*) realloc(manifest_out.names, cap);
+        if (!names) {
+            manifest_out.failed = 1;
+            return;
+        }
+        manifest_out.names = names;
+        manifest_out.names_cap = cap;
+    }
+
+    memcpy(manifest_out.digests[manifest_out.count], hash, XZALGOCHAIN_HASH_SIZE);
+    manifest_out.offsets[manifest_out.count++] = manifest_out.names_len;
+    memcpy(manifest_out.names + manifest_out.names_len, path, len);
+    manifest_out.names_len += len;
+}
+
+/**
+ * Write the collected binary manifest (--manifest-out) and free it
+ * @return 0 on success or without --manifest-out, 1 on error (reported)
+ */
+static int manifest_finish(void) {
+    int rc = 0;
+    if (!manifest_out.path)
+        return 0;
+
+    const char** paths = manifest_out.failed ? NULL : (const char**) malloc((manifest_out.count ? manifest_out.count : 1) * sizeof(char*));
+    if (!paths) {
+        if (!quiet_mode) fprintf(stderr, "Cannot write %s: %s\n", manifest_out.path, strerror(ENOMEM));
+        rc = 1;
+    } else {
+        for (size_t i = 0; i < manifest_out.count; i++)
+            paths[i] = manifest_out.names + manifest_out.offsets[i];
+        if (xzalgochain_manifest_write(manifest_out.path, (const uint8_t (*)[XZALGOCHAIN_HASH_SIZE]) manifest_out.digests, paths,
+                                       manifest_out.count) != 0) {
+            if (!quiet_mode) fprintf(stderr, "Cannot write %s: %s\n", manifest_out.path, strerror(errno));
+            rc = 1;
+        } else {
+            verbose("Wrote %zu entries to %s\n", manifest_out.count, manifest_out.path);
+        }
+    }
+
+    free(paths);
+    free(manifest_out.digests);
+    free(manifest_out.offsets);
+    free(manifest_out.names);
+    memset(&manifest_out, 0, sizeof(manifest_out));
+    return rc;
+}
+
+/**
+ * Hash every FILE operand on the worker pool and print "HASH  FILE" lines
+ * in command-line order. A file that cannot be opened or read is reported
+ * on stderr and the others continue.
+ * @param paths FILE operands
+ * @param count Number of operands
+ * @param jobs Worker threads (-j)
+ * @return 0 if every file was hashed, 1 otherwise
+ */
+static int hash_files(char** paths, size_t count, int jobs) {
+    file_job_t* files = (file_job_t*) calloc(count, sizeof(file_job_t));
+    if (files)
+        for (size_t i = 0; i < count; i++) files[i].path = paths[i];
+
+    if (!files || run_file_pool(files, count, jobs, print_file_job) != 0) {
+        if (!quiet_mode) fprintf(stderr, "Out of memory\n");
+        free(files);
+        return 1;
+    }
+
+    int failed = 0;
+    for (size_t i = 0; i < count; i++) {
+        failed |= files[i].err != 0;
+        if (!files[i].err)
+            manifest_add(files[i].path, files[i].hash);
+    }
+
+    free(files);
+    return failed;
+}
+
+/* Manifest check (-c FILE): entries are verified CHECK_BATCH at a time,
+ * from a read buffer that starts at CHECK_BUFFER bytes and grows for long lines */
+#define CHECK_BATCH 65536
+#define CHECK_BUFFER (4 * 1024 * 1024)
+
+/**
+ * Parse one manifest line in place
+ * Accepts the lines this utility prints: "HASH  name" (or "HASH *name"),
+ * with a leading backslash when backslashes and newlines in the name are
+ * escaped
+ * @param line Line without its newline, NUL-terminated; modified in place
+ * @param len Line length
+ * @param job Receives path (pointing into line) and expected digest
+ * @return 0 on success, -1 if the line is improperly formatted
+ */
+static int parse_manifest_line(char* line, size_t len, file_job_t* job) {
+    const size_t hex_len = XZALGOCHAIN_HASH_SIZE * 2;
+    int escaped = len > 0 && line[0] == '\\';
+
+    if (escaped) {
+        line++;
+        len--;
+    }
+    if (len < hex_len + 3 || line[hex_len] != ' ' || (line[hex_len + 1] != ' ' && line[hex_len + 1] != '*'))
+        return -1;
+    if (xzalgochain_from_hex(line, XZALGOCHAIN_HASH_SIZE, job->expected) != 0)
+        return -1;
+
+    char* name = line + hex_len + 2;
+    if (escaped) {
+        char* w = name;
+        for (const char* r = name; *r; r++) {
+            if (*r != '\\') {
+                *w++ = *r;
+            } else if (r[1] == '\\') {
+                *w++ = '\\';
+                r++;
+            } else if (r[1] == 'n') {
+                *w++ = '\n';
+                r++;
+            } else {
+                return -1;
+            }
+        }
+        *w = '\0';
+    }
+
+    job->path = name;
+    return 0;
+}
+
+/**
+ * Report one manifest entry; matching files print nothing
+ * @param job Finished entry
+ */
+static void print_check_job(const file_job_t* job) {
+    if (quiet_mode)
+        return;
+
+    if (job->err) {
+        fflush(stdout); /* Keep errors next to the lines they follow */
+        fprintf(stderr, "%s %s: %s\n", job->open_failed ? "Cannot open" : "Error reading", job->path, strerror(job->err));
+    } else if (xzalgochain_equals(job->expected, job->hash)) {
+        return;
+    }
+
+    int escape = name_needs_escape(job->path);
+    if (escape) putchar('\\');
+    print_file_name(job->path, escape);
+    fputs(job->err ? ": FAILED open or read\n" : ": FAILED\n", stdout);
+}
+
+/* Outcome counts of a manifest check */
+typedef struct {
+    size_t ok;
+    size_t failed;
+    size_t unreadable;
+    size_t malformed; /* Lines or records that name no file */
+} check_totals_t;
+
+/**
+ * Verify a batch of manifest entries on the worker pool and count the results
+ * @param batch Entries with path and expected digest set
+ * @param n Number of entries
+ * @param jobs Worker threads (-j)
+ * @param totals Updated with the outcome of each entry
+ * @return 0 on success, -1 if out of memory (reported)
+ */
+static int check_batch(file_job_t* batch, size_t n, int jobs, check_totals_t* totals) {
+    if (run_file_pool(batch, n, jobs, print_check_job) != 0) {
+        if (!quiet_mode) fprintf(stderr, "Out of memory\n");
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (batch[i].err)
+            totals->unreadable++;
+        else if (xzalgochain_equals(batch[i].expected, batch[i].hash))
+            totals->ok++;
+        else
+            totals->failed++;
+    }
+    return 0;
+}
+
+/**
+ * Print the summary line of a manifest check
+ * @param label Manifest name
+ * @param totals Outcome counts
+ * @return Exit status: 0 if every listed file matched, 1 otherwise
+ */
+static int check_summary(const char* label, const check_totals_t* totals) {
+    size_t checked = totals->ok + totals->failed + totals->unreadable;
+    if (checked == 0) {
+        if (!quiet_mode) fprintf(stderr, "%s: no properly formatted checksum lines found\n", label);
+        return 1;
+    }
+
+    if (!quiet_mode) {
+        printf("%s: %zu checked, %zu OK, %zu FAILED, %zu unreadable", label, checked, totals->ok, totals->failed,
+               totals->unreadable);
+        if (totals->malformed)
+            printf(", %zu improperly formatted lines", totals->malformed);
+        putchar('\n');
+    }
+    return totals->failed || totals->unreadable;
+}
+
+/**
+ * Verify every "HASH  FILE" line of a manifest on the worker pool
+ * The manifest is read in large blocks and parsed in place, so ten-million
+ * line manifests are not held in memory at once. Only failures are printed,
+ * in manifest order, followed by a summary line.
+ * @param manifest Manifest path ("-" is stdin)
+ * @param jobs Worker threads (-j)
+ * @return 0 if every listed file matched, 1 otherwise
+ */
+static int check_manifest(const char* manifest, int jobs) {
+    const char* label = NULL;
+    check_totals_t totals = {0, 0, 0, 0};
+    size_t cap = CHECK_BUFFER, len = 0;
+    int eof = 0, rc = 0;
+
+    FILE* fp = open_input_stream(manifest, NULL, &label);
+    if (!fp) {
+        if (!quiet_mode) fprintf(stderr, "Cannot open %s: %s\n", manifest, strerror(errno));
+        return 1;
+    }
+
+    char* buf = (char*) malloc(cap);
+    file_job_t* batch = (file_job_t*) malloc(CHECK_BATCH * sizeof(file_job_t));
+    if (!buf || !batch) {
+        if (!quiet_mode) fprintf(stderr, "Out of memory\n");
+        rc = 1;
+        eof = 1;
+    }
+
+    while (!rc && (!eof || len > 0)) {
+        /* Top up the buffer, keeping one byte for the NUL after an unterminated last line */
+        if (!eof) {
+            len += fread(buf + len, 1, cap - 1 - len, fp);
+            if (ferror(fp)) {
+                if (!quiet_mode) fprintf(stderr, "Error reading %s: %s\n", label, strerror(errno));
+                rc = 1;
+                break;
+            }
+            eof = len < cap - 1;
+        }
+
+        /* Parse complete lines (and the last one at end of file) into a batch */
+        size_t pos = 0, n = 0;
+        while (pos < len && n < CHECK_BATCH) {
+            char* line = buf + pos;
+            char* nl = (char*) memchr(line, '\n', len - pos);
+            if (!nl && !eof)
+                break;
+
+            size_t line_len = nl ? (size_t) (nl - line) : len - pos;
+            line[line_len] = '\0';
+            pos += line_len + (nl != NULL);
+            if (line_len == 0)
+                continue;
+
+            memset(&batch[n], 0, sizeof(batch[n]));
+            if (parse_manifest_line(line, line_len, &batch[n]) == 0)
+                n++;
+            else
+                totals.malformed++;
+        }
+
+        if (n > 0 && check_batch(batch, n, jobs, &totals) != 0) {
+            rc = 1;
+            break;
+        }
+
+        /* Keep the partial line; grow the buffer if it already fills it */
+        memmove(buf, buf + pos, len - pos);
+        len -= pos;
+        if (len == cap - 1) {
+            char* grown = (char*) realloc(buf, cap * 2);
+            if (!grown) {
+                if (!quiet_mode) fprintf(stderr, "Out of memory\n");
+                rc = 1;
+                break;
+            }
+            buf = grown;
+            cap *= 2;
+        }
+    }
+
+    if (fp != stdin)
+        fclose(fp);
+    free(batch);
+    free(buf);
+    if (rc)
+        return 1;
+    return check_summary(label, &totals);
+}
+
+/**
+ * Verify the files of a binary manifest (--manifest-in) on the worker pool
+ * The manifest is mapped and used in place: entries point at its digests and
+ * paths, so nothing is parsed. Without operands every entry is checked, in
+ * digest-table order; with them, each operand is looked up by path.
+ * @param manifest Binary manifest path
+ * @param operands FILE operands to check, or NULL for all entries
+ * @param count Number of operands
+ * @param jobs Worker threads (-j)
+ * @return 0 if every checked file matched, 1 otherwise
+ */
+static int check_binary_manifest(const char* manifest, char** operands, size_t count, int jobs) {
+    XzalgoChain_Manifest m;
+    check_totals_t totals = {0, 0, 0, 0};
+    int rc = 0;
+
+    if (xzalgochain_manifest_open(manifest, &m) != 0) {
+        if (!quiet_mode)
+            fprintf(stderr, "Cannot open %s: %s\n", manifest, errno == EINVAL ? "not an xzalgo320sum binary manifest" : strerror(errno));
+        return 1;
+    }
+    size_t total = operands ? count : (size_t) m.count;
+    verbose("Manifest %s: %llu entries\n", manifest, (unsigned long long) m.count);
+
+    file_job_t* batch = (file_job_t*) malloc(CHECK_BATCH * sizeof(file_job_t));
+    if (!batch) {
+        if (!quiet_mode) fprintf(stderr, "Out of memory\n");
+        rc = 1;
+    }
+
+    for (size_t pos = 0; !rc && pos < total;) {
+        size_t n = 0;
+        for (; pos < total && n < CHECK_BATCH; pos++) {
+            const XzalgoChain_ManifestRecord* record = operands ? xzalgochain_manifest_find_path(&m, operands[pos]) : &m.records[pos];
+            const char* path = record ? xzalgochain_manifest_path(&m, record) : NULL;
+            if (!path) {
+                if (operands && !quiet_mode) fprintf(stderr, "%s: not listed in %s\n", operands[pos], manifest);
+                if (operands)
+                    totals.failed++;
+                else
+                    totals.malformed++;
+                continue;
+            }
+
+            memset(&batch[n], 0, sizeof(batch[n]));
+            batch[n].path = path;
+            memcpy(batch[n].expected, record->digest, XZALGOCHAIN_HASH_SIZE);
+            n++;
+        }
+        if (n > 0 && check_batch(batch, n, jobs, &totals) != 0)
+            rc = 1;
+    }
+
+    free(batch);
+    xzalgochain_manifest_close(&m);
+    if (rc)
+        return 1;
+    return check_summary(manifest, &totals);
+}
+
+/* Tree digest (-r): a directory's digest hashes TREE_TAG followed by one
+ * record per entry, in byte order of the names: mode, size and name length
+ * (64-bit little-endian), the name, then the entry's 40-byte digest.
+ * Modes are normalized as in git, so umask and ownership do not matter;
+ * a directory's size is its number of entries and a symbolic link's digest
+ * is that of its target. Other file types are left out. */
+#define TREE_TAG "xzalgochain-tree-1"
+#define TREE_MODE_DIR 040000
+#define TREE_MODE_FILE 0100644
+#define TREE_MODE_EXEC 0100755
+#define TREE_MODE_LINK 0120000
+
+#if defined(XZ_FILE_HAVE_MMAP)
+    #include <dirent.h>
+    #define TREE_HAVE_WALK 1
+#endif
+
+/* One entry of a tree (-r) */
+typedef struct tree_node {
+    const char* name;            /* Entry name, the tail of job.path */
+    uint32_t mode;               /* TREE_MODE_* */
+    file_job_t job;              /* Full path, size, digest and error */
+    struct tree_node** children; /* Directory entries, sorted by name */
+    size_t child_count;
+} tree_node_t;
+
+/* Regular files found by the walk, waiting for a worker */
+typedef struct {
+    file_job_t** items;
+    size_t count;
+    size_t cap;
+    size_t next; /* First entry not taken yet */
+    int walking; /* The walk may still add entries */
+#if defined(XZ_AIO_HAVE_THREADS)
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+#endif
+} tree_queue_t;
+
+/**
+ * Queue the regular files of a directory that has just been read
+ * @param queue Work queue
+ * @param dir Directory with its children sorted
+ * @return 0 on success, -1 if out of memory
+ */
+static int tree_queue_push(tree_queue_t* queue, const tree_node_t* dir) {
+    int rc = 0;
+#if defined(XZ_AIO_HAVE_THREADS)
+    pthread_mutex_lock(&queue->lock);
+#endif
+    for (size_t i = 0; i < dir->child_count && rc == 0; i++) {
+        tree_node_t* node = dir->children[i];
+        if ((node->mode != TREE_MODE_FILE && node->mode != TREE_MODE_EXEC) || node->job.err || node->job.cached)
+            continue;
+
+        if (queue->count == queue->cap) {
+            size_t cap = queue->cap ? queue->cap * 2 : 1024;
+            file_job_t** grown = (file_job_t**) realloc(queue->items, cap * sizeof(file_job_t*));
+            if (!grown) {
+                rc = -1;
+                break;
+            }
+            queue->items = grown;
+            queue->cap = cap;
+        }
+        queue->items[queue->count++] = &node->job;
+    }
+#if defined(XZ_AIO_HAVE_THREADS)
+    pthread_cond_broadcast(&queue->ready);
+    pthread_mutex_unlock(&queue->lock);
+#endif
+    return rc;
+}
+
+/**
+ * Take the next file, or a run of up to SMALL_FILE_BATCH small ones
+ * Waits while the queue is empty and the walk is still going
+ * @param queue Work queue
+ * @param batch Receives the files taken
+ * @return Number of files taken, 0 once the queue is drained
+ */
+static size_t tree_queue_take(tree_queue_t* queue, file_job_t** batch) {
+    size_t n = 0;
+#if defined(XZ_AIO_HAVE_THREADS)
+    pthread_mutex_lock(&queue->lock);
+    while (queue->next == queue->count && queue->walking)
+        pthread_cond_wait(&queue->ready, &queue->lock);
+#endif
+    if (queue->next < queue->count) {
+        batch[n++] = queue->items[queue->next++];
+        while (batch[0]->small && n < SMALL_FILE_BATCH && queue->next < queue->count && queue->items[queue->next]->small)
+            batch[n++] = queue->items[queue->next++];
+    }
+#if defined(XZ_AIO_HAVE_THREADS)
+    pthread_mutex_unlock(&queue->lock);
+#endif
+    return n;
+}
+
+/**
+ * Worker loop: hash queued files until the walk is over and the queue empty
+ * @param arg tree_queue_t shared with the walk
+ * @return NULL
+ */
+static void* tree_worker(void* arg) {
+    tree_queue_t* queue = (tree_queue_t*) arg;
+    file_job_t* batch[SMALL_FILE_BATCH];
+    uint8_t* slab = NULL;
+    size_t n;
+
+    while ((n = tree_queue_take(queue, batch)) > 0) {
+        if (n > 1 && !slab)
+            slab = (uint8_t*) malloc((size_t) SMALL_FILE_BATCH * (SMALL_FILE_MAX + 1));
+        hash_small_files(batch, n, slab);
+    }
+    free(slab);
+    return NULL;
+}
+
+/* qsort comparator: tree entries in byte order of their names */
+static int compare_tree_nodes(const void* a, const void* b) {
+    return strcmp((*(const tree_node_t* const*) a)->name, (*(const tree_node_t* const*) b)->name);
+}
+
+/**
+ * Free a tree node and everything below it
+ * @param node Node
+ * @param is_root The root borrows its path from argv
+ */
+static void tree_free(tree_node_t* node, int is_root) {
+    for (size_t i = 0; i < node->child_count; i++)
+        tree_free(node->children[i], 0);
+    free(node->children);
+    if (!is_root)
+        free((char*) node->job.path);
+    free(node);
+}
+
+#if defined(TREE_HAVE_WALK)
+/**
+ * Fill in one directory entry from lstat() information
+ * Symbolic links are read and hashed here; regular files are looked up in
+ * --cache and otherwise left to the workers
+ * @param node Entry with name and path set
+ * @param dir_fd Descriptor of the directory holding it
+ * @return 1 to keep the entry, 0 to leave it out
+ */
+static int tree_stat_node(tree_node_t* node, int dir_fd) {
+    struct stat st;
+    if (fstatat(dir_fd, node->name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+        node->job.err = errno;
+        node->job.open_failed = 1;
+        return 1;
+    }
+
+    if (S_ISDIR(st.st_mode)) {
+        node->mode = TREE_MODE_DIR;
+    } else if (S_ISREG(st.st_mode)) {
+        node->mode = (st.st_mode & S_IXUSR) ? TREE_MODE_EXEC : TREE_MODE_FILE;
+        node->job.size = (uint64_t) st.st_size;
+        node->job.small = st.st_size <= SMALL_FILE_MAX;
+        if (cache.header)
+            cache_lookup(&node->job, &st);
+    } else if (S_ISLNK(st.st_mode)) {
+        /* Targets can be longer than st_size claims (e.g. on procfs); a short read means it fit */
+        size_t cap = (size_t) st.st_size + 1;
+        char* target = NULL;
+        ssize_t len;
+        for (;;) {
+            char* grown = (char*) realloc(target, cap);
+            if (!grown) {
+                len = -1;
+                errno = ENOMEM;
+                break;
+            }
+            target = grown;
+            len = readlinkat(dir_fd, node->name, target, cap);
+            if (len < 0 || (size_t) len < cap)
+                break;
+            cap *= 2;
+        }
+        node->mode = TREE_MODE_LINK;
+        if (len < 0) {
+            node->job.err = errno;
+            node->job.open_failed = 1;
+        } else {
+            node->job.size = (uint64_t) len;
+            xzalgochain((const uint8_t*) target, (size_t) len, node->job.hash);
+        }
+        free(target);
+    } else {
+        verbose("Leaving out %s (not a file, directory or symbolic link)\n", node->job.path);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Read a directory, queue its regular files, then walk its subdirectories
+ * The directory is closed before descending, so deep trees do not run out
+ * of descriptors. Entries that cannot be read are marked and reported when
+ * the digests are computed.
+ * @param dir Directory node with its path set
+ * @param queue Work queue
+ * @return 0 on success, -1 if out of memory
+ */
+static int tree_walk(tree_node_t* dir, tree_queue_t* queue) {
+    DIR* d = opendir(dir->job.path);
+    if (!d) {
+        dir->job.err = errno;
+        dir->job.open_failed = 1;
+        return 0;
+    }
+
+    size_t cap = 0, dir_len = strlen(dir->job.path);
+    int separator = dir_len > 0 && dir->job.path[dir_len - 1] != '/';
+    struct dirent* e;
+    for (;;) {
+        errno = 0;
+        if ((e = readdir(d)) == NULL)
+            break;
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0)
+            continue;
+
+        if (dir->child_count == cap) {
+            tree_node_t** grown = (tree_node_t**) realloc(dir->children, (cap ? cap * 2 : 16) * sizeof(tree_node_t*));
+            if (!grown) {
+                closedir(d);
+                return -1;
+            }
+            dir->children = grown;
+            cap = cap ? cap * 2 : 16;
+        }
+
+        size_t name_len = strlen(e->d_name);
+        tree_node_t* node = (tree_node_t*) calloc(1, sizeof(tree_node_t));
+        char* path = (char*) malloc(dir_len + separator + name_len + 1);
+        if (!node || !path) {
+            free(node);
+            free(path);
+            closedir(d);
+            return -1;
+        }
+
+        memcpy(path, dir->job.path, dir_len);
+        path[dir_len] = '/';
+        memcpy(path + dir_len + separator, e->d_name, name_len + 1);
+        node->name = path + dir_len + separator;
+        node->job.path = path;
+
+        if (tree_stat_node(node, dirfd(d))) {
+            dir->children[dir->child_count++] = node;
+        } else {
+            free(path);
+            free(node);
+        }
+    }
+    if (errno) {
+        dir->job.err = errno;
+        dir->job.open_failed = 0;
+    }
+    closedir(d);
+
+    if (dir->child_count > 1)
+        qsort(dir->children, dir->child_count, sizeof(tree_node_t*), compare_tree_nodes);
+    if (tree_queue_push(queue, dir) != 0)
+        return -1;
+
+    for (size_t i = 0; i < dir->child_count; i++) {
+        tree_node_t* node = dir->children[i];
+        if (node->mode == TREE_MODE_DIR && !node->job.err && tree_walk(node, queue) != 0)
+            return -1;
+    }
+    return 0;
+}
+#endif
+
+/**
+ * Compute the digest of a walked directory from those of its entries
+ * Errors are reported, and file lines printed with --files, in tree order
+ * @param dir Directory node
+ * @param list_files Print a "HASH  FILE" line for every regular file
+ * @return 0 on success, 1 if any entry below dir could not be read
+ */
+static int tree_digest(tree_node_t* dir, int list_files) {
+    XzalgoChain_CTX ctx;
+    uint8_t field[8];
+    int failed = 0;
+
+    xzalgochain_init(&ctx);
+    xzalgochain_update(&ctx, (const uint8_t*) TREE_TAG, sizeof(TREE_TAG) - 1);
+
+    for (size_t i = 0; i < dir->child_count; i++) {
+        tree_node_t* node = dir->children[i];
+        if (node->mode == TREE_MODE_DIR && !node->job.err)
+            failed |= tree_digest(node, list_files);
+        if ((node->mode == TREE_MODE_FILE || node->mode == TREE_MODE_EXEC) && !node->job.err) {
+            cache_store(&node->job);
+            manifest_add(node->job.path, node->job.hash);
+        }
+
+        if (node->job.err || (list_files && node->mode != TREE_MODE_DIR && node->mode != TREE_MODE_LINK))
+            print_file_job(&node->job);
+        if (node->job.err) {
+            failed = 1;
+            continue;
+        }
+
+        size_t name_len = strlen(node->name);
+        u64_to_bytes(node->mode, field);
+        xzalgochain_update(&ctx, field, sizeof(field));
+        u64_to_bytes(node->job.size, field);
+        xzalgochain_update(&ctx, field, sizeof(field));
+        u64_to_bytes(name_len, field);
+        xzalgochain_update(&ctx, field, sizeof(field));
+        xzalgochain_update(&ctx, (const uint8_t*) node->name, name_len);
+        xzalgochain_update(&ctx, node->job.hash, XZALGOCHAIN_HASH_SIZE);
+    }
+
+    xzalgochain_final(&ctx, dir->job.hash);
+    xzalgochain_ctx_wipe(&ctx);
+    dir->job.size = dir->child_count;
+    return failed;
+}
+
+/**
+ * Hash a directory tree (-r) and print "HASH  DIR"
+ * The walk runs on the calling thread and hands regular files to the
+ * workers as each directory is read, so directory and metadata latency
+ * (network filesystems) overlaps with hashing. Digests are combined once
+ * every file is done.
+ * @param path Directory operand
+ * @param jobs Worker threads (-j)
+ * @param list_files Also print a line for every regular file (--files)
+ * @return 0 if every entry was read, 1 otherwise
+ */
+static int hash_tree(const char* path, int jobs, int list_files) {
+#if defined(TREE_HAVE_WALK)
+    struct stat st;
+    int err = stat(path, &st) != 0 ? errno : S_ISDIR(st.st_mode) ? 0 : ENOTDIR;
+    if (err) {
+        if (!quiet_mode) fprintf(stderr, "Cannot open %s: %s\n", path, strerror(err));
+        return 1;
+    }
+
+    tree_node_t* root = (tree_node_t*) calloc(1, sizeof(tree_node_t));
+    tree_queue_t queue;
+    memset(&queue, 0, sizeof(queue));
+    if (!root) {
+        if (!quiet_mode) fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    root->name = path;
+    root->mode = TREE_MODE_DIR;
+    root->job.path = path;
+    queue.walking = 1;
+
+    if (jobs < 1) jobs = 1;
+    verbose("Hashing %s on %d workers\n", path, jobs);
+
+    /* Plain threads, as in run_file_pool(): the kernels' OpenMP worksharing must not bind to them */
+    #if defined(XZ_AIO_HAVE_THREADS)
+    pthread_mutex_init(&queue.lock, NULL);
+    pthread_cond_init(&queue.ready, NULL);
+    pthread_t* threads = (pthread_t*) malloc((size_t) jobs * sizeof(pthread_t));
+    int started = 0;
+    while (threads && started < jobs && pthread_create(&threads[started], NULL, tree_worker, &queue) == 0)
+        started++;
+    #endif
+
+    int rc = tree_walk(root, &queue);
+
+    #if defined(XZ_AIO_HAVE_THREADS)
+    pthread_mutex_lock(&queue.lock);
+    queue.walking = 0;
+    pthread_cond_broadcast(&queue.ready);
+    pthread_mutex_unlock(&queue.lock);
+    if (started == 0)
+        tree_worker(&queue);
+    for (int t = 0; t < started; t++)
+        pthread_join(threads[t], NULL);
+    free(threads);
+    pthread_cond_destroy(&queue.ready);
+    pthread_mutex_destroy(&queue.lock);
+    #else
+    queue.walking = 0;
+    tree_worker(&queue);
+    #endif
+    free(queue.items);
+
+    if (rc != 0) {
+        if (!quiet_mode) fprintf(stderr, "Out of memory\n");
+        tree_free(root, 1);
+        return 1;
+    }
+
+    int failed = tree_digest(root, list_files);
+    if (root->job.err) {
+        print_file_job(&root->job);
+        failed = 1;
+    }
+    if (!failed && !quiet_mode)
+        print_file_hash(root->job.hash, path);
+
+    tree_free(root, 1);
+    return failed;
+#else
+    (void) jobs;
+    (void) list_files;
+    if (!quiet_mode) fprintf(stderr, "Cannot hash %s: -r is not supported on this platform\n", path);
+    return 1;
+#endif
+}
+
+/* Duplicate finder (--dupes): regular files below the operands are grouped
+ * by size, files that share a size are hashed over their first and last
+ * DUPES_EDGE bytes, and only those whose edges still collide are read in
+ * full. Files of at most 2 * DUPES_EDGE bytes are hashed whole in the first
+ * pass. Both passes run on the worker pool. Empty files and anything but
+ * regular files are left out. Like fdupes, a file is listed under one
+ * path only: further hard links to it, and paths reached again through
+ * overlapping operands, share its device and inode and are dropped. */
+
+/* Regular files found by the walk: sizes, and paths packed in names */
+static struct {
+    uint64_t* sizes;
+    size_t* offsets; /* Start of each path in names */
+    dev_t* devs;     /* Device and inode: one entry per file */
+    ino_t* inos;
+    size_t count;
+    size_t cap;
+    char* names;
+    size_t names_len;
+    size_t names_cap;
+    int failed; /* Something could not be read */
+} dupes;
+
+#if defined(TREE_HAVE_WALK)
+/**
+ * Record a regular file for --dupes
+ * @param path File path
+ * @param st Its stat data (size, device and inode)
+ * @return 0 on success, -1 if out of memory
+ */
+static int dupes_add(const char* path, const struct stat* st) {
+    size_t len = strlen(path) + 1;
+
+    if (dupes.count == dupes.cap) {
+        size_t cap = dupes.cap ? dupes.cap * 2 : 1024;
+        uint64_t* sizes = (uint64_t*) realloc(dupes.sizes, cap * sizeof(uint64_t));
+        if (!sizes)
+            return -1;
+        dupes.sizes = sizes;
+        size_t* offsets = (size_t*) realloc(dupes.offsets, cap * sizeof(size_t));
+        if (!offsets)
+            return -1;
+        dupes.offsets = offsets;
+        dev_t* devs = (dev_t*) realloc(dupes.devs, cap * sizeof(dev_t));
+        if (!devs)
+            return -1;
+        dupes.devs = devs;
+        ino_t* inos = (ino_t*) realloc(dupes.inos, cap * sizeof(ino_t));
+        if (!inos)
+            return -1;
+        dupes.inos = inos;
+        dupes.cap = cap;
+    }
+    while (dupes.names_len + len > dupes.names_cap) {
+        size_t cap = dupes.names_cap ? dupes.names_cap * 2 : 64 * 1024;
+        char* names = (char*) realloc(dupes.names, cap);
+        if (!names)
+            return -1;
+        dupes.names = names;
+        dupes.names_cap = cap;
+    }
+
+    dupes.sizes[dupes.count] = (uint64_t) st->st_size;
+    dupes.devs[dupes.count] = st->st_dev;
+    dupes.inos[dupes.count] = st->st_ino;
+    dupes.offsets[dupes.count++] = dupes.names_len;
+    memcpy(dupes.names + dupes.names_len, path, len);
+    dupes.names_len += len;
+    return 0;
+}
+
+/**
+ * Record the regular files below a directory for --dupes
+ * Like tree_walk(), the directory is closed before descending. Entries
+ * that cannot be read are reported and the walk goes on.
+ * @param path Directory path
+ * @return 0 on success, -1 if out of memory
+ */
+static int dupes_walk(const char* path) {
+    DIR* d = opendir(path);
+    if (!d) {
+        if (!quiet_mode) fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+        dupes.failed = 1;
+        return 0;
+    }
+
+    size_t dir_len = strlen(path);
+    int separator = dir_len > 0 && path[dir_len - 1] != '/';
+    char** subdirs = NULL;
+    size_t subdir_count = 0, subdir_cap = 0;
+    int rc = 0;
+    struct dirent* e;
+    for (;;) {
+        errno = 0;
+        if ((e = readdir(d)) == NULL)
+            break;
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0)
+            continue;
+
+        size_t name_len = strlen(e->d_name);
+        char* child = (char*) malloc(dir_len + separator + name_len + 1);
+        if (!child) {
+            rc = -1;
+            break;
+        }
+        memcpy(child, path, dir_len);
+        child[dir_len] = '/';
+        memcpy(child + dir_len + separator, e->d_name, name_len + 1);
+
+        struct stat st;
+        if (fstatat(dirfd(d), e->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            if (!quiet_mode) fprintf(stderr, "Cannot open %s: %s\n", child, strerror(errno));
+            dupes.failed = 1;
+        } else if (S_ISREG(st.st_mode) && st.st_size > 0) {
+            rc = dupes_add(child, &st);
+        } else if (S_ISDIR(st.st_mode)) {
+            if (subdir_count == subdir_cap) {
+                size_t cap = subdir_cap ? subdir_cap * 2 : 16;
+                char** grown = (char**) realloc(subdirs, cap * sizeof(char*));
+                if (!grown) {
+                    free(child);
+                    rc = -1;
+                    break;
+                }
+                subdirs = grown;
+                subdir_cap = cap;
+            }
+            subdirs[subdir_count++] = child;
+            continue;
+        }
+        free(child);
+        if (rc != 0)
+            break;
+    }
+    if (rc == 0 && errno) {
+        if (!quiet_mode) fprintf(stderr, "Error reading %s: %s\n", path, strerror(errno));
+        dupes.failed = 1;
+    }
+    closedir(d);
+
+    for (size_t i = 0; i < subdir_count; i++) {
+        if (rc == 0)
+            rc = dupes_walk(subdirs[i]);
+        free(subdirs[i]);
+    }
+    free(subdirs);
+    return rc;
+}
+
+/* qsort comparator for --dupes entry indices: by device, inode, then
+ * shortest path (so that "dir/x" beats "dir/./x"), then byte order */
+static int compare_dupes_inode(const void* a, const void* b) {
+    size_t x = *(const size_t*) a, y = *(const size_t*) b;
+    if (dupes.devs[x] != dupes.devs[y])
+        return dupes.devs[x] < dupes.devs[y] ? -1 : 1;
+    if (dupes.inos[x] != dupes.inos[y])
+        return dupes.inos[x] < dupes.inos[y] ? -1 : 1;
+    const char* px = dupes.names + dupes.offsets[x];
+    const char* py = dupes.names + dupes.offsets[y];
+    size_t lx = strlen(px), ly = strlen(py);
+    if (lx != ly)
+        return lx < ly ? -1 : 1;
+    return strcmp(px, py);
+}
+
+/**
+ * Keep one entry per file: of the entries that share a device and inode,
+ * only the one that sorts first by compare_dupes_inode() stays
+ * @return Number of entries dropped, or -1 if out of memory
+ */
+static long dupes_drop_links(void) {
+    size_t* order = (size_t*) malloc((dupes.count ? dupes.count : 1) * sizeof(size_t));
+    unsigned char* drop = (unsigned char*) calloc(dupes.count ? dupes.count : 1, 1);
+    if (!order || !drop) {
+        free(order);
+        free(drop);
+        return -1;
+    }
+
+    for (size_t i = 0; i < dupes.count; i++)
+        order[i] = i;
+    qsort(order, dupes.count, sizeof(size_t), compare_dupes_inode);
+    for (size_t i = 1; i < dupes.count; i++)
+        if (dupes.devs[order[i]] == dupes.devs[order[i - 1]] && dupes.inos[order[i]] == dupes.inos[order[i - 1]])
+            drop[order[i]] = 1;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < dupes.count; i++) {
+        if (drop[i])
+            continue;
+        dupes.sizes[kept] = dupes.sizes[i];
+        dupes.offsets[kept] = dupes.offsets[i];
+        dupes.devs[kept] = dupes.devs[i];
+        dupes.inos[kept++] = dupes.inos[i];
+    }
+    long dropped = (long) (dupes.count - kept);
+    dupes.count = kept;
+    free(order);
+    free(drop);
+    return dropped;
+}
+
+/* qsort comparator for sizes */
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*) a, y = *(const uint64_t*) b;
+    return (x > y) - (x < y);
+}
+
+/* qsort comparator: larger files first, then by digest and path */
+static int compare_dupes(const void* a, const void* b) {
+    const file_job_t* x = *(const file_job_t* const*) a;
+    const file_job_t* y = *(const file_job_t* const*) b;
+    if (x->size != y->size)
+        return x->size < y->size ? 1 : -1;
+    int c = memcmp(x->hash, y->hash, XZALGOCHAIN_HASH_SIZE);
+    return c ? c : strcmp(x->path, y->path);
+}
+
+/* Number of entries from list[i] on with the size and digest of list[i] */
+static size_t dupes_run(file_job_t** list, size_t count, size_t i) {
+    size_t j = i + 1;
+    while (j < count && list[j]->size == list[i]->size && memcmp(list[j]->hash, list[i]->hash, XZALGOCHAIN_HASH_SIZE) == 0)
+        j++;
+    return j - i;
+}
+
+/* Worker pool report for the --dupes passes: results are grouped afterwards */
+static void dupes_pass_report(const file_job_t* job) {
+    (void) job;
+}
+#endif
+
+/**
+ * Find duplicate regular files below the operands (--dupes)
+ * Prints each set of identical files as "HASH  FILE" lines, largest files
+ * first, with a blank line between sets.
+ * @param operands Directories (or files) to search
+ * @param count Number of operands
+ * @param jobs Worker threads (-j)
+ * @return 0 on success, 1 if anything could not be read
+ */
+static int find_dupes(char** operands, size_t count, int jobs) {
+#if defined(TREE_HAVE_WALK)
+    file_job_t* files = NULL;
+    file_job_t* full = NULL;
+    file_job_t** list = NULL;
+    size_t candidates = 0, full_count = 0, listed = 0;
+    int oom = 0;
+
+    for (size_t i = 0; i < count && !oom; i++) {
+        struct stat st;
+        if (stat(operands[i], &st) != 0) {
+            if (!quiet_mode) fprintf(stderr, "Cannot open %s: %s\n", operands[i], strerror(errno));
+            dupes.failed = 1;
+        } else if (S_ISDIR(st.st_mode)) {
+            oom = dupes_walk(operands[i]) != 0;
+        } else if (S_ISREG(st.st_mode) && st.st_size > 0) {
+            oom = dupes_add(operands[i], &st) != 0;
+        }
+    }
+
+    /* Hard links and paths found twice are one file */
+    long links = oom ? 0 : dupes_drop_links();
+    if (links < 0)
+        oom = 1;
+    else if (links > 0)
+        verbose("Skipped %ld further paths to files already found\n", links);
+
+    /* Files with a size of their own cannot have a duplicate */
+    uint64_t* sorted = oom ? NULL : (uint64_t*) malloc((dupes.count ? dupes.count : 1) * sizeof(uint64_t));
+    if (sorted) {
+        memcpy(sorted, dupes.sizes, dupes.count * sizeof(uint64_t));
+        qsort(sorted, dupes.count, sizeof(uint64_t), compare_u64);
+        files = (file_job_t*) calloc(dupes.count ? dupes.count : 1, sizeof(file_job_t));
+    }
+    for (size_t i = 0; files && i < dupes.count; i++) {
+        /* Binary search for the first entry of this size in sorted[] */
+        size_t lo = 0, hi = dupes.count;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (sorted[mid] < dupes.sizes[i])
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo + 1 < dupes.count && sorted[lo + 1] == dupes.sizes[i]) {
+            files[candidates].path = dupes.names + dupes.offsets[i];
+            files[candidates].edges = dupes.sizes[i] > 2 * DUPES_EDGE;
+            candidates++;
+        }
+    }
+    free(sorted);
+    verbose("Found %zu files, %zu of them share a size\n", dupes.count, candidates);
+
+    /* First pass: the edges of large files, small files whole */
+    list = files ? (file_job_t**) malloc((candidates ? candidates : 1) * sizeof(file_job_t*)) : NULL;
+    if (!list || run_file_pool(files, candidates, jobs, dupes_pass_report) != 0) {
+        oom = 1;
+        candidates = 0;
+    }
+    for (size_t i = 0; i < candidates; i++) {
+        if (files[i].err) {
+            print_file_job(&files[i]);
+            dupes.failed = 1;
+        } else {
+            list[listed++] = &files[i];
+        }
+    }
+    if (listed > 1)
+        qsort(list, listed, sizeof(file_job_t*), compare_dupes);
+
+    /* Second pass: full digests for files whose edges collide; other
+     * collisions are final, and files with unique edges drop out */
+    for (size_t i = 0; i < listed;) {
+        size_t run = dupes_run(list, listed, i);
+        if (run > 1 && list[i]->edges) full_count += run;
+        i += run;
+    }
+    full = full_count ? (file_job_t*) calloc(full_count, sizeof(file_job_t)) : NULL;
+    if (full_count && !full) {
+        oom = 1;
+        full_count = 0;
+    }
+    size_t kept = 0, n = 0;
+    for (size_t i = 0; i < listed;) {
+        size_t run = dupes_run(list, listed, i);
+        for (size_t j = i; j < i + run && run > 1; j++) {
+            if (!list[j]->edges)
+                list[kept++] = list[j];
+            else if (n < full_count)
+                full[n++].path = list[j]->path;
+        }
+        i += run;
+    }
+    verbose("Reading %zu files in full\n", full_count);
+    if (full_count && run_file_pool(full, full_count, jobs, dupes_pass_report) != 0) {
+        oom = 1;
+        full_count = 0;
+    }
+    for (size_t i = 0; i < full_count; i++) {
+        if (full[i].err) {
+            print_file_job(&full[i]);
+            dupes.failed = 1;
+        } else {
+            list[kept++] = &full[i];
+        }
+    }
+    if (kept > 1)
+        qsort(list, kept, sizeof(file_job_t*), compare_dupes);
+
+    /* Sets of identical files, largest first */
+    size_t sets = 0, redundant = 0;
+    uint64_t reclaimable = 0;
+    for (size_t i = 0; i < kept && !oom;) {
+        size_t run = dupes_run(list, kept, i);
+        if (run > 1) {
+            if (sets++ && !quiet_mode) putchar('\n');
+            for (size_t j = i; j < i + run && !quiet_mode; j++)
+                print_file_hash(list[j]->hash, list[j]->path);
+            redundant += run - 1;
+            reclaimable += (uint64_t) (run - 1) * list[i]->size;
+        }
+        i += run;
+    }
+    verbose("%zu sets of duplicates, %zu redundant files, %llu bytes\n", sets, redundant, (unsigned long long) reclaimable);
+
+    if (oom && !quiet_mode) fprintf(stderr, "Out of memory\n");
+    free(list);
+    free(full);
+    free(files);
+    free(dupes.sizes);
+    free(dupes.offsets);
+    free(dupes.devs);
+    free(dupes.inos);
+    free(dupes.names);
+    int failed = oom || dupes.failed;
+    memset(&dupes, 0, sizeof(dupes));
+    return failed;
+#else
+    (void) operands;
+    (void) count;
+    (void) jobs;
+    if (!quiet_mode) fprintf(stderr, "--dupes is not supported on this platform\n");
+    return 1;
+#endif
+}
+
+/* Sampled fingerprints (--sample N): a digest of the file size and of N
+ * evenly spaced SAMPLE_WINDOW-byte windows, the first at the start of the
+ * file and the last at its end, read concurrently by
+ * xzalgochain_file_ranges(). Files of at most N windows are covered whole by
+ * consecutive windows. The fingerprint hashes SAMPLE_TAG, then the size,
+ * window size and window count, then each window's offset, length and
+ * digest (64-bit little-endian fields). It catches most changes to huge
+ * files at a fraction of the I/O, but not all of them, so it is printed as
+ * "sampleN:HASH  FILE": it can never be mistaken for, or checked (-c) as,
+ * a full digest. */
+#define SAMPLE_TAG "xzalgochain-sample-1"
+#define SAMPLE_MAX 1000000
+
+/**
+ * Compute the sampled fingerprint of one file
+ * @param fd Open regular file or block device
+ * @param size Its size in bytes
+ * @param samples Windows to sample (N)
+ * @param hash Receives the fingerprint
+ * @return 0 on success, -1 on error (errno set)
+ */
+static int sample_fd(int fd, uint64_t size, size_t samples, uint8_t* hash) {
+    const int whole = size <= (uint64_t) samples * SAMPLE_WINDOW;
+    size_t count = whole ? (size_t) ((size + SAMPLE_WINDOW - 1) / SAMPLE_WINDOW) : samples;
+
+    XzalgoChain_Range* ranges = (XzalgoChain_Range*) malloc((count ? count : 1) * sizeof(XzalgoChain_Range));
+    uint8_t (*digests)[XZALGOCHAIN_HASH_SIZE] = (uint8_t (*)[XZALGOCHAIN_HASH_SIZE]) malloc((count ? count : 1) * XZALGOCHAIN_HASH_SIZE);
+    if (!ranges || !digests) {
+        free(ranges);
+        free(digests);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    if (whole || count == 1) {
+        /* Consecutive windows over the whole file (or the first window) */
+        for (size_t i = 0; i < count; i++) {
+            ranges[i].offset = (uint64_t) i * SAMPLE_WINDOW;
+            ranges[i].length = size - ranges[i].offset < SAMPLE_WINDOW ? size - ranges[i].offset : SAMPLE_WINDOW;
+        }
+    } else {
+        /* offset = i * span / (count - 1), without overflowing 64 bits */
+        const uint64_t span = size - SAMPLE_WINDOW, q = span / (count - 1), r = span % (count - 1);
+        for (size_t i = 0; i < count; i++) {
+            ranges[i].offset = q * i + r * i / (count - 1);
+            ranges[i].length = SAMPLE_WINDOW;
+        }
+    }
+
+    int rc = xzalgochain_file_ranges(fd, ranges, count, digests);
+    if (rc == 0) {
+        XzalgoChain_CTX ctx;
+        uint8_t field[8];
+        xzalgochain_init(&ctx);
+        xzalgochain_update(&ctx, (const uint8_t*) SAMPLE_TAG, sizeof(SAMPLE_TAG) - 1);
+        u64_to_bytes(size, field);
+        xzalgochain_update(&ctx, field, sizeof(field));
+        u64_to_bytes(SAMPLE_WINDOW, field);
+        xzalgochain_update(&ctx, field, sizeof(field));
+        u64_to_bytes(count, field);
+        xzalgochain_update(&ctx, field, sizeof(field));
+        for (size_t i = 0; i < count; i++) {
+            u64_to_bytes(ranges[i].offset, field);
+            xzalgochain_update(&ctx, field, sizeof(field));
+            u64_to_bytes(ranges[i].length, field);
+            xzalgochain_update(&ctx, field, sizeof(field));
+            xzalgochain_update(&ctx, digests[i], XZALGOCHAIN_HASH_SIZE);
+        }
+        xzalgochain_final(&ctx, hash);
+        xzalgochain_ctx_wipe(&ctx);
+        verbose("Sampled %zu windows of %llu bytes\n", count, (unsigned long long) size);
+    }
+
+    int saved_errno = errno;
+    free(ranges);
+    free(digests);
+    errno = saved_errno;
+    return rc;
+}
+
+/**
+ * Print the sampled fingerprint of every FILE operand (--sample N)
+ * Files are taken one at a time; the windows of each are read concurrently
+ * @param paths FILE operands ("-" is stdin, which must be seekable)
+ * @param count Number of operands
+ * @param samples Windows per file
+ * @return 0 if every file was sampled, 1 otherwise
+ */
+static int sample_files(char** paths, size_t count, size_t samples) {
+    int failed = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const char* path = paths[i];
+        uint8_t hash[XZALGOCHAIN_HASH_SIZE];
+        int is_stdin = strcmp(path, "-") == 0;
+#if defined(PLATFORM_WINDOWS)
+        int fd = is_stdin ? _fileno(stdin) : _open(path, _O_RDONLY | _O_BINARY);
+        long long end = fd < 0 ? -1 : _lseeki64(fd, 0, SEEK_END);
+#elif defined(XZ_FILE_HAVE_MMAP)
+        int fd = is_stdin ? STDIN_FILENO : open(path, O_RDONLY | O_CLOEXEC);
+        off_t end = fd < 0 ? -1 : lseek(fd, 0, SEEK_END);
+#else
+        int fd = -1;
+        long end = -1;
+        errno = ENOSYS;
+#endif
+        int rc = end < 0 ? -1 : sample_fd(fd, (uint64_t) end, samples, hash);
+        int saved_errno = errno;
+        if (fd >= 0 && !is_stdin) {
+#if defined(PLATFORM_WINDOWS)
+            _close(fd);
+#else
+            close(fd);
+#endif
+        }
+
+        if (rc != 0) {
+            failed = 1;
+            if (!quiet_mode) {
+                fflush(stdout);
+                fprintf(stderr, "%s %s: %s\n", fd < 0 ? "Cannot open" : "Cannot sample", path, strerror(saved_errno));
+            }
+        } else if (!quiet_mode) {
+            printf("sample%zu:", samples);
+            print_file_hash(hash, path);
+        }
+    }
+    return failed;
+}
+
+/* Piece hashes (--chunks): the digest of every --chunk-size bytes of a file,
+ * so that a transfer only re-fetches the pieces that fail. Each file gets its
+ * "HASH  FILE" line, then one "chunkSIZE:INDEX:HASH  FILE" line per chunk;
+ * chunk digests equal xzalgochain() of the chunk's bytes, the last chunk may
+ * be short, and an empty file has none. The file is read once, CHUNKS_BATCH
+ * bytes at a time: while one thread feeds a batch to the whole-file context,
+ * the others hash its chunks XZ_MULTI_LANES at a time with
+ * xzalgochain_many(). A chunk larger than a batch gets a context of its own.
+ * --chunks -c LIST rehashes the files listed and names the failing chunks. */
+#define CHUNKS_BATCH (32 * 1024 * 1024)
+
+/* One batch of --chunks work, shared by the threads that hash it */
+typedef struct {
+    const uint8_t* data;   /* Batch bytes */
+    size_t len;
+    size_t chunk_size;
+    size_t chunks;         /* Chunks that start in the batch, 0 for a piece of a larger one */
+    uint8_t (*digests)[XZALGOCHAIN_HASH_SIZE]; /* Their digests */
+    XzalgoChain_CTX* full;  /* Whole-file digest */
+    XzalgoChain_CTX* piece; /* Chunk larger than a batch, or NULL */
+    size_t tasks;           /* Whole-file update, then the piece or each lane group */
+#if defined(XZ_AIO_HAVE_THREADS)
+    atomic_size_t next;
+#else
+    size_t next;
+#endif
+} chunk_batch_t;
+
+/**
+ * Thread body: take batch tasks in turn until none are left
+ * Task 0 feeds the whole-file context, which takes longest, so it starts first
+ * @param arg chunk_batch_t shared by all threads
+ * @return NULL
+ */
+static void* chunk_batch_worker(void* arg) {
+    chunk_batch_t* b = (chunk_batch_t*) arg;
+
+    for (;;) {
+#if defined(XZ_AIO_HAVE_THREADS)
+        size_t t = atomic_fetch_add(&b->next, 1);
+#else
+        size_t t = b->next++;
+#endif
+        if (t >= b->tasks)
+            return NULL;
+
+        if (t == 0) {
+            xzalgochain_update(b->full, b->data, b->len);
+        } else if (b->piece) {
+            xzalgochain_update(b->piece, b->data, b->len);
+        } else {
+            const uint8_t* data[XZ_MULTI_LANES];
+            size_t lens[XZ_MULTI_LANES];
+            size_t first = (t - 1) * XZ_MULTI_LANES;
+            size_t n = b->chunks - first < XZ_MULTI_LANES ? b->chunks - first : XZ_MULTI_LANES;
+            for (size_t i = 0; i < n; i++) {
+                size_t off = (first + i) * b->chunk_size;
+                data[i] = b->data + off;
+                lens[i] = b->len - off < b->chunk_size ? b->len - off : b->chunk_size;
+            }
+            xzalgochain_many(data, lens, n, b->digests + first);
+        }
+    }
+}
+
+/**
+ * Hash a stream and each chunk_size-byte chunk of it in one read pass
+ * @param fp Open input
+ * @param chunk_size Chunk size in bytes
+ * @param jobs Threads per batch (-j)
+ * @param hash Receives the whole-file digest
+ * @param digests Receives the chunk digests (malloc'd, the caller frees it)
+ * @param count Receives the number of chunks
+ * @return 0 on success, -1 on error (errno set)
+ */
+static int chunk_stream(FILE* fp, size_t chunk_size, int jobs, uint8_t* hash,
+                        uint8_t (**digests)[XZALGOCHAIN_HASH_SIZE], size_t* count) {
+    const int large = chunk_size > CHUNKS_BATCH;
+    const size_t batch_size = large ? CHUNKS_BATCH : CHUNKS_BATCH / chunk_size * chunk_size;
+    uint8_t (*list)[XZALGOCHAIN_HASH_SIZE] = NULL;
+    size_t n = 0, cap = 0;
+    uint64_t piece_len = 0; /* Bytes of the current large chunk so far */
+    XzalgoChain_CTX full, piece;
+    int rc = 0;
+
+    if (jobs < 1) jobs = 1;
+    uint8_t* buf = (uint8_t*) malloc(batch_size);
+#if defined(XZ_AIO_HAVE_THREADS)
+    pthread_t* threads = (pthread_t*) malloc((size_t) jobs * sizeof(pthread_t));
+    if (!threads) jobs = 1;
+#endif
+    if (!buf) {
+        errno = ENOMEM;
+        rc = -1;
+    }
+    xzalgochain_init(&full);
+
+    while (rc == 0) {
+        /* Batches of whole chunks, or pieces that end where a large chunk does */
+        size_t want = large && chunk_size - piece_len < batch_size ? (size_t) (chunk_size - piece_len) : batch_size;
+        size_t len = fread(buf, 1, want, fp);
+        if (ferror(fp)) {
+            if (!errno) errno = EIO;
+            rc = -1;
+            break;
+        }
+        if (len == 0 && piece_len == 0)
+            break;
+
+        size_t starts = large ? piece_len == 0 : (len + chunk_size - 1) / chunk_size;
+        if (n + starts > cap) {
+            size_t grown_cap = cap ? cap * 2 : 64;
+            while (grown_cap < n + starts) grown_cap *= 2;
+            uint8_t (*grown)[XZALGOCHAIN_HASH_SIZE] = (uint8_t (*)[XZALGOCHAIN_HASH_SIZE]) realloc(list, grown_cap * XZALGOCHAIN_HASH_SIZE);
+            if (!grown) {
+                errno = ENOMEM;
+                rc = -1;
+                break;
+            }
+            list = grown;
+            cap = grown_cap;
+        }
+        if (large && piece_len == 0)
+            xzalgochain_init(&piece);
+
+        chunk_batch_t b;
+        memset(&b, 0, sizeof(b));
+        b.data = buf;
+        b.len = len;
+        b.chunk_size = chunk_size;
+        b.chunks = large ? 0 : starts;
+        b.digests = list + n;
+        b.full = &full;
+        b.piece = large ? &piece : NULL;
+        b.tasks = 1 + (large ? 1 : (starts + XZ_MULTI_LANES - 1) / XZ_MULTI_LANES);
+
+#if defined(XZ_AIO_HAVE_THREADS)
+        atomic_init(&b.next, 0);
+        size_t want_threads = (size_t) jobs < b.tasks ? (size_t) jobs : b.tasks;
+        size_t started = 0;
+        while (started + 1 < want_threads && pthread_create(&threads[started], NULL, chunk_batch_worker, &b) == 0)
+            started++;
+        chunk_batch_worker(&b);
+        for (size_t t = 0; t < started; t++)
+            pthread_join(threads[t], NULL);
+#else
+        chunk_batch_worker(&b);
+#endif
+
+        if (large) {
+            piece_len += len;
+            if (piece_len == chunk_size || len < want) {
+                xzalgochain_final(&piece, list[n++]);
+                piece_len = 0;
+            }
+        } else {
+            n += starts;
+        }
+        if (len < want)
+            break;
+    }
+
+    if (rc == 0) {
+        xzalgochain_final(&full, hash);
+        *digests = list;
+        *count = n;
+    } else {
+        int saved_errno = errno;
+        free(list);
+        errno = saved_errno;
+    }
+    xzalgochain_ctx_wipe(&full);
+    if (large) xzalgochain_ctx_wipe(&piece);
+#if defined(XZ_AIO_HAVE_THREADS)
+    free(threads);
+#endif
+    free(buf);
+    return rc;
+}
+
+/**
+ * Print the whole-file and chunk digests of every FILE operand (--chunks)
+ * Files are taken one at a time; the chunks of each are hashed in parallel
+ * @param paths FILE operands ("-" is stdin)
+ * @param count Number of operands
+ * @param chunk_size Chunk size in bytes
+ * @param jobs Threads per file (-j)
+ * @return 0 if every file was hashed, 1 otherwise
+ */
+static int chunk_files(char** paths, size_t count, size_t chunk_size, int jobs) {
+    int failed = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const char* label = NULL;
+        uint8_t hash[XZALGOCHAIN_HASH_SIZE];
+        uint8_t (*digests)[XZALGOCHAIN_HASH_SIZE] = NULL;
+        size_t chunks = 0;
+
+        FILE* fp = open_input_stream(paths[i], NULL, &label);
+        int rc = fp ? chunk_stream(fp, chunk_size, jobs, hash, &digests, &chunks) : -1;
+        int saved_errno = errno;
+        if (fp && fp != stdin)
+            fclose(fp);
+
+        if (rc != 0) {
+            failed = 1;
+            if (!quiet_mode) {
+                fflush(stdout);
+                fprintf(stderr, "%s %s: %s\n", fp ? "Error reading" : "Cannot open", paths[i], strerror(saved_errno));
+            }
+        } else {
+            verbose("Hashed %zu chunks of %zu bytes from %s\n", chunks, chunk_size, paths[i]);
+            if (!quiet_mode) {
+                print_file_hash(hash, paths[i]);
+                for (size_t c = 0; c < chunks; c++) {
+                    printf("chunk%zu:%zu:", chunk_size, c);
+                    print_file_hash(digests[c], paths[i]);
+                }
+            }
+        }
+        free(digests);
+    }
+    return failed;
+}
+
+/**
+ * Take the "chunkSIZE:INDEX:" prefix off a --chunks line
+ * @param line Line; advanced past the prefix
+ * @param len Line length; reduced by the prefix
+ * @param size Receives SIZE
+ * @param index Receives INDEX
+ * @return 1 if the line had a prefix, 0 for a whole-file line, -1 if the prefix is malformed
+ */
+static int parse_chunk_prefix(char** line, size_t* len, uint64_t* size, uint64_t* index) {
+    if (*len < 5 || memcmp(*line, "chunk", 5) != 0)
+        return 0;
+
+    char* p = *line + 5;
+    uint64_t fields[2];
+    for (int f = 0; f < 2; f++) {
+        char* end;
+        if (*p < '0' || *p > '9')
+            return -1;
+        errno = 0;
+        fields[f] = strtoull(p, &end, 10);
+        if (errno != 0 || *end != ':')
+            return -1;
+        p = end + 1;
+    }
+
+    *size = fields[0];
+    *index = fields[1];
+    *len -= (size_t) (p - *line);
+    *line = p;
+    return 1;
+}
+
+/* Expected digest of one chunk (--chunks -c) */
+typedef struct {
+    uint64_t index;
+    uint8_t expected[XZALGOCHAIN_HASH_SIZE];
+} chunk_entry_t;
+
+/* Consecutive lines of a chunk list that name the same file */
+typedef struct {
+    const char* path;
+    int has_full;                        /* A "HASH  FILE" line was listed */
+    uint8_t full[XZALGOCHAIN_HASH_SIZE]; /* Its digest */
+    size_t chunk_size;                   /* 0 until a chunk line is seen */
+    chunk_entry_t* chunks;
+    size_t count;
+    size_t cap;
+} chunk_check_t;
+
+/**
+ * Print one failure line of a chunk check
+ * @param path File name
+ * @param what Rest of the line: " FAILED", " chunk N FAILED" or " FAILED open or read"
+ */
+static void print_chunk_failure(const char* path, const char* what) {
+    if (quiet_mode)
+        return;
+    int escape = name_needs_escape(path);
+    if (escape) putchar('\\');
+    print_file_name(path, escape);
+    printf(":%s\n", what);
+}
+
+/**
+ * Rehash one listed file and compare its whole-file and chunk digests
+ * Failing chunks are printed one per line in list order, so that a transfer
+ * agent can fetch exactly those; chunks listed past the end of the file fail
+ * @param check Listed digests of the file
+ * @param jobs Threads (-j)
+ * @param totals Updated with the outcome for the file
+ */
+static void check_chunk_file(const chunk_check_t* check, int jobs, check_totals_t* totals) {
+    const char* label = NULL;
+    uint8_t hash[XZALGOCHAIN_HASH_SIZE];
+    uint8_t (*digests)[XZALGOCHAIN_HASH_SIZE] = NULL;
+    size_t chunks = 0;
+
+    FILE* fp = open_input_stream(check->path, NULL, &label);
+    int rc = fp ? chunk_stream(fp, check->chunk_size ? check->chunk_size : CHUNKS_DEFAULT_SIZE, jobs, hash, &digests, &chunks) : -1;
+    int saved_errno = errno;
+    if (fp && fp != stdin)
+        fclose(fp);
+
+    if (rc != 0) {
+        totals->unreadable++;
+        if (!quiet_mode) {
+            fflush(stdout);
+            fprintf(stderr, "%s %s: %s\n", fp ? "Error reading" : "Cannot open", check->path, strerror(saved_errno));
+        }
+        print_chunk_failure(check->path, " FAILED open or read");
+        return;
+    }
+
+    int failed = 0;
+    for (size_t i = 0; i < check->count; i++) {
+        const chunk_entry_t* e = &check->chunks[i];
+        if (e->index < chunks && xzalgochain_equals(e->expected, digests[e->index]))
+            continue;
+        char what[48];
+        snprintf(what, sizeof(what), " chunk %llu FAILED", (unsigned long long) e->index);
+        print_chunk_failure(check->path, what);
+        failed = 1;
+    }
+    if (check->has_full && !xzalgochain_equals(check->full, hash)) {
+        print_chunk_failure(check->path, " FAILED");
+        failed = 1;
+    }
+
+    if (failed)
+        totals->failed++;
+    else
+        totals->ok++;
+    free(digests);
+}
+
+/**
+ * Verify a list printed by --chunks (--chunks -c LIST)
+ * Lines for the same file must be consecutive and share one chunk size;
+ * each file is read once. Only failures are printed, then a summary line
+ * counting files.
+ * @param list List path ("-" is stdin)
+ * @param jobs Threads (-j)
+ * @return 0 if every listed digest matched, 1 otherwise
+ */
+static int check_chunks(const char* list, int jobs) {
+    const char* label = NULL;
+    check_totals_t totals = {0, 0, 0, 0};
+    chunk_check_t check;
+    size_t cap = CHECK_BUFFER, len = 0;
+    int rc = 0;
+
+    FILE* fp = open_input_stream(list, NULL, &label);
+    if (!fp) {
+        if (!quiet_mode) fprintf(stderr, "Cannot open %s: %s\n", list, strerror(errno));
+        return 1;
+    }
+
+    /* Lists hold one short line per chunk: read the whole list, keeping a byte for the NUL */
+    char* buf = (char*) malloc(cap);
+    while (buf) {
+        len += fread(buf + len, 1, cap - 1 - len, fp);
+        if (ferror(fp) || len < cap - 1)
+            break;
+        char* grown = (char*) realloc(buf, cap * 2);
+        if (!grown) {
+            free(buf);
+            buf = NULL;
+            break;
+        }
+        buf = grown;
+        cap *= 2;
+    }
+    if (!buf || ferror(fp)) {
+        if (!quiet_mode && buf)
+            fprintf(stderr, "Error reading %s: %s\n", label, strerror(errno));
+        else if (!quiet_mode)
+            fprintf(stderr, "Out of memory\n");
+        if (fp != stdin)
+            fclose(fp);
+        free(buf);
+        return 1;
+    }
+    if (fp != stdin)
+        fclose(fp);
+
+    memset(&check, 0, sizeof(check));
+    for (size_t pos = 0; pos < len && rc == 0;) {
+        char* line = buf + pos;
+        char* nl = (char*) memchr(line, '\n', len - pos);
+        size_t line_len = nl ? (size_t) (nl - line) : len - pos;
+        line[line_len] = '\0';
+        pos += line_len + 1;
+        if (line_len == 0)
+            continue;
+
+        file_job_t job;
+        uint64_t size = 0, index = 0;
+        memset(&job, 0, sizeof(job));
+        int is_chunk = parse_chunk_prefix(&line, &line_len, &size, &index);
+        if (is_chunk < 0 || parse_manifest_line(line, line_len, &job) != 0 ||
+            (is_chunk && (size < CHUNKS_MIN_SIZE || (uint64_t) (size_t) size != size))) {
+            totals.malformed++;
+            continue;
+        }
+
+        /* A new file: check the previous one */
+        if (check.path && strcmp(check.path, job.path) != 0) {
+            check_chunk_file(&check, jobs, &totals);
+            check.has_full = 0;
+            check.chunk_size = 0;
+            check.count = 0;
+        }
+        if (is_chunk && check.chunk_size && size != check.chunk_size) {
+            totals.malformed++;
+            continue;
+        }
+        check.path = job.path;
+
+        if (!is_chunk) {
+            check.has_full = 1;
+            memcpy(check.full, job.expected, XZALGOCHAIN_HASH_SIZE);
+            continue;
+        }
+        if (check.count == check.cap) {
+            size_t grown_cap = check.cap ? check.cap * 2 : 64;
+            chunk_entry_t* grown = (chunk_entry_t*) realloc(check.chunks, grown_cap * sizeof(chunk_entry_t));
+            if (!grown) {
+                if (!quiet_mode) fprintf(stderr, "Out of memory\n");
+                rc = 1;
+                break;
+            }
+            check.chunks = grown;
+            check.cap = grown_cap;
+        }
+        check.chunk_size = (size_t) size;
+        check.chunks[check.count].index = index;
+        memcpy(check.chunks[check.count++].expected, job.expected, XZALGOCHAIN_HASH_SIZE);
+    }
+    if (rc == 0 && check.path)
+        check_chunk_file(&check, jobs, &totals);
+
+    free(check.chunks);
+    free(buf);
+    if (rc)
+        return 1;
+    return check_summary(label, &totals);
+}
+
+/* Tee mode (--tee): stdin is copied to stdout while it is hashed. When both
+ * are pipes on Linux, tee(2) duplicates the pipe's pages into stdout without
+ * copying them and read() then drains the same bytes for hashing, so data
+ * reaches user space once instead of twice as with read() and write(). */
+#define TEE_CHUNK (1024 * 1024)
+#define TEE_PIPE_SIZE (1024 * 1024)
+
+#if defined(PLATFORM_LINUX) && defined(F_SETPIPE_SZ)
+    #define TEE_HAVE_SPLICE 1
+#endif
+
+/**
+ * Write a whole buffer to stdout
+ * @param buf Bytes to write
+ * @param len Number of bytes
+ * @return 0 on success, -1 on error (errno set)
+ */
+static int tee_write(const uint8_t* buf, size_t len) {
+#if defined(XZ_FILE_HAVE_MMAP)
+    while (len > 0) {
+        ssize_t w = write(STDOUT_FILENO, buf, len);
+        if (w < 0 && errno == EINTR)
+            continue;
+        if (w < 0)
+            return -1;
+        buf += w;
+        len -= (size_t) w;
+    }
+    return 0;
+#else
+    return fwrite(buf, 1, len, stdout) == len ? 0 : -1;
+#endif
+}
+
+/**
+ * Read the next part of stdin
+ * @param buf Destination
+ * @param len Largest number of bytes to read
+ * @return Bytes read, 0 at end of input, -1 on error (errno set)
+ */
+static long tee_read(uint8_t* buf, size_t len) {
+#if defined(XZ_FILE_HAVE_MMAP)
+    for (;;) {
+        ssize_t r = read(STDIN_FILENO, buf, len);
+        if (r < 0 && errno == EINTR)
+            continue;
+        return (long) r;
+    }
+#else
+    size_t r = fread(buf, 1, len, stdin);
+    return r == 0 && ferror(stdin) ? -1 : (long) r;
+#endif
+}
+
+#if defined(TEE_HAVE_SPLICE)
+/**
+ * Duplicate stdin into stdout with tee(2), then read the same bytes to hash them
+ * Both descriptors must be pipes; they are grown to TEE_PIPE_SIZE where the
+ * system allows it, so each round trip moves more data
+ * @param ctx Hash context
+ * @param buf TEE_CHUNK-byte buffer
+ * @param total Incremented by the number of bytes hashed
+ * @return 0 at end of input, -1 on error (errno set), 1 if tee(2) is unavailable
+ */
+static int tee_splice(XzalgoChain_CTX* ctx, uint8_t* buf, uint64_t* total) {
+    fcntl(STDIN_FILENO, F_SETPIPE_SZ, TEE_PIPE_SIZE);
+    fcntl(STDOUT_FILENO, F_SETPIPE_SZ, TEE_PIPE_SIZE);
+
+    for (;;) {
+        ssize_t n = tee(STDIN_FILENO, STDOUT_FILENO, TEE_CHUNK, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0 && (errno == EINVAL || errno == ENOSYS) && *total == 0)
+            return 1;
+        if (n <= 0)
+            return (int) n;
+
+        /* The duplicated bytes are at the head of stdin: consume them */
+        while (n > 0) {
+            long r = tee_read(buf, (size_t) n);
+            if (r <= 0) {
+                if (r == 0) errno = EIO;
+                return -1;
+            }
+            xzalgochain_update(ctx, buf, (size_t) r);
+            *total += (uint64_t) r;
+            n -= r;
+        }
+    }
+}
+#endif
+
+/**
+ * Copy stdin to stdout while hashing it, then report the digest
+ * The digest line has the "HASH  -" form of multi-file mode, so a digest
+ * file can later be checked with -c FILE against the saved stream
+ * @param digest_path File for the digest line, or NULL for stderr
+ * @return 0 on success, 1 on error
+ */
+static int tee_stream(const char* digest_path) {
+    XzalgoChain_CTX ctx;
+    uint8_t hash[XZALGOCHAIN_HASH_SIZE];
+    uint64_t total = 0;
+    int rc = 1;
+    const char* how = "read() and write()";
+
+    uint8_t* buf = _xz_file_buf_alloc(TEE_CHUNK);
+    if (!buf) {
+        if (!quiet_mode) fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+#ifdef PLATFORM_WINDOWS
+    _setmode(_fileno(stdin), _O_BINARY);
+#endif
+    xzalgochain_init(&ctx);
+
+#if defined(TEE_HAVE_SPLICE)
+    struct stat in_st, out_st;
+    if (fstat(STDIN_FILENO, &in_st) == 0 && S_ISFIFO(in_st.st_mode) &&
+        fstat(STDOUT_FILENO, &out_st) == 0 && S_ISFIFO(out_st.st_mode))
+        rc = tee_splice(&ctx, buf, &total);
+    if (rc != 1)
+        how = "tee(2)";
+#endif
+
+    /* Anything but two pipes: read, hash, write */
+    while (rc == 1) {
+        long r = tee_read(buf, TEE_CHUNK);
+        if (r <= 0) {
+            rc = (int) r;
+            break;
+        }
+        xzalgochain_update(&ctx, buf, (size_t) r);
+        total += (uint64_t) r;
+        if (tee_write(buf, (size_t) r) != 0)
+            rc = -1;
+    }
+    _xz_file_buf_free(buf);
+
+    if (rc != 0) {
+        if (!quiet_mode) fprintf(stderr, "Tee failed after %llu bytes: %s\n", (unsigned long long) total, strerror(errno));
+        xzalgochain_ctx_wipe(&ctx);
+        return 1;
+    }
+    xzalgochain_final(&ctx, hash);
+    xzalgochain_ctx_wipe(&ctx);
+    verbose("Copied %llu bytes from stdin with %s\n", (unsigned long long) total, how);
+
+    if (fflush(stdout) != 0) {
+        if (!quiet_mode) fprintf(stderr, "Cannot write stdout: %s\n", strerror(errno));
+        return 1;
+    }
+
+    char line[XZALGOCHAIN_HASH_SIZE * 2 + 4];
+    xzalgochain_to_hex(hash, XZALGOCHAIN_HASH_SIZE, line);
+    memcpy(line + XZALGOCHAIN_HASH_SIZE * 2, "  -\n", 4);
+
+    if (!digest_path) {
+        if (!quiet_mode) fwrite(line, 1, sizeof(line), stderr);
+        return 0;
+    }
+    FILE* out = fopen(digest_path, "wb");
+    if (!out || fwrite(line, 1, sizeof(line), out) != sizeof(line) || fclose(out) != 0) {
+        if (!quiet_mode) fprintf(stderr, "Cannot write %s: %s\n", digest_path, strerror(errno));
+        return 1;
+    }
+    return 0;
+}
+
+/* Windows getopt implementation (if not provided by compiler) */
+#ifdef PLATFORM_WINDOWS
+    #ifndef HAVE_GETOPT
+int optind = 1;
+int optopt;
+char* optarg;
+
+/**
+ * Simple getopt implementation for Windows
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param optstring Option string (e.g., "i:c:qvVhf")
+ * @return Option character, or -1 if done, or '?' on error
+ */
+static int getopt_win(int argc, char* const argv[], const char* optstring) {
+    static char* nextchar = NULL;
+
+    if (optind >= argc)
+        return -1;
+
+    if (nextchar == NULL || *nextchar == '\0') {
+        nextchar = argv[optind];
+        if (nextchar[0] != '-' || nextchar[1] == '\0') {
+            return -1;
+        }
+        nextchar++;
+    }
+
+    char opt = *nextchar++;
+    const char* pos = strchr(optstring, opt);
+
+    if (pos == NULL || opt == ':') {
+        optopt = opt;
+        return '?';
+    }
+
+    if (pos[1] == ':') {
+        if (*nextchar != '\0') {
+            optarg = nextchar;
+            nextchar = NULL;
+        } else if (optind + 1 < argc) {
+            optarg = argv[++optind];
+            nextchar = NULL;
+        } else {
+            optopt = opt;
+            return ':';
+        }
+    }
+
+    return opt;
+}
+
+        #define getopt getopt_win
+    #endif
+#endif
+
+/**
+ * Main program entry point
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return 0 on success, non-zero on error
+ */
+/* Long options, taken out of argv before getopt() sees it (the Windows
+ * getopt() above has no getopt_long()) */
+enum {
+    LONG_STATUS = 1,
+    LONG_FILES,
+    LONG_CACHE,
+    LONG_VERIFY_CACHE,
+    LONG_MANIFEST_OUT,
+    LONG_MANIFEST_IN,
+    LONG_TEE,
+    LONG_DUPES,
+    LONG_SAMPLE,
+    LONG_CHUNKS,
+    LONG_CHUNK_SIZE
+};
+
+typedef struct {
+    const char* name;
+    int has_arg; /* 0: none, 1: required, 2: optional (only as --name=value) */
+    int id;
+} long_option_t;
+
+static const long_option_t long_options[] = {
+    {"status", 0, LONG_STATUS},
+    {"files", 0, LONG_FILES},
+    {"cache", 1, LONG_CACHE},
+    {"verify-cache", 1, LONG_VERIFY_CACHE},
+    {"manifest-out", 1, LONG_MANIFEST_OUT},
+    {"manifest-in", 1, LONG_MANIFEST_IN},
+    {"tee", 2, LONG_TEE},
+    {"dupes", 0, LONG_DUPES},
+    {"sample", 1, LONG_SAMPLE},
+    {"chunks", 0, LONG_CHUNKS},
+    {"chunk-size", 1, LONG_CHUNK_SIZE},
+};
+
+/* Short options for getopt() */
+static const char short_options[] = "i:c:s:qvVhfu:Q:B:Dj:r";
+
+/**
+ * Check whether argv[*a] is a long option and take it
+ * Accepts "--name", "--name=value" and "--name value" ("--name value" not
+ * for options whose value is optional)
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @param a Index of the argument; advanced past a separate value
+ * @param value Receives the option value (NULL without one)
+ * @return Option id, 0 if argv[*a] is not a long option, -1 on error (reported)
+ */
+static int take_long_option(int argc, char** argv, int* a, const char** value) {
+    const char* arg = argv[*a];
+    *value = NULL;
+    if (strncmp(arg, "--", 2) != 0 || arg[2] == '\0')
+        return 0;
+
+    const char* name = arg + 2;
+    const char* eq = strchr(name, '=');
+    size_t name_len = eq ? (size_t) (eq - name) : strlen(name);
+
+    for (size_t i = 0; i < sizeof(long_options) / sizeof(long_options[0]); i++) {
+        const long_option_t* o = &long_options[i];
+        if (strlen(o->name) != name_len || strncmp(o->name, name, name_len) != 0)
+            continue;
+
+        if (!o->has_arg && eq) {
+            fprintf(stderr, "Option --%s takes no value\n", o->name);
+            return -1;
+        }
+        if (o->has_arg == 2) {
+            *value = eq ? eq + 1 : NULL;
+        } else if (o->has_arg) {
+            if (eq) {
+                *value = eq + 1;
+            } else if (*a + 1 < argc) {
+                *value = argv[++*a];
+            } else {
+                fprintf(stderr, "Option --%s requires a value\n", o->name);
+                return -1;
+            }
+        }
+        return o->id;
+    }
+
+    fprintf(stderr, "Unknown option: %s\n", arg);
+    return -1;
+}
+
+/**
+ * Check whether a short-option argument ends in an option that takes the
+ * next argument as its value (as -i does in "-qi TEXT")
+ * @param arg Argument starting with '-'
+ * @return 1 if the next argument belongs to it
+ */
+static int short_option_takes_next(const char* arg) {
+    if (arg[0] != '-' || arg[1] == '\0' || arg[1] == '-')
+        return 0;
+    for (const char* c = arg + 1; *c; c++) {
+        const char* spec = strchr(short_options, *c);
+        if (spec && spec[1] == ':')
+            return c[1] == '\0'; /* Value is the rest of arg, or the next argument */
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int opt;
+    const char* check_str = NULL;    /* Hash to check against */
+    const char* check_salt = NULL;   /* Salt for hash check */
+    const char* string_input = NULL; /* String input mode */
+    const char* filename = NULL;     /* File input mode */
+    XzalgoChain_CTX ctx;
+    uint8_t hash[XZALGOCHAIN_HASH_SIZE];
+    uint8_t expected[XZALGOCHAIN_HASH_SIZE];
+    int has_expected = 0;
+    int aio_set = 0; /* -Q, -B or -D given */
+    int jobs = 0;    /* Worker threads for FILE operands (-j), 0 for one per core */
+    int status_only = 0; /* --status */
+    int tree_mode = 0;   /* -r */
+    int list_files = 0;  /* --files */
+    const char* cache_path = NULL; /* --cache */
+    size_t verify_rate = 0;        /* --verify-cache */
+    const char* manifest_in = NULL; /* --manifest-in */
+    int tee_mode = 0;               /* --tee */
+    const char* tee_digest = NULL;  /* --tee=FILE */
+    int dupes_mode = 0;             /* --dupes */
+    size_t samples = 0;             /* --sample */
+    int chunks_mode = 0;            /* --chunks */
+    size_t chunk_size = 0;          /* --chunk-size */
+
+#ifdef PLATFORM_WINDOWS
+    /* Set stdout to binary mode on Windows to avoid output corruption */
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    /* Files and pipes get digest lines in large blocks; terminals stay line-buffered */
+#ifdef PLATFORM_WINDOWS
+    if (!_isatty(_fileno(stdout)))
+#else
+    if (!isatty(fileno(stdout)))
+#endif
+        setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+
+    /* Long options first; getopt() then parses the short ones in what is left */
+    int kept = 1;
+    for (int a = 1; a < argc; a++) {
+        const char* value = NULL;
+        if (strcmp(argv[a], "--") == 0) {
+            while (a < argc) argv[kept++] = argv[a++];
+            break;
+        }
+
+        int id = take_long_option(argc, argv, &a, &value);
+        if (id < 0) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        if (id == 0) {
+            argv[kept++] = argv[a];
+            if (short_option_takes_next(argv[a]) && a + 1 < argc)
+                argv[kept++] = argv[++a];
+            continue;
+        }
+
+        switch (id) {
+            case LONG_STATUS:
+                status_only = 1;
+                break;
+            case LONG_FILES:
+                list_files = 1;
+                break;
+            case LONG_CACHE:
+                cache_path = value;
+                break;
+            case LONG_MANIFEST_OUT:
+                manifest_out.path = value;
+                break;
+            case LONG_MANIFEST_IN:
+                manifest_in = value;
+                break;
+            case LONG_TEE:
+                tee_mode = 1;
+                tee_digest = value;
+                break;
+            case LONG_DUPES:
+                dupes_mode = 1;
+                break;
+            case LONG_SAMPLE:
+                if (parse_size(value, &samples) != 0 || samples == 0 || samples > SAMPLE_MAX) {
+                    fprintf(stderr, "Invalid value for --sample: %s (1-%d)\n", value, SAMPLE_MAX);
+                    return 1;
+                }
+                break;
+            case LONG_CHUNKS:
+                chunks_mode = 1;
+                break;
+            case LONG_CHUNK_SIZE:
+                if (parse_size(value, &chunk_size) != 0 || chunk_size < CHUNKS_MIN_SIZE) {
+                    fprintf(stderr, "Invalid value for --chunk-size: %s (%dK or more)\n", value, CHUNKS_MIN_SIZE / 1024);
+                    return 1;
+                }
+                break;
+            case LONG_VERIFY_CACHE:
+                if (parse_size(value, &verify_rate) != 0 || verify_rate == 0 || verify_rate > 100) {
+                    fprintf(stderr, "Invalid value for --verify-cache: %s (1-100)\n", value);
+                    return 1;
+                }
+                break;
+        }
+    }
+    argc = kept;
+    argv[argc] = NULL;
+
+    /* Parse command-line options */
+    while ((opt = getopt(argc, argv, short_options)) != -1) {
+        switch (opt) {
+            case 'i':
+                string_input = optarg;
+                break;
+            case 'c':
+                check_str = optarg;
+                break;
+            case 's':
+                check_salt = optarg;
+                break;
+            case 'u':
+                if (strcmp(optarg, "yes") == 0) {
+                    use_salt = 1;
+                } else if (strcmp(optarg, "no") == 0) {
+                    use_salt = 0;
+                } else {
+                    fprintf(stderr, "Invalid value for -u: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'Q': {
+                size_t depth;
+                if (parse_size(optarg, &depth) != 0 || depth == 1 || depth > XZ_AIO_MAX_DEPTH) {
+                    fprintf(stderr, "Invalid value for -Q: %s (0 or 2-%d)\n", optarg, XZ_AIO_MAX_DEPTH);
+                    return 1;
+                }
+                aio_depth = (unsigned int) depth;
+                aio_set = 1;
+                break;
+            }
+            case 'B':
+                if (parse_size(optarg, &aio_buffer) != 0 || aio_buffer == 0 || aio_buffer > XZ_AIO_MAX_BUFFER) {
+                    fprintf(stderr, "Invalid value for -B: %s (1-%dM)\n", optarg, XZ_AIO_MAX_BUFFER >> 20);
+                    return 1;
+                }
+                aio_set = 1;
+                break;
+            case 'D':
+                aio_flags |= XZ_AIO_DIRECT;
+                aio_set = 1;
+                break;
+            case 'j': {
+                size_t n;
+                if (parse_size(optarg, &n) != 0 || n == 0 || n > 4096) {
+                    fprintf(stderr, "Invalid value for -j: %s\n", optarg);
+                    return 1;
+                }
+                jobs = (int) n;
+                break;
+            }
+            case 'r':
+                tree_mode = 1;
+                break;
+            case 'q':
+                quiet_mode = 1;
+                break;
+            case 'v':
+                print_version();
+                return 0;
+            case 'V':
+                verbose_mode = 1;
+                break;
+            case 'h':
+                print_help(argv[0]);
+                return 0;
+            case 'f':
+                xzalgochain_force_scalar(1);
+                if (verbose_mode) fprintf(stderr, "Force scalar mode enabled\n");
+                break;
+            case '?':
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    /* One CPU cannot hash while it copies the next buffer: map the file instead */
+#ifdef _SC_NPROCESSORS_ONLN
+    if (!aio_set && sysconf(_SC_NPROCESSORS_ONLN) < 2)
+        aio_depth = 0;
+#endif
+
+    /* --status: report through the exit status only */
+    if (status_only)
+        quiet_mode = 1;
+
+    /* FILE operands: any number without -c, one with it */
+    size_t file_count = optind < argc ? (size_t) (argc - optind) : 0;
+
+    /* --tee: stdin to stdout, digest to stderr or FILE */
+    if (tee_mode) {
+        if (file_count > 0 || check_str || string_input || check_salt || use_salt || tree_mode || list_files ||
+            cache_path || verify_rate || manifest_out.path || manifest_in || status_only) {
+            fprintf(stderr, "Error: --tee copies stdin to stdout (no FILE, -c, -i, -s, -u, -r, --cache or manifests)\n");
+            return 1;
+        }
+        if (tee_digest && !*tee_digest) {
+            fprintf(stderr, "Error: --tee=FILE needs a file name\n");
+            return 1;
+        }
+        return tee_stream(tee_digest);
+    }
+
+    /* --chunks: whole-file and chunk digests of the FILE operands, or -c LIST to verify them */
+    if (chunk_size && !chunks_mode) {
+        fprintf(stderr, "Error: --chunk-size requires --chunks\n");
+        return 1;
+    }
+    if (chunks_mode) {
+        int list = check_str && parse_hash(check_str, expected) != 0;
+        if ((list ? file_count > 0 : file_count == 0 || check_str || status_only) || string_input || check_salt ||
+            use_salt || tree_mode || list_files || cache_path || verify_rate || manifest_out.path || manifest_in ||
+            samples || dupes_mode) {
+            fprintf(stderr, "Error: --chunks hashes FILE operands or checks -c LIST (no -i, -s, -u, -r, --sample, --dupes, --cache or manifests)\n");
+            return 1;
+        }
+        if (jobs == 0) jobs = default_jobs();
+        return list ? check_chunks(check_str, jobs) : chunk_files(argv + optind, file_count, chunk_size ? chunk_size : CHUNKS_DEFAULT_SIZE, jobs);
+    }
+
+    /* --sample: sampled fingerprints of the FILE operands */
+    if (samples) {
+        if (file_count == 0 || check_str || string_input || check_salt || use_salt || tree_mode || list_files ||
+            cache_path || verify_rate || manifest_out.path || manifest_in || status_only || dupes_mode) {
+            fprintf(stderr, "Error: --sample fingerprints FILE operands (no -c, -i, -s, -u, -r, --dupes, --cache or manifests)\n");
+            return 1;
+        }
+        return sample_files(argv + optind, file_count, samples);
+    }
+
+    /* --dupes: sets of identical files below the DIR operands */
+    if (dupes_mode) {
+        if (file_count == 0 || check_str || string_input || check_salt || use_salt || tree_mode || list_files ||
+            cache_path || verify_rate || manifest_out.path || manifest_in || status_only) {
+            fprintf(stderr, "Error: --dupes searches DIR operands (no -c, -i, -s, -u, -r, --cache or manifests)\n");
+            return 1;
+        }
+        if (jobs == 0) jobs = default_jobs();
+        if (jobs > 1 && !aio_set) aio_depth = 0;
+        return find_dupes(argv + optind, file_count, jobs);
+    }
+
+    /* --cache: FILE operands, -c FILE, --manifest-in and -r skip files unchanged since their digest was stored */
+    if (verify_rate && !cache_path) {
+        fprintf(stderr, "Error: --verify-cache requires --cache\n");
+        return 1;
+    }
+    if (cache_path) {
+        int manifest = check_str && parse_hash(check_str, expected) != 0;
+        if ((file_count == 0 && !manifest && !manifest_in) || (check_str && !manifest) || string_input || check_salt || use_salt) {
+            fprintf(stderr, "Error: --cache applies to FILE operands, -c FILE, --manifest-in and -r (no -c HASH, -i, -s or -u)\n");
+            return 1;
+        }
+    }
+
+    /* --manifest-out: the FILE operands or -r trees, also written as a binary manifest */
+    if (manifest_out.path && (file_count == 0 || check_str || string_input || check_salt || use_salt || manifest_in)) {
+        fprintf(stderr, "Error: --manifest-out records FILE operands or -r trees (no -c, -i, -s, -u or --manifest-in)\n");
+        return 1;
+    }
+
+    /* --manifest-in: verify a binary manifest, all of it or the FILE operands listed in it */
+    if (manifest_in) {
+        if (tree_mode || list_files || check_str || string_input || check_salt || use_salt) {
+            fprintf(stderr, "Error: --manifest-in checks the files listed in it (no -r, -c, -i, -s or -u)\n");
+            return 1;
+        }
+        if (jobs == 0) jobs = default_jobs();
+        if (jobs > 1 && !aio_set) aio_depth = 0;
+        if (cache_path && cache_open(cache_path, (unsigned int) verify_rate) != 0)
+            return 1;
+        int rc = check_binary_manifest(manifest_in, file_count ? argv + optind : NULL, file_count, jobs);
+        return rc | cache_close();
+    }
+
+    /* -r: one digest per directory operand */
+    if (tree_mode || list_files) {
+        if (!tree_mode || file_count == 0 || check_str || string_input || check_salt || use_salt) {
+            fprintf(stderr, "Error: -r hashes DIR operands (no -c, -i, -s or -u; --files requires -r)\n");
+            return 1;
+        }
+        if (jobs == 0) jobs = default_jobs();
+        if (jobs > 1 && !aio_set) aio_depth = 0;
+        if (cache_path && cache_open(cache_path, (unsigned int) verify_rate) != 0)
+            return 1;
+
+        int rc = 0;
+        for (int a = optind; a < argc; a++)
+            rc |= hash_tree(argv[a], jobs, list_files);
+        return rc | cache_close() | manifest_finish();
+    }
+
+    /* -c with something other than a hash names a manifest of "HASH  FILE" lines */
+    if (check_str && parse_hash(check_str, expected) != 0) {
+        if (file_count > 0 || string_input || check_salt || use_salt) {
+            fprintf(stderr, "Error: -c FILE checks the files listed in FILE (no FILE, -i, -s or -u)\n");
+            return 1;
+        }
+        if (jobs == 0) jobs = default_jobs();
+        if (jobs > 1 && !aio_set) aio_depth = 0;
+        if (cache_path && cache_open(cache_path, (unsigned int) verify_rate) != 0)
+            return 1;
+        int rc = check_manifest(check_str, jobs);
+        return rc | cache_close();
+    }
+
+    if (file_count > 0 && string_input) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (file_count > 1 && (check_str || check_salt)) {
+        fprintf(stderr, "Error: -c checks a single input\n");
+        return 1;
+    }
+
+    /* Hash FILE operands on the worker pool, printing in command-line order */
+    if (file_count > 0 && !check_str && !check_salt) {
+        if (jobs == 0) jobs = default_jobs();
+        /* Workers already overlap one file's reads with another's hashing */
+        if (jobs > 1 && file_count > 1 && !aio_set) aio_depth = 0;
+        if (cache_path && cache_open(cache_path, (unsigned int) verify_rate) != 0)
+            return 1;
+        int rc = hash_files(argv + optind, file_count, jobs);
+        return rc | cache_close() | manifest_finish();
+    }
+
     /* Get filename from remaining arguments */
     if (optind < argc)
         filename = argv[optind];
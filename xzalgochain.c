@@ -18,6 +18,12 @@
  * limitations under the License.
  */
 
+/* Linux: expose MAP_POPULATE, O_DIRECT and syscall() (io_uring) to the
+ * file hashing code alongside -D_XOPEN_SOURCE=700 */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE
+#endif
+
 #include "XzalgoChain/XzalgoChain.h"
 
 #ifdef __cplusplus
@@ -33,15 +39,85 @@ void xzalgochain_lib(const uint8_t* data, size_t len, uint8_t output[XZALGOCHAIN
     xzalgochain_ctx_wipe(&ctx);
 }
 
+int xzalgochain_many_lib(const uint8_t* const* data, const size_t* lens, size_t count,
+                         uint8_t (*outputs)[XZALGOCHAIN_HASH_SIZE]) {
+    return xzalgochain_many(data, lens, count, outputs);
+}
+
+/* ==================== FILE HASHING ==================== */
+int xzalgochain_file_lib(const char* path, uint8_t output[XZALGOCHAIN_HASH_SIZE], int flags) {
+    return xzalgochain_file(path, output, flags);
+}
+
+int xzalgochain_fd_lib(int fd, uint8_t output[XZALGOCHAIN_HASH_SIZE], int flags) {
+    return xzalgochain_fd(fd, output, flags);
+}
+
+int xzalgochain_update_fd_lib(XzalgoChain_CTX* ctx, int fd, int flags, uint64_t* total) {
+    return xzalgochain_update_fd(ctx, fd, flags, total);
+}
+
+int xzalgochain_file_aio_lib(const char* path, uint8_t output[XZALGOCHAIN_HASH_SIZE], unsigned int depth, size_t buffer_size, int flags) {
+    return xzalgochain_file_aio(path, output, depth, buffer_size, flags);
+}
+
+int xzalgochain_update_fd_aio_lib(XzalgoChain_CTX* ctx, int fd, unsigned int depth, size_t buffer_size, int flags, uint64_t* total) {
+    return xzalgochain_update_fd_aio(ctx, fd, depth, buffer_size, flags, total);
+}
+
+int xzalgochain_file_ranges_lib(int fd, const XzalgoChain_Range* ranges, size_t count,
+                                uint8_t (*outputs)[XZALGOCHAIN_HASH_SIZE]) {
+    return xzalgochain_file_ranges(fd, ranges, count, outputs);
+}
+
+/* ==================== BINARY MANIFESTS ==================== */
+int xzalgochain_manifest_write_lib(const char* path, const uint8_t (*digests)[XZALGOCHAIN_HASH_SIZE],
+                                   const char* const* paths, size_t count) {
+    return xzalgochain_manifest_write(path, digests, paths, count);
+}
+
+int xzalgochain_manifest_open_lib(const char* path, XzalgoChain_Manifest* m) {
+    return xzalgochain_manifest_open(path, m);
+}
+
+void xzalgochain_manifest_close_lib(XzalgoChain_Manifest* m) {
+    xzalgochain_manifest_close(m);
+}
+
+const char* xzalgochain_manifest_path_lib(const XzalgoChain_Manifest* m, const XzalgoChain_ManifestRecord* record) {
+    return xzalgochain_manifest_path(m, record);
+}
+
+const XzalgoChain_ManifestRecord* xzalgochain_manifest_find_digest_lib(const XzalgoChain_Manifest* m,
+                                                                       const uint8_t digest[XZALGOCHAIN_HASH_SIZE]) {
+    return xzalgochain_manifest_find_digest(m, digest);
+}
+
+const XzalgoChain_ManifestRecord* xzalgochain_manifest_find_path_lib(const XzalgoChain_Manifest* m, const char* path) {
+    return xzalgochain_manifest_find_path(m, path);
+}
+
+uint64_t xzalgochain_manifest_path_hash_lib(const char* path) {
+    return xzalgochain_manifest_path_hash(path);
+}
+
 /* ==================== CONTEXT MANAGEMENT ==================== */
 void xzalgochain_init_lib(XzalgoChain_CTX* ctx) {
     xzalgochain_init(ctx);
 }
 
+int xzalgochain_init_ex_lib(XzalgoChain_CTX* ctx, int backend) {
+    return xzalgochain_init_ex(ctx, backend);
+}
+
 void xzalgochain_update_lib(XzalgoChain_CTX* ctx, const uint8_t* data, size_t len) {
     xzalgochain_update(ctx, data, len);
 }
 
+void xzalgochain_update_zeros_lib(XzalgoChain_CTX* ctx, uint64_t len) {
+    xzalgochain_update_zeros(ctx, len);
+}
+
 void xzalgochain_final_lib(XzalgoChain_CTX* ctx, uint8_t output[XZALGOCHAIN_HASH_SIZE]) {
     xzalgochain_final(ctx, output);
 }
@@ -63,6 +139,14 @@ int xzalgochain_equals_lib(const uint8_t* h1, const uint8_t* h2) {
     return xzalgochain_equals(h1, h2);
 }
 
+void xzalgochain_to_hex_lib(const uint8_t* in, size_t len, char* out) {
+    xzalgochain_to_hex(in, len, out);
+}
+
+int xzalgochain_from_hex_lib(const char* in, size_t len, uint8_t* out) {
+    return xzalgochain_from_hex(in, len, out);
+}
+
 /* ==================== INFO FUNCTIONS ==================== */
 const char* xzalgochain_version_lib(void) {
     return xzalgochain_version();
@@ -89,6 +173,14 @@ int xzalgochain_avx2_supported_lib(void) {
 #endif
 }
 
+int xzalgochain_sse2_supported_lib(void) {
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+    return 1;
+#else
+    return 0;
+#endif
+}
+
 int xzalgochain_neon_supported_lib(void) {
 #if defined(__ARM_NEON) && (defined(__arm__) || defined(__aarch64__))
     return 1;
@@ -97,6 +189,36 @@ int xzalgochain_neon_supported_lib(void) {
 #endif
 }
 
+/* ==================== BACKEND POLICY ==================== */
+int xzalgochain_backend_available_lib(int backend) {
+    return xzalgochain_backend_available(backend);
+}
+
+const char* xzalgochain_backend_name_lib(int backend) {
+    return xzalgochain_backend_name(backend);
+}
+
+/* ==================== AUTOTUNE ==================== */
+int xzalgochain_autotune_lib(void) {
+    return xzalgochain_autotune();
+}
+
+int xzalgochain_autotune_save_lib(const char* path) {
+    return xzalgochain_autotune_save(path);
+}
+
+int xzalgochain_autotune_load_lib(const char* path) {
+    return xzalgochain_autotune_load(path);
+}
+
+int xzalgochain_autotune_backend_lib(void) {
+    return xzalgochain_autotune_backend();
+}
+
+void xzalgochain_autotune_reset_lib(void) {
+    xzalgochain_autotune_reset();
+}
+
 /* ==================== FORCE SCALAR ==================== */
 void xzalgochain_force_scalar_lib(int force) {
     xzalgochain_force_scalar(force);
@@ -19,6 +19,13 @@
  */
 
 #include "XzalgoChain/XzalgoChain.h"
+#include <stdlib.h>
+
+/* Threaded builds (-pthread) spread batches across the Emscripten worker pool */
+#ifdef __EMSCRIPTEN_PTHREADS__
+    #include <pthread.h>
+    #include <emscripten/threading.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,7 +40,125 @@ void xzalgochain_wasm(const uint8_t* data, size_t len, uint8_t output[XZALGOCHAI
     xzalgochain_ctx_wipe(&ctx);
 }
 
+/* ==================== BATCH HASHING ==================== */
+#define XZ_BATCH_MAX_THREADS 64 /* Upper bound on threads used by one batch call */
+
+typedef struct {
+    const uint8_t* data;     /* Concatenated messages */
+    const uint32_t* offsets; /* count + 1 message boundaries into data */
+    uint32_t count;          /* Number of messages */
+    uint8_t* outputs;        /* count * XZALGOCHAIN_HASH_SIZE bytes */
+#ifdef __EMSCRIPTEN_PTHREADS__
+    atomic_uint next; /* Next message index to claim */
+#endif
+} xz_batch_job;
+
+static void xz_batch_hash_one(const xz_batch_job* job, uint32_t i) {
+    xzalgochain_wasm(job->data + job->offsets[i],
+                     job->offsets[i + 1] - job->offsets[i],
+                     job->outputs + (size_t) i * XZALGOCHAIN_HASH_SIZE);
+}
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+static void* xz_batch_worker(void* arg) {
+    xz_batch_job* job = (xz_batch_job*) arg;
+
+    /* Claim one message at a time so uneven message sizes balance out */
+    for (;;) {
+        uint32_t i = atomic_fetch_add(&job->next, 1);
+        if (i >= job->count) break;
+        xz_batch_hash_one(job, i);
+    }
+    return NULL;
+}
+#endif
+
+/**
+ * Hash many independent messages in one call
+ * Message i is data[offsets[i] .. offsets[i + 1]); its digest is written to
+ * outputs + i * XZALGOCHAIN_HASH_SIZE. Threaded builds hash messages in
+ * parallel on the calling thread plus up to num_threads - 1 pool workers;
+ * other builds hash them in order on the calling thread.
+ *
+ * In threaded builds the calling thread joins the workers, i.e. blocks until
+ * the batch is done. In browsers, call it from a Web Worker, or with
+ * num_threads = 1 on the main thread (no worker is started). Node.js may
+ * call it from the main thread.
+ *
+ * @param data Concatenated message bytes
+ * @param offsets count + 1 non-decreasing offsets into data
+ * @param count Number of messages
+ * @param outputs Output buffer of count * XZALGOCHAIN_HASH_SIZE bytes
+ * @param num_threads Threads to use, 0 for one per logical core
+ * @return 0 on success, -1 on invalid arguments
+ */
+int xzalgochain_batch_wasm(const uint8_t* data,
+                           const uint32_t* offsets,
+                           uint32_t count,
+                           uint8_t* outputs,
+                           int num_threads) {
+    if (count == 0) return 0;
+    if (!offsets || !outputs || (!data && offsets[count] != offsets[0])) return -1;
+    for (uint32_t i = 0; i < count; i++)
+        if (offsets[i + 1] < offsets[i]) return -1;
+
+    xz_batch_job job;
+    job.data = data;
+    job.offsets = offsets;
+    job.count = count;
+    job.outputs = outputs;
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+    /* The worker pool is sized to the core count (PTHREAD_POOL_SIZE, 4
+     * without navigator). Spawns beyond it fail (PTHREAD_POOL_SIZE_STRICT=2)
+     * and are absorbed below */
+    int cores = emscripten_num_logical_cores();
+    if (num_threads <= 0 || num_threads > cores) num_threads = cores;
+    if (num_threads > XZ_BATCH_MAX_THREADS) num_threads = XZ_BATCH_MAX_THREADS;
+    if ((uint32_t) num_threads > count) num_threads = (int) count;
+
+    atomic_init(&job.next, 0);
+
+    pthread_t workers[XZ_BATCH_MAX_THREADS];
+    int started = 0;
+    for (int t = 1; t < num_threads; t++) {
+        if (pthread_create(&workers[started], NULL, xz_batch_worker, &job) != 0) break;
+        started++;
+    }
+
+    /* The calling thread works too, so a failed spawn only costs speed */
+    xz_batch_worker(&job);
+
+    for (int t = 0; t < started; t++) pthread_join(workers[t], NULL);
+#else
+    (void) num_threads;
+    for (uint32_t i = 0; i < count; i++) xz_batch_hash_one(&job, i);
+#endif
+
+    return 0;
+}
+
 /* ==================== CONTEXT MANAGEMENT ==================== */
+size_t xzalgochain_ctx_size_wasm(void) {
+    return sizeof(XzalgoChain_CTX);
+}
+
+XzalgoChain_CTX* xzalgochain_ctx_new_wasm(void) {
+    /* JS cannot see the context layout, so allocate it here with its real
+     * size and alignment instead of a guessed _malloc() size */
+    size_t align = _Alignof(XzalgoChain_CTX);
+    size_t size = (sizeof(XzalgoChain_CTX) + align - 1) / align * align;
+    XzalgoChain_CTX* ctx = (XzalgoChain_CTX*) aligned_alloc(align, size);
+    if (ctx) xzalgochain_init(ctx);
+    return ctx;
+}
+
+void xzalgochain_ctx_free_wasm(XzalgoChain_CTX* ctx) {
+    if (!ctx) return;
+    xzalgochain_ctx_wipe(ctx);
+    free(ctx);
+}
+
 void xzalgochain_init_wasm(XzalgoChain_CTX* ctx) {
     xzalgochain_init(ctx);
 }
@@ -68,6 +193,11 @@ const char* xzalgochain_version_wasm(void) {
     return xzalgochain_version();
 }
 
+const char* xzalgochain_backend_name_wasm(void) {
+    /* Backend AUTO contexts run in this module ("WASM" in the SIMD128 flavor) */
+    return xzalgochain_backend_name(_xz_simd_to_backend(_xz_resolve_backend(XZ_BACKEND_AUTO)));
+}
+
 #ifdef __cplusplus
 }
 #endif